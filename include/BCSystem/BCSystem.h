@@ -59,6 +59,9 @@ public:
     //*** add basic settings
     //**************************************************************
     void SetBCPenaltyFactor(const double &factor){_PenaltyFactor=factor;}
+    // the static load stepping scales the dirichlet values and the loads by the load factor
+    void SetLoadFactor(const double &factor){_LoadFactor=factor;}
+    inline double GetLoadFactor()const{return _LoadFactor;}
 
 
     //**************************************************************
@@ -66,6 +69,9 @@ public:
     //**************************************************************
     void ApplyBC(const Mesh &mesh,const DofHandler &dofHandler,FE &fe,const FECalcType &calctype,const double &t,const double (&ctan)[2],Vec &U,Mat &AMATRIX,Vec &RHS);
     void ApplyInitialBC(const Mesh &mesh,const DofHandler &dofHandler,const double &t,Vec &U);
+    // only the dirichlet rows of RHS are set to zero, i.e. the explicit part of the IMEX time stepping,
+    // whose dirichlet dofs are given by the implicit part
+    void ApplyDirichletBCToRHS(const Mesh &mesh,const DofHandler &dofHandler,const double &t,Vec &U,Vec &RHS);
 
     void PrintBCSystemInfo()const;
 
@@ -76,6 +82,12 @@ private:
     inline BCType GetIthBCBlockBCType(const int &i)const{return _BCBlockList[i-1]._BCType;}
     inline vector<string> GetIthBCBlockNameVec(const int &i)const{return _BCBlockList[i-1]._BoundaryNameList;}
     inline double GetIthBCBlockBCValue(const int &i)const{return _BCBlockList[i-1]._BCValue;}
+    // the user bcs may use the value as a coefficient, so they are not scaled by the load factor
+    inline bool IsLoadBC(const BCType &bctype)const{
+        return bctype==BCType::DIRICHLETBC||bctype==BCType::NEUMANNBC||bctype==BCType::PRESSUREBC||
+               bctype==BCType::NODALDIRICHLETBC||bctype==BCType::NODALNEUMANNBC||
+               bctype==BCType::NODALFORCEBC||bctype==BCType::NODALFLUXBC;
+    }
 
     //**************************************************************
     //*** for different boundary conditions
@@ -113,6 +125,7 @@ private:
 
 private:
     double _PenaltyFactor;
+    double _LoadFactor;
     int _nBCDim,_nDim,_nBulkDim,_nNodesPerBCElmt;
     PetscMPIInt _rank,_size;
 
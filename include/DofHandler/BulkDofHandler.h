@@ -86,6 +86,20 @@ public:
     inline int GetIthBulkElmtJthKernelMateIndex(const int &i,const int &j)const{
         return _ElmtElmtMateIndexList[i-1][j-1];
     }
+    // the index of the qpoint rule in FE, see FE::GetIthBulkQPoint
+    inline int GetIthBulkElmtJthKernelQPointIndex(const int &i,const int &j)const{
+        return _ElmtElmtQPointIndexList[i-1][j-1];
+    }
+    // the index of the [elmts] sub block, see BulkElmtSystem::GetIthBulkElmtBlock
+    inline int GetIthBulkElmtJthKernelBlockIndex(const int &i,const int &j)const{
+        return _ElmtElmtBlockIndexList[i-1][j-1];
+    }
+
+    // the dofs coupling of the element(see BulkElmtSystem::GetBulkElmtDofCouplingMask), the index
+    // is mask[(i-1)*nDofsPerNode+j-1], it is empty if all the dofs of the element are coupled
+    inline const vector<int>& GetIthBulkElmtDofCouplingMask(const int &e)const{
+        return _DofCouplingMaskList[_ElmtDofCouplingMaskIndex[e-1]];
+    }
 
     inline int GetIthNodeJthDofIndex(const int &i,const int &j)const{
         return _NodeDofsMap[i-1][j-1];
@@ -149,8 +163,14 @@ protected:
 
     vector<vector<pair<ElmtType,MateType>>> _ElmtElmtMateTypePairList;
     vector<vector<int>> _ElmtElmtMateIndexList; 
+    vector<vector<int>> _ElmtElmtQPointIndexList;
+    vector<vector<int>> _ElmtElmtBlockIndexList;
     vector<vector<vector<int>>> _ElmtLocalDofIndex;
 
+    // the different dofs coupling masks, the first one is the empty(fully coupled) one
+    vector<vector<int>> _DofCouplingMaskList;
+    vector<int> _ElmtDofCouplingMaskIndex;
+
     // for the length of non-zero element per row
     vector<int> _RowNNZ;
     int _RowMaxNNZ; // the max non-zero elements of all the rows
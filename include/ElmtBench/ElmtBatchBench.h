@@ -0,0 +1,71 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the benchmark of the element kernels(asfem-elmtbench),
+//+++          it compares the throughput of the scalar qpoint kernel
+//+++          (one element at a time) and the cross-element batch
+//+++          kernel(W elements at a time) for the linear elastic
+//+++          HEX8 element, the geometry and the materials are
+//+++          computed once, so only the kernel, the gather and the
+//+++          scatter are timed
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+#include "Utils/MessagePrinter.h"
+#include "Utils/Vector3d.h"
+#include "Utils/ElmtMatrixXd.h"
+#include "Mesh/Nodes.h"
+#include "FE/ShapeFun.h"
+#include "FE/QPoint.h"
+#include "FESystem/FECalcType.h"
+#include "MateSystem/MateTypeDefine.h"
+#include "ElmtSystem/BulkElmtKernelT.h"
+#include "ElmtSystem/BulkElmtBatch.h"
+
+using namespace std;
+
+class ElmtBatchBench{
+public:
+    ElmtBatchBench();
+    void Run(const int &nElmts,const int &nRepeats);
+
+private:
+    // the distorted HEX8 elements, their JxW and shape gradients on each qpoint
+    void CreateElmts(const int &nElmts);
+    // the local jacobian(residual) of all the elements, stored in _ScalarK(_ScalarR) or _BatchK(_BatchR)
+    void RunScalar(const FECalcType &calctype);
+    void RunBatch(const FECalcType &calctype);
+    double GetMaxRelativeError(const vector<double> &a,const vector<double> &b)const;
+
+private:
+    const int _nDim=3,_nNodes=8,_nDofsPerNode=3,_nDofs=24;
+    int _nElmts,_nQp;
+    vector<double> _gpJxW;     // index=e*_nQp+qp
+    vector<Vector3d> _gpShpGrad;// index=(e*_nQp+qp)*_nNodes+a
+    vector<double> _gpShpVal;  // the same index as _gpShpGrad
+    vector<Materials> _gpMates;// index=e*_nQp+qp
+    vector<int> _localDofIndex,_elDofs;
+    vector<double> _elDofsActiveFlag;
+    vector<double> _gpU;
+    vector<Vector3d> _gpGradU;
+
+    ElmtMatrixXd _localK;
+    ElmtVectorXd _localR;
+    BulkElmtBatch _batch;
+    vector<double> _ScalarK,_BatchK;// index=(e*_nDofs+i)*_nDofs+j
+    vector<double> _ScalarR,_BatchR;// index=e*_nDofs+i
+};
@@ -0,0 +1,209 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Define the element batch used by the cross-element
+//+++          batched assembly, it holds W(=AsFemElmtBatchWidth)
+//+++          elements of the same mesh type in the AoSoA layout:
+//+++            val[(...)*W+lane]
+//+++          i.e. the lane(element) index is the fastest one, so
+//+++          the batch kernels(see BulkElmtKernelT.h) evaluate the
+//+++          W elements with the unit-stride(simd) loops
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "Utils/MessagePrinter.h"
+#include "Utils/Vector3d.h"
+#include "Utils/ElmtMatrixXd.h"
+#include "FESystem/FECalcType.h"
+#include "MateSystem/MateTypeDefine.h"
+
+using namespace std;
+
+//*** the lanes number of one batch, 4 doubles fill one AVX2 register
+const int AsFemElmtBatchWidth=4;
+
+class BulkElmtBatch{
+public:
+    BulkElmtBatch(){
+        _nDim=0;_nNodes=0;_nMaxQp=0;_nQp=0;_nLanes=0;
+        _UseSymTangent=false;
+    }
+    void Init(const int &ndim,const int &nnodes,const int &maxqp){
+        const int W=AsFemElmtBatchWidth;
+        const int nd=nnodes*ndim;
+        _nDim=ndim;_nNodes=nnodes;_nMaxQp=maxqp;_nQp=0;_nLanes=0;
+        _Grad.assign(maxqp*nd*W,0.0);
+        _Stress.assign(maxqp*ndim*ndim*W,0.0);
+        _Tangent.assign(maxqp*ndim*ndim*ndim*ndim*W,0.0);
+        _SymTangent.assign(maxqp*GetMandelNum(ndim)*GetMandelNum(ndim)*W,0.0);
+        _K.assign(nd*nd*W,0.0);
+        _R.assign(nd*W,0.0);
+        _LaneDofs.assign(W,vector<int>(0));
+        _LaneDofsActiveFlag.assign(W,vector<double>(0));
+        _LaneLocalDofIndex.assign(W,vector<int>(0));
+        _LaneDofsPerNode.assign(W,0);
+        _LaneDofCouplingMask.assign(W,vector<int>(0));
+    }
+    inline void Reset(){_nLanes=0;}
+    inline bool IsEmpty()const{return _nLanes==0;}
+    inline bool IsFull()const{return _nLanes==AsFemElmtBatchWidth;}
+    inline int GetLanesNum()const{return _nLanes;}
+    inline int GetQpPointsNum()const{return _nQp;}
+    // all the lanes must share the same qpoints number and tangent storage, otherwise the batch should be flushed first
+    inline bool CanAppend(const int &nqp,const bool &issym)const{
+        return _nLanes<AsFemElmtBatchWidth&&(_nLanes==0||(nqp==_nQp&&issym==_UseSymTangent));
+    }
+    // the Mandel components of the small strain in ndim, 2D only has the in-plane ones(11,22,12)
+    inline static int GetMandelNum(const int &ndim){return (ndim==2)?3:6;}
+    inline const vector<int>& GetIthLaneDofs(const int &lane)const{return _LaneDofs[lane];}
+    inline const vector<double>& GetIthLaneDofsActiveFlag(const int &lane)const{return _LaneDofsActiveFlag[lane];}
+    inline int GetIthLaneDofsPerNode(const int &lane)const{return _LaneDofsPerNode[lane];}
+    // the dofs coupling of the element(see DofHandler::GetIthBulkElmtDofCouplingMask), empty if fully coupled
+    inline const vector<int>& GetIthLaneDofCouplingMask(const int &lane)const{return _LaneDofCouplingMask[lane];}
+
+    //*****************************************************************************
+    //*** gather one element into the next lane, JxW(and ctan[0] for the jacobian)
+    //*** is multiplied into the material quantities of each qpoint
+    //*****************************************************************************
+    void AppendLane(const FECalcType &calctype,const double &ctan0,const int &nqp,const int &nMaxNodes,
+                    const double *gpJxW,const Vector3d *gpShpGrad,const Materials *gpMates,
+                    const int &nDofs,const int &nDofsPerNode,const vector<int> &localDofIndex,
+                    const vector<int> &elDofs,const vector<double> &elDofsActiveFlag,
+                    const vector<int> *dofCouplingMask=nullptr){
+        const int W=AsFemElmtBatchWidth;
+        const int d2=_nDim*_nDim,d4=d2*d2;
+        const int lane=_nLanes;
+        const int nm=GetMandelNum(_nDim);
+        const int mandel[6]={1,2,(_nDim==2)?6:3,4,5,6};
+        int qp,a,i,j,k,l;
+        double JxW;
+        // the Mandel tangent is used if all the qpoints give it, see Materials::SymTangent
+        bool IsSym=calctype==FECalcType::ComputeJacobian;
+        for(qp=0;qp<nqp&&IsSym;qp++) IsSym=gpMates[qp].HasSymTangent;
+        if(!CanAppend(nqp,IsSym)||nqp>_nMaxQp){
+            MessagePrinter::PrintErrorTxt("can\'t append the element to the element batch, the batch is full or the qpoints number(tangent storage) is different");
+            MessagePrinter::AsFem_Exit();
+        }
+        _nQp=nqp;
+        _UseSymTangent=IsSym;
+        for(qp=0;qp<nqp;qp++){
+            for(a=0;a<_nNodes;a++){
+                const Vector3d &grad=gpShpGrad[qp*nMaxNodes+a];
+                for(j=0;j<_nDim;j++) _Grad[((qp*_nNodes+a)*_nDim+j)*W+lane]=grad(j+1);
+            }
+            if(calctype==FECalcType::ComputeResidual){
+                const RankTwoTensor &stress=gpMates[qp].Rank2Materials.at("stress");
+                JxW=gpJxW[qp];
+                if(_nDim==3){
+                    // the same(row major) layout as the tensor itself
+                    for(i=0;i<d2;i++) _Stress[(qp*d2+i)*W+lane]=stress[i+1]*JxW;
+                }
+                else{
+                    for(i=0;i<_nDim;i++){
+                        for(j=0;j<_nDim;j++) _Stress[(qp*d2+i*_nDim+j)*W+lane]=stress(i+1,j+1)*JxW;
+                    }
+                }
+            }
+            else if(calctype==FECalcType::ComputeJacobian&&IsSym){
+                const SymRankFourTensor &tangent=gpMates[qp].SymTangent;
+                JxW=gpJxW[qp]*ctan0;
+                for(i=0;i<nm;i++){
+                    for(j=0;j<nm;j++) _SymTangent[(qp*nm*nm+i*nm+j)*W+lane]=tangent(mandel[i],mandel[j])*JxW;
+                }
+            }
+            else if(calctype==FECalcType::ComputeJacobian){
+                const RankFourTensor &jacobian=gpMates[qp].Rank4Materials.at("jacobian");
+                JxW=gpJxW[qp]*ctan0;
+                if(_nDim==3){
+                    for(i=0;i<d4;i++) _Tangent[(qp*d4+i)*W+lane]=jacobian[i+1]*JxW;
+                }
+                else{
+                    for(i=0;i<_nDim;i++){
+                        for(j=0;j<_nDim;j++){
+                            for(k=0;k<_nDim;k++){
+                                for(l=0;l<_nDim;l++){
+                                    _Tangent[(qp*d4+((i*_nDim+j)*_nDim+k)*_nDim+l)*W+lane]=jacobian(i+1,j+1,k+1,l+1)*JxW;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        _LaneDofs[lane].assign(elDofs.begin(),elDofs.begin()+nDofs);
+        _LaneDofsActiveFlag[lane].assign(elDofsActiveFlag.begin(),elDofsActiveFlag.begin()+nDofs);
+        _LaneLocalDofIndex[lane]=localDofIndex;
+        _LaneDofsPerNode[lane]=nDofsPerNode;
+        _LaneDofCouplingMask[lane]=(dofCouplingMask!=nullptr)?*dofCouplingMask:vector<int>(0);
+        _nLanes+=1;
+    }
+    //*****************************************************************************
+    //*** scatter the result of one lane to the element dofs layout:
+    //*** (i-1)*nDofsPerNode+localDofIndex[j-1], the JxW is already included
+    //*****************************************************************************
+    void GetIthLaneResidual(const int &lane,ElmtVectorXd &localR)const{
+        const int W=AsFemElmtBatchWidth;
+        const int nDofs=static_cast<int>(_LaneDofs[lane].size());
+        const int nDofsPerNode=_LaneDofsPerNode[lane];
+        const vector<int> &dofindex=_LaneLocalDofIndex[lane];
+        localR.Resize(nDofs);
+        if(nDofs!=_nNodes*_nDim) localR.setZero();// the other dofs of the element are not touched by the batch
+        for(int a=0;a<_nNodes;a++){
+            for(int i=0;i<_nDim;i++){
+                localR.Coeff(a*nDofsPerNode+dofindex[i]-1)=_R[(a*_nDim+i)*W+lane];
+            }
+        }
+    }
+    void GetIthLaneJacobian(const int &lane,ElmtMatrixXd &localK)const{
+        const int W=AsFemElmtBatchWidth;
+        const int nd=_nNodes*_nDim;
+        const int nDofs=static_cast<int>(_LaneDofs[lane].size());
+        const int nDofsPerNode=_LaneDofsPerNode[lane];
+        const vector<int> &dofindex=_LaneLocalDofIndex[lane];
+        localK.Resize(nDofs,nDofs);
+        if(nDofs!=_nNodes*_nDim) localK.setZero();// the other dofs of the element are not touched by the batch
+        for(int a=0;a<_nNodes;a++){
+            for(int i=0;i<_nDim;i++){
+                for(int b=0;b<_nNodes;b++){
+                    for(int k=0;k<_nDim;k++){
+                        localK.Coeff(a*nDofsPerNode+dofindex[i]-1,b*nDofsPerNode+dofindex[k]-1)=_K[((a*_nDim+i)*nd+b*_nDim+k)*W+lane];
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    int _nDim,_nNodes;// all the lanes share the same dim and mesh type
+    int _nMaxQp,_nQp; // the capacity and the current qpoints number
+    int _nLanes;      // the number of the filled lanes
+    bool _UseSymTangent;// true if the lanes give the Mandel tangent(_SymTangent) instead of _Tangent
+    //*** AoSoA inputs, the index is:
+    //***   _Grad   : ((qp*nNodes+a)*nDim+j)*W+lane
+    //***   _Stress : (qp*nDim^2+i*nDim+j)*W+lane, JxW is included
+    //***   _Tangent: (qp*nDim^4+((i*nDim+j)*nDim+k)*nDim+l)*W+lane, JxW*ctan[0] is included
+    //***   _SymTangent: (qp*nm^2+m*nm+n)*W+lane, nm=GetMandelNum(nDim), JxW*ctan[0] is included
+    vector<double> _Grad,_Stress,_Tangent,_SymTangent;
+    //*** AoSoA outputs, the index is:
+    //***   _K: ((a*nDim+i)*nNodes*nDim+b*nDim+k)*W+lane
+    //***   _R: (a*nDim+i)*W+lane
+    vector<double> _K,_R;
+    //*** the bookkeeping of each lane for the scatter
+    vector<vector<int>> _LaneDofs;
+    vector<vector<double>> _LaneDofsActiveFlag;
+    vector<vector<int>> _LaneLocalDofIndex;
+    vector<int> _LaneDofsPerNode;
+    vector<vector<int>> _LaneDofCouplingMask;
+};
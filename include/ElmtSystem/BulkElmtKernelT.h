@@ -0,0 +1,153 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the compile-time specialized qpoint kernels of the
+//+++          built-in elements, the dim and the nodes number are
+//+++          template parameters, so the loops over the nodes and
+//+++          the components can be fully unrolled by the compiler.
+//+++          one call gives the contribution of all the nodes on
+//+++          one qpoint, instead of one call for each (i,j) pair
+//+++          the kernels are instantiated for:
+//+++            QUAD4, QUAD9, TRI3, HEX8, HEX27, TET4, TET10
+//+++          the other meshes use the general ComputeAll
+//+++          the batch kernels evaluate W elements of the same mesh
+//+++          type at once, the elements are kept in BulkElmtBatch,
+//+++          see BulkElmtBatch.h for the AoSoA layout
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "Utils/Vector3d.h"
+#include "Utils/ElmtMatrixXd.h"
+#include "FESystem/FECalcType.h"
+#include "MateSystem/MateTypeDefine.h"
+#include "ElmtSystem/BulkElmtBatch.h"
+
+using namespace std;
+
+// the contribution of all the nodes on one qpoint, the result is added to localK or localR(without JxW)
+// in the element dofs layout: (i-1)*nDofsPerNode+localDofIndex[j-1]
+typedef void (*BulkElmtQpKernel)(const FECalcType &calctype,const int &nDofsPerNode,
+                                 const vector<int> &localDofIndex,const double (&ctan)[2],
+                                 const double *shpval,const Vector3d *shpgrad,
+                                 const vector<double> &gpU,const vector<Vector3d> &gpGradU,
+                                 const Materials &Mate,ElmtMatrixXd &localK,ElmtVectorXd &localR);
+
+//*******************************************************
+//*** for the poisson element
+//*******************************************************
+template<int Dim,int NNodes>
+class PoissonElmtKernelT{
+public:
+    static void Compute(const FECalcType &calctype,const int &nDofsPerNode,
+                        const vector<int> &localDofIndex,const double (&ctan)[2],
+                        const double *shpval,const Vector3d *shpgrad,
+                        const vector<double> &gpU,const vector<Vector3d> &gpGradU,
+                        const Materials &Mate,ElmtMatrixXd &localK,ElmtVectorXd &localR);
+};
+
+//*******************************************************
+//*** for the mechanics element
+//*******************************************************
+template<int Dim,int NNodes>
+class MechanicsElmtKernelT{
+public:
+    static void Compute(const FECalcType &calctype,const int &nDofsPerNode,
+                        const vector<int> &localDofIndex,const double (&ctan)[2],
+                        const double *shpval,const Vector3d *shpgrad,
+                        const vector<double> &gpU,const vector<Vector3d> &gpGradU,
+                        const Materials &Mate,ElmtMatrixXd &localK,ElmtVectorXd &localR);
+};
+
+// the contribution of all the qpoints of the W elements in the batch, the result is
+// stored in batch._K or batch._R(JxW is included)
+typedef void (*BulkElmtBatchKernel)(const FECalcType &calctype,BulkElmtBatch &batch);
+
+//*******************************************************
+//*** the batch kernel of the mechanics element, the
+//*** innermost loop is always over the lanes
+//*******************************************************
+template<int Dim,int NNodes>
+class MechanicsElmtBatchKernelT{
+public:
+    static void Compute(const FECalcType &calctype,BulkElmtBatch &batch);
+};
+
+//*******************************************************
+//*** select the instantiated kernel, nullptr is returned
+//*** if the (dim,nodes) is not instantiated
+//*******************************************************
+template<template<int,int> class KernelT>
+inline BulkElmtQpKernel SelectBulkElmtQpKernel(const int &nDim,const int &nNodes){
+    if(nDim==2){
+        switch(nNodes){
+        case 3:
+            return &KernelT<2,3>::Compute;
+        case 4:
+            return &KernelT<2,4>::Compute;
+        case 9:
+            return &KernelT<2,9>::Compute;
+        default:
+            return nullptr;
+        }
+    }
+    else if(nDim==3){
+        switch(nNodes){
+        case 4:
+            return &KernelT<3,4>::Compute;
+        case 8:
+            return &KernelT<3,8>::Compute;
+        case 10:
+            return &KernelT<3,10>::Compute;
+        case 27:
+            return &KernelT<3,27>::Compute;
+        default:
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+//*******************************************************
+//*** the same as above, but for the batch kernels
+//*******************************************************
+template<template<int,int> class KernelT>
+inline BulkElmtBatchKernel SelectBulkElmtBatchKernel(const int &nDim,const int &nNodes){
+    if(nDim==2){
+        switch(nNodes){
+        case 3:
+            return &KernelT<2,3>::Compute;
+        case 4:
+            return &KernelT<2,4>::Compute;
+        case 9:
+            return &KernelT<2,9>::Compute;
+        default:
+            return nullptr;
+        }
+    }
+    else if(nDim==3){
+        switch(nNodes){
+        case 4:
+            return &KernelT<3,4>::Compute;
+        case 8:
+            return &KernelT<3,8>::Compute;
+        case 10:
+            return &KernelT<3,10>::Compute;
+        case 27:
+            return &KernelT<3,27>::Compute;
+        default:
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
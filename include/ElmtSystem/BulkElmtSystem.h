@@ -35,24 +35,31 @@
 #include "ElmtSystem/MechanicsElmt.h"
 #include "ElmtSystem/CahnHilliardElmt.h"
 #include "ElmtSystem/MieheFractureElmt.h"
+#include "ElmtSystem/User1Elmt.h"
+#include "ElmtSystem/MechanicsReducedElmt.h"
+#include "ElmtSystem/BulkElmtKernelT.h"
 
 using namespace std;
 
 class MateSystem;
+class FE;
 
 class BulkElmtSystem: public PoissonElmt,
         public DiffusionElmt,
         public MechanicsElmt,
         public CahnHilliardElmt,
-        public MieheFractureElmt{
+        public MieheFractureElmt,
+        public User1Elmt,
+        public MechanicsReducedElmt{
 public:
     BulkElmtSystem();
 
     void InitBulkElmtSystem();
     void InitBulkElmtMateInfo(MateSystem &matesystem);
+    void InitBulkElmtQPointInfo(FE &fe);// set the qpoint rule index for each elmt block
 
     void AddBulkElmtBlock2List(ElmtBlock &elmtBlock);
-    ElmtBlock GetIthBulkElmtBlock(const int &i)const{
+    const ElmtBlock& GetIthBulkElmtBlock(const int &i)const{
         return _BulkElmtBlockList[i-1];
     }
     inline int GetBulkElmtBlockNums()const{
@@ -74,6 +81,52 @@ public:
                          map<string,double> &gpProj,
                          MatrixXd &localK,VectorXd &localR);
 
+    // the compile-time specialized qpoint kernel(see BulkElmtKernelT.h) of the element,
+    // nullptr is returned if it is not available, then RunBulkElmtLibs should be used
+    BulkElmtQpKernel GetBulkElmtQpKernel(const ElmtType &elmttype,const int &nDim,const int &nNodes)const;
+    // the cross-element batch kernel(see BulkElmtBatch.h), only for the elements without the
+    // element level part, nullptr is returned if it is not available
+    BulkElmtBatchKernel GetBulkElmtBatchKernel(const ElmtType &elmttype,const int &nDim,const int &nNodes)const;
+
+    //****************************************************************************
+    //*** the field coupling of the element, mask[(i-1)*nDofs+j-1]=1 if the residual of
+    //*** the i-th dof of the kernel depends on its j-th dof, otherwise the (i,j) block
+    //*** of the jacobian is structurally zero, it is neither computed nor assembled
+    //****************************************************************************
+    vector<int> GetBulkElmtCouplingMask(const ElmtType &elmttype,const int &nDofs)const;
+    // the union of the kernels(the [elmts] sub blocks) acting on one element, the index is the
+    // global dof id: mask[(i-1)*nDofsPerNode+j-1], the diagonal is always kept for the bc
+    vector<int> GetBulkElmtDofCouplingMask(const vector<int> &blockIndexList,const int &nDofsPerNode)const;
+
+    //****************************************************************************
+    //*** some elements need the quantities of the whole element, i.e. the hourglass
+    //*** control and the B-bar integration, they are called once per element
+    //****************************************************************************
+    // true if the element has the element level contribution
+    inline bool HasBulkElmtElmtLevelPart(const ElmtType &elmttype)const{
+        return elmttype==ElmtType::MECHANICSRIELMT||elmttype==ElmtType::MECHANICSBBARELMT;
+    }
+    // true if the residual and jacobian are only given by the element level part
+    inline bool IsBulkElmtElmtLevelOnly(const ElmtType &elmttype)const{
+        return elmttype==ElmtType::MECHANICSBBARELMT;
+    }
+    // true if the jacobian(the qpoint and the element level part) only reads the "jacobian" of the materials
+    inline bool IsBulkElmtJacobianTangentOnly(const ElmtType &elmttype)const{
+        return elmttype==ElmtType::MECHANICSELMT||elmttype==ElmtType::MECHANICSRIELMT||elmttype==ElmtType::MECHANICSBBARELMT;
+    }
+    // modify the qpoint quantities of the batch before the material calculation
+    void PrepareBulkElmtBatch(const ElmtType &elmttype,const int &nDim,
+                              const vector<double> &gpJxW,BulkMateBatch &batch);
+    // the element level residual or jacobian, gpMates are the materials of all the qpoints
+    void RunBulkElmtLibsOnElmt(const FECalcType &calctype,const ElmtType &elmttype,
+                               const int &nDim,const int &nNodes,const int &nDofsPerNode,
+                               const vector<int> &localDofIndex,const double (&ctan)[2],
+                               const double &hgcoef,
+                               const Nodes &elNodes,const vector<double> &elU,
+                               const int &nQp,const int &nMaxNodes,
+                               const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad,
+                               const Materials *gpMates,ElmtMatrixXd &localK,ElmtVectorXd &localR);
+
     void PrintBulkElmtInfo()const;
 
 protected:
@@ -133,23 +186,6 @@ protected:
                      vector<double> &gpHist,vector<double> &gpHistOld,map<string,double> &gpProj,
                      MatrixXd &localK,VectorXd &localR);
     //************************************************************************************
-    //*** for User-defined element 1
-    //************************************************************************************
-    void User1Elmt(const FECalcType &calctype,
-                           const int &nDim,const int &nNodes,const int &nDofs,
-                           const double &t,const double &dt,const double (&ctan)[2],
-                           const Vector3d &gpCoords,
-                           const vector<double> &gpU,const vector<double> &gpV,
-                           const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradV,
-                           const double &test,const double &trial,
-                           const Vector3d &grad_test,const Vector3d &grad_trial,
-                           const ScalarMateType &ScalarMaterials,
-                           const VectorMateType &VectorMaterials,
-                           const Rank2MateType &Rank2Materials,
-                           const Rank4MateType &Rank4Materials,
-                           vector<double> &gpHist,vector<double> &gpHistOld,map<string,double> &gpProj,
-                           MatrixXd &localK,VectorXd &localR);
-    //************************************************************************************
     //*** for User-defined element 2
     //************************************************************************************
     void User2Elmt(const FECalcType &calctype,
@@ -19,7 +19,9 @@
 #include <vector>
 
 #include "ElmtSystem/ElmtType.h"
+#include "ElmtSystem/ElmtIMEXType.h"
 #include "MateSystem/MateType.h"
+#include "FE/QPointType.h"
 
 #include "Utils/MessagePrinter.h"
 
@@ -37,6 +39,14 @@ public:
         _ElmtType=ElmtType::NULLELMT;
         _MateType=MateType::NULLMATE;
         _MateIndex=0;
+        _QpOrder=-1;
+        _HasQpType=false;
+        _QpType=QPointType::GAUSSLEGENDRE;
+        _QPointIndex=1;
+        _HourglassCoef=0.05;
+        _UseFDJacobian=false;
+        _Density=0.0;
+        _IMEXType=ElmtIMEXType::IMPLICIT;
     }
 
     vector<int>    _DofsIDList;
@@ -49,6 +59,14 @@ public:
     ElmtType       _ElmtType=ElmtType::NULLELMT;
     MateType       _MateType=MateType::NULLMATE;
     int            _MateIndex=0;
+    int            _QpOrder=-1;         // -1 means the order of the [qpoint] block is used
+    bool           _HasQpType=false;    // false means the type of the [qpoint] block is used
+    QPointType     _QpType=QPointType::GAUSSLEGENDRE;
+    int            _QPointIndex=1;      // the index of the bulk qpoint rule in FE, 1 is the [qpoint] one
+    double         _HourglassCoef=0.05; // the hourglass stiffness coefficient of the mechanicsri element
+    bool           _UseFDJacobian=false;// the jacobian is given by the colored finite difference of the residual
+    double         _Density=0.0;        // the density of the mass matrix(second order time stepping), 0 means no mass
+    ElmtIMEXType   _IMEXType=ElmtIMEXType::IMPLICIT;// the part of the IMEX time stepping
     
     void Init(){
         _DofsIDList.clear();
@@ -61,6 +79,14 @@ public:
         _ElmtType=ElmtType::NULLELMT;
         _MateType=MateType::NULLMATE;
         _MateIndex=0;
+        _QpOrder=-1;
+        _HasQpType=false;
+        _QpType=QPointType::GAUSSLEGENDRE;
+        _QPointIndex=1;
+        _HourglassCoef=0.05;
+        _UseFDJacobian=false;
+        _Density=0.0;
+        _IMEXType=ElmtIMEXType::IMPLICIT;
     }
 
     void PrintInfo()const{
@@ -80,5 +106,37 @@ public:
 
         str="   domain name ="+_DomainName;
         MessagePrinter::PrintNormalTxt(str);
+
+        if(_QpOrder>=0||_HasQpType){
+            str="   qpoint: type=";
+            if(!_HasQpType) str+="(from [qpoint])";
+            else if(_QpType==QPointType::GAUSSLEGENDRE) str+="gauss";
+            else str+="gausslobatto";
+            str+=", order=";
+            if(_QpOrder<0) str+="(from [qpoint])";
+            else str+=to_string(_QpOrder);
+            MessagePrinter::PrintNormalTxt(str);
+        }
+        if(_UseFDJacobian){
+            MessagePrinter::PrintNormalTxt("   jacobian = finite difference(colored)");
+        }
+        if(_IMEXType==ElmtIMEXType::IMPLICITLINEAR){
+            MessagePrinter::PrintNormalTxt("   imex = implicit(linear)");
+        }
+        else if(_IMEXType==ElmtIMEXType::EXPLICIT){
+            MessagePrinter::PrintNormalTxt("   imex = explicit");
+        }
+        if(_Density>0.0){
+            char buff[70];
+            snprintf(buff,70,"   density=%12.5e",_Density);
+            str=buff;
+            MessagePrinter::PrintNormalTxt(str);
+        }
+        if(_ElmtType==ElmtType::MECHANICSRIELMT){
+            char buff[70];
+            snprintf(buff,70,"   hourglass coefficient=%12.5e",_HourglassCoef);
+            str=buff;
+            MessagePrinter::PrintNormalTxt(str);
+        }
     }
 };
\ No newline at end of file
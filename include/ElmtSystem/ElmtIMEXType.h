@@ -0,0 +1,27 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Define how the residual of an [elmts] sub block is
+//+++          integrated by the IMEX(arkimex) time stepping:
+//+++             1. implicit: in the implicit part(newton)
+//+++             2. linear: in the implicit part, but it is linear,
+//+++                so its jacobian is kept for the same dt
+//+++             3. explicit: in the explicit part(rhs function)
+//+++          the other time stepping methods ignore it
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+enum class ElmtIMEXType{
+    IMPLICIT,
+    IMPLICITLINEAR,
+    EXPLICIT
+};
@@ -24,6 +24,8 @@ enum class ElmtType{
     LAPLACEELMT,
     POISSONELMT,
     MECHANICSELMT,
+    MECHANICSRIELMT,
+    MECHANICSBBARELMT,
     CAHNHILLIARDELMT,
     MECHCAHNHILLIARDELMT,
     DIFFUSIONELMT,
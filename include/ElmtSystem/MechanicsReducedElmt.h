@@ -0,0 +1,74 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the element level parts of the reduced integration
+//+++          mechanics elements:
+//+++          1) mechanicsri: one-point QUAD4/HEX8 element with the
+//+++             hourglass control(stiffness form of Flanagan and
+//+++             Belytschko)
+//+++          2) mechanicsbbar: selective-reduced(B-bar) element,
+//+++             the volumetric strain is replaced by its element
+//+++             average, for the nearly incompressible materials
+//+++          both of them need the quantities of the whole element,
+//+++          so they can't be written as the qpoint-wise kernel
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "Utils/MessagePrinter.h"
+#include "Utils/Vector3d.h"
+#include "Utils/VectorXd.h"
+#include "Utils/MatrixXd.h"
+#include "Utils/ElmtMatrixXd.h"
+#include "Utils/RankTwoTensor.h"
+#include "Utils/RankFourTensor.h"
+#include "Mesh/Nodes.h"
+#include "FESystem/FECalcType.h"
+#include "MateSystem/MateTypeDefine.h"
+#include "MateSystem/BulkMateBatch.h"
+
+using namespace std;
+
+class MechanicsReducedElmt{
+protected:
+    // replace the volumetric part of grad(u) and grad(uold) by the element average,
+    // this must be done before the material calculation
+    void ModifyBBarGradU(const int &nDim,const vector<double> &gpJxW,BulkMateBatch &batch);
+
+    // the residual or jacobian of the B-bar element, all the qpoints are included,
+    // the result is given in the element dofs layout: (i-1)*nDofsPerNode+dofid
+    void ComputeBBar(const FECalcType &calctype,const int &nDim,const int &nNodes,const int &nDofsPerNode,
+                     const vector<int> &localDofIndex,const double &ctan0,
+                     const int &nQp,const int &nMaxNodes,
+                     const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad,
+                     const Materials *gpMates,ElmtMatrixXd &localK,ElmtVectorXd &localR);
+
+    // the hourglass force(or stiffness) of the one-point QUAD4/HEX8 element
+    void ComputeHourglass(const FECalcType &calctype,const int &nDim,const int &nNodes,const int &nDofsPerNode,
+                          const vector<int> &localDofIndex,const double &coef,const double &ctan0,
+                          const Nodes &elNodes,const vector<double> &elU,
+                          const int &nQp,const int &nMaxNodes,
+                          const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad,
+                          const Materials *gpMates,ElmtMatrixXd &localK,ElmtVectorXd &localR);
+
+private:
+    // the volume averaged shape gradients(the uniform gradients), index starts from 1
+    void ComputeMeanShapeGrad(const int &nNodes,const int &nQp,const int &nMaxNodes,
+                              const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad);
+
+private:
+    vector<Vector3d> _MeanShpGrad;
+    double _MeanVolume=0.0;
+    vector<double> _HgGamma;
+};
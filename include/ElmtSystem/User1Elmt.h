@@ -0,0 +1,77 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: implement the User-Defined-Element (UEL) 1, only the
+//+++          residual is written(as a template), the jacobian is
+//+++          obtained by the automatic differentiation. The example
+//+++          is the nonlinear diffusion equation:
+//+++          dc/dt=div(D*(1+c^2)*grad(c))
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include "ElmtSystem/BulkElmtBase.h"
+#include "Utils/AutoDiff.h"
+
+class User1Elmt:public BulkElmtBase{
+public:
+    virtual void ComputeAll(const FECalcType &calctype, const int &nDim, const int &nNodes,
+                            const int &nDofs, const double &t, const double &dt, const double (&ctan)[2],
+                            const Vector3d &gpCoords, const vector<double> &gpU,
+                            const vector<double> &gpUold, const vector<double> &gpV,
+                            const vector<double> &gpVold, const vector<Vector3d> &gpGradU,
+                            const vector<Vector3d> &gpGradUold, const vector<Vector3d> &gpGradV,
+                            const vector<Vector3d> &gpGradVold, const double &test, const double &trial,
+                            const Vector3d &grad_test, const Vector3d &grad_trial, const Materials &Mate,
+                            const Materials &MateOld, map<string, double> &gpProj, MatrixXd &localK,
+                            VectorXd &localR) override;
+
+private:
+    virtual void ComputeResidual(const int &nDim, const int &nNodes, const int &nDofs, const double &t,
+                                 const double &dt, const Vector3d &gpCoords, const vector<double> &gpU,
+                                 const vector<double> &gpUold, const vector<double> &gpV,
+                                 const vector<double> &gpVold, const vector<Vector3d> &gpGradU,
+                                 const vector<Vector3d> &gpGradUold, const vector<Vector3d> &gpGradV,
+                                 const vector<Vector3d> &gpGradVold, const double &test,
+                                 const Vector3d &grad_test, const Materials &Mate,
+                                 const Materials &MateOld, VectorXd &localR) override;
+
+    virtual void ComputeJacobian(const int &nDim, const int &nNodes, const int &nDofs, const double &t,
+                                 const double &dt, const double (&ctan)[2], const Vector3d &gpCoords,
+                                 const vector<double> &gpU, const vector<double> &gpUold,
+                                 const vector<double> &gpV, const vector<double> &gpVold,
+                                 const vector<Vector3d> &gpGradU, const vector<Vector3d> &gpGradUold,
+                                 const vector<Vector3d> &gpGradV, const vector<Vector3d> &gpGradVold,
+                                 const double &test, const double &trial, const Vector3d &grad_test,
+                                 const Vector3d &grad_trial, const Materials &Mate,
+                                 const Materials &MateOld, MatrixXd &localK) override;
+
+    virtual void ComputeProjection(const int &nDim, const int &nNodes, const int &nDofs, const double &t,
+                                   const double &dt, const double (&ctan)[2], const Vector3d &gpCoords,
+                                   const vector<double> &gpU, const vector<double> &gpUold,
+                                   const vector<double> &gpV, const vector<double> &gpVold,
+                                   const vector<Vector3d> &gpGradU, const vector<Vector3d> &gpGradUold,
+                                   const vector<Vector3d> &gpGradV, const vector<Vector3d> &gpGradVold,
+                                   const double &test, const Vector3d &grad_test, const Materials &Mate,
+                                   const Materials &MateOld, map<string, double> &gpProj) override;
+
+    //*** the residual is the only thing users need to write, T is double or the dual number,
+    //*** the dofs index starts from 1, R[1~nDofs] is the residual of the current test function
+    template<typename T>
+    void ComputeUserResidual(const double &D,const double &test,const Vector3d &grad_test,
+                             const vector<T> &U,const vector<T> &V,
+                             const vector<Vector3dT<T>> &GradU,const vector<Vector3dT<T>> &GradV,
+                             vector<T> &R) const{
+        if(GradV.size()){}
+        R[1]=V[1]*test+D*(1.0+U[1]*U[1])*(GradU[1]*grad_test);
+    }
+
+};
\ No newline at end of file
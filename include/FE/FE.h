@@ -37,6 +37,10 @@ public:
     void SetBulkQpOrder(int order);
     void SetBCQpOrder(int order);
     void CreateQPoints(Mesh &mesh);
+    // the bulk qpoint rules used by the [elmts] blocks, the 1st one is the rule of [qpoint],
+    // the others are cached by (qpoint type,order), each rule is created only once for
+    // every bulk mesh type. the index of the rule is returned
+    int AddBulkQPoint(const QPointType &qptype,const int &order);
     //***********************************************
     //*** for shape functions
     //***********************************************
@@ -50,16 +54,41 @@ public:
     inline int GetMinDim()const{return _nMinDim;}
 
     QPoint& GetBulkQPointPtr(){return _BulkQPoint;}
+    inline int GetBulkQPointRulesNum()const{return static_cast<int>(_BulkQPointRuleList.size());}
+    // the i-th rule for the first bulk mesh type
+    inline QPoint& GetIthBulkQPoint(const int &i){return GetBulkQPoint(i,1);}
+    inline int GetIthBulkQpPointsNum(const int &i)const{return GetBulkQpPointsNum(i,1);}
+    // the i-th rule for the j-th bulk mesh type(see GetBulkMeshTypeIndex)
+    inline QPoint& GetBulkQPoint(const int &i,const int &j){
+        return _BulkQPointList[(i-1)*GetBulkMeshTypesNum()+j-1];
+    }
+    inline int GetBulkQpPointsNum(const int &i,const int &j)const{
+        return _BulkQPointList[(i-1)*GetBulkMeshTypesNum()+j-1].GetQpPointsNum();
+    }
+    int GetMaxBulkQpPointsNum()const;
+    inline int GetBulkQpOrder()const{return _BulkQPoint.GetQpOrder();}
+    inline QPointType GetQPointType()const{return _BulkQPoint.GetQpPointType();}
     QPoint& GetLineQPointPtr(){return _LineQPoint;}
     QPoint& GetSurfaceQPointPtr(){return _SurfaceQPoint;}
 
     ShapeFun& GetBulkShpPtr(){return _BulkShp;}
+    //***********************************************
+    //*** for the mixed mesh, each bulk mesh type has
+    //*** its own shape functions and qpoints
+    //***********************************************
+    inline int GetBulkMeshTypesNum()const{return static_cast<int>(_BulkMeshTypeList.size());}
+    // the index(start from 1) of the given bulk mesh type
+    int GetBulkMeshTypeIndex(const MeshType &meshtype)const;
+    inline ShapeFun& GetBulkShp(const int &i){return _BulkShpList[i-1];}
     ShapeFun& GetSurfaceShpPtr(){return _SurfaceShp;}
     ShapeFun& GetLineShpPtr(){return _LineShp;}
 
 
     void PrintFEInfo()const;
 
+private:
+    QPoint CreateBulkQPoint(const QPointType &qptype,const int &order,const MeshType &meshtype)const;
+
 public:
     QPoint _BulkQPoint,_LineQPoint,_SurfaceQPoint;
     ShapeFun _BulkShp,_LineShp,_SurfaceShp;
@@ -70,5 +99,10 @@ private:
     bool _HasDimSet=false;
     bool _IsInit=false;
     int _nBulkQpOrder,_nBCQpOrder;
+    MeshType _BulkMeshType;
+    vector<MeshType> _BulkMeshTypeList;          // the unique bulk mesh types
+    vector<ShapeFun> _BulkShpList;               // the bulk shape functions of each mesh type
+    vector<pair<QPointType,int>> _BulkQPointRuleList;// (qpoint type,order) of each rule, the 1st one is [qpoint]
+    vector<QPoint> _BulkQPointList;              // [(rule-1)*nTypes+type-1]
     
 };
\ No newline at end of file
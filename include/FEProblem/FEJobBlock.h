@@ -18,6 +18,7 @@
 #include <string>
 
 #include "Utils/MessagePrinter.h"
+#include "ElmtSystem/BulkElmtBatch.h"
 #include "FEProblem/FEJobType.h"
 
 using namespace std;
@@ -28,6 +29,13 @@ public:
     FEJobType _jobType=FEJobType::STATIC;
     string   _jobTypeName="static";
     bool _IsDebug=true,_IsDepDebug=false;
+    bool _UseMateCache=false;     // reuse the materials of the residual in the jacobian
+    double _MateCacheMemMB=512.0; // the memory limit of the material cache
+    bool _UseElmtBatch=false;     // the cross-element batched assembly
+    bool _UseFusedAssembly=false; // assemble the residual and the jacobian in one pass
+    int _nLoadSteps=1;            // the static load stepping, 1 means the full load at once
+    bool _UseArcLength=false;     // the arc-length continuation of the static load stepping
+    int _MaxCutbacks=5;           // the max successive cutbacks of one load step
 
 
     void Init(){
@@ -35,6 +43,13 @@ public:
         _jobTypeName="static";
         _IsDebug=true;
         _IsDepDebug=false;
+        _UseMateCache=false;
+        _MateCacheMemMB=512.0;
+        _UseElmtBatch=false;
+        _UseFusedAssembly=false;
+        _nLoadSteps=1;
+        _UseArcLength=false;
+        _MaxCutbacks=5;
     }
 
     void PrintJobInfo(){
@@ -48,6 +63,25 @@ public:
                 MessagePrinter::PrintNormalTxt("  debug print is enabled");
             }
         }
+        if(_UseMateCache){
+            char buff[70];
+            snprintf(buff,70,"  material cache is enabled(limit=%.1f MB)",_MateCacheMemMB);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
+        if(_UseElmtBatch){
+            char buff[70];
+            snprintf(buff,70,"  cross-element batched assembly is enabled(width=%d)",AsFemElmtBatchWidth);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
+        if(_UseFusedAssembly){
+            MessagePrinter::PrintNormalTxt("  fused residual and jacobian assembly is enabled");
+        }
+        if(_jobType==FEJobType::STATIC&&(_nLoadSteps>1||_UseArcLength)){
+            char buff[70];
+            snprintf(buff,70,"  load stepping: steps=%d, %s, max cutbacks=%d",_nLoadSteps,
+                     _UseArcLength?"arc-length":"load control",_MaxCutbacks);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
         MessagePrinter::PrintDashLine();
     }
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Define the work batch of the bulk elements, the local
+//+++          elements with the same mesh type, qpoint rule and the
+//+++          same [elmts] sub blocks(element, material and dofs)
+//+++          are grouped into one work batch, so the kernel related
+//+++          quantities are set up once, instead of once per element
+//+++          FormBulkFE loops over the work batches, then over the
+//+++          elements of each batch
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "ElmtSystem/ElmtType.h"
+#include "MateSystem/MateType.h"
+#include "ElmtSystem/BulkElmtKernelT.h"
+
+using namespace std;
+
+class BulkElmtWorkBatch{
+public:
+    BulkElmtWorkBatch(){
+        _MeshTypeIndex=1;_QPointIndex=1;_nNodes=0;_nKernels=0;
+        _BatchKernel=nullptr;
+    }
+    inline int GetElmtsNum()const{return static_cast<int>(_ElmtList.size());}
+
+public:
+    int _MeshTypeIndex;// see FE::GetBulkMeshTypeIndex
+    int _QPointIndex;  // the qpoint rule, see FE::GetBulkQPoint
+    int _nNodes;       // the nodes number of each element
+    int _nKernels;     // the number of the [elmts] sub blocks acting on each element
+    //*** the quantities of each kernel, the index starts from 0
+    vector<int> _BlockIndexList;              // see BulkElmtSystem::GetIthBulkElmtBlock
+    vector<ElmtType> _ElmtTypeList;
+    vector<MateType> _MateTypeList;
+    vector<int> _MateIndexList;
+    vector<vector<int>> _LocalDofIndexList;
+    vector<BulkElmtQpKernel> _QpKernelList;   // nullptr if the general RunBulkElmtLibs is used
+    vector<bool> _HasElmtLevelPartList;       // see BulkElmtSystem::HasBulkElmtElmtLevelPart
+    vector<bool> _IsElmtLevelOnlyList;        // see BulkElmtSystem::IsBulkElmtElmtLevelOnly
+    vector<bool> _IsJacobianTangentOnlyList;  // see BulkElmtSystem::IsBulkElmtJacobianTangentOnly
+    vector<double> _HourglassCoefList;
+    vector<vector<int>> _CouplingMaskList;    // see BulkElmtSystem::GetBulkElmtCouplingMask
+    vector<bool> _IsJacobianZeroList;         // true if all the blocks of the kernel are structurally zero
+    vector<bool> _IsFDJacobianList;           // true if the jacobian of the kernel is given by FESystem::FormFDJacobian
+    vector<double> _DensityList;              // the density of the mass matrix, see FESystem::FormBulkMass
+    vector<bool> _IsExplicitList;             // true if the kernel is in the explicit part of the IMEX time stepping
+    vector<bool> _IsFrozenList;               // true if all the dofs of the kernel are frozen, see FESystem::SetFrozenDofs
+    //*** the cross-element batch kernel, it is only set for the single kernel batch
+    BulkElmtBatchKernel _BatchKernel;
+    //*** the local elements of the batch, start from 0
+    vector<int> _ElmtList;
+};
@@ -19,6 +19,7 @@
 enum class FECalcType{
     ComputeResidual,
     ComputeJacobian,
+    ComputeResidualAndJacobian,// the fused pass, both of them are assembled in one element loop
     Projection,
     InitMaterialAndProjection,
     InitHistoryVariable,
@@ -38,9 +38,12 @@
 #include "FE/FE.h"
 #include "FE/ShapeFun.h"
 
+#include "FESystem/BulkElmtWorkBatch.h"
+
 #include "Utils/Vector3d.h"
 #include "Utils/VectorXd.h"
 #include "Utils/MatrixXd.h"
+#include "Utils/ElmtMatrixXd.h"
 
 using namespace std;
 
@@ -49,6 +52,7 @@ public:
     FESystem();
     void InitBulkFESystem(const Mesh &mesh,
                     const DofHandler &dofHandler,
+                    const ElmtSystem &elmtSystem,
                     FE &fe,
                     SolutionSystem &solution);
 
@@ -61,6 +65,36 @@ public:
     void SetMaxAMatrixValue(const double &val) {_MaxKMatrixValue=val;}
     inline double GetMaxAMatrixValue()const {return _MaxKMatrixValue;}
     inline double GetBulkVolume() const {return _BulkVolumes;}
+    //*** for the material cache between the residual and jacobian of the same iterate
+    void SetMateCacheOption(const bool &flag,const double &maxmemMB){_UseMateCache=flag;_MateCacheMaxMemMB=maxmemMB;}
+    inline bool IsMateCacheEnabled()const{return _UseMateCache;}
+    //*** the iterate of the last residual, it decides whether the material cache and the fused jacobian can be reused
+    void StampResidualIterate(const Vec &U,const Vec &V,const double &t,const double &dt,const SolutionSystem &solutionSystem);
+    void CheckResidualIterate(const Vec &U,const Vec &V,const double &t,const double &dt,const double (&ctan)[2],
+                              const SolutionSystem &solutionSystem);
+    //*** for the fused residual and jacobian assembly
+    void SetFusedAssemblyOption(const bool &flag){_UseFusedAssembly=flag;}
+    inline bool IsFusedAssemblyEnabled()const{return _UseFusedAssembly;}
+    // true if the jacobian assembled by the last(fused) residual is still the one of current iterate
+    inline bool IsFusedJacobianReusable()const{return _IsFusedJacobianReusable;}
+    //*** for the cross-element batched assembly
+    void SetElmtBatchOption(const bool &flag){_UseElmtBatch=flag;}
+    inline bool IsElmtBatchEnabled()const{return _UseElmtBatch;}
+
+    //*** for the finite difference jacobian of the [elmts] blocks with 'jacobian=fd'
+    inline bool HasFDJacobian()const{return _HasFDJacobian;}
+    //*** for the mass matrix of the second order time stepping, the [elmts] blocks with 'density='
+    inline bool HasMassMatrix()const{return _HasMassMatrix;}
+    //*** for the IMEX time stepping, the 'imex=explicit' blocks are moved to the explicit part
+    void SetIMEXOption(const bool &flag){_UseIMEX=flag;}
+    inline bool IsIMEXEnabled()const{return _UseIMEX;}
+    inline bool HasExplicitPart()const{return _HasExplicitPart;}
+    // true if all the implicit blocks are 'imex=linear', then the implicit jacobian only changes with dt
+    inline bool IsImplicitPartLinear()const{return _IsImplicitPartLinear;}
+    //*** for the multirate time stepping, the kernels whose dofs are all frozen(isFrozenDof[dofid-1]) are
+    //*** skipped by the residual and the jacobian, until ClearFrozenDofs is called
+    void SetFrozenDofs(const vector<bool> &isFrozenDof);
+    void ClearFrozenDofs();
 
     // for FEM simulation related functions
     void FormBulkFE(const FECalcType &calctype,const double &t,const double &dt,const double (&ctan)[2],
@@ -68,30 +102,55 @@ public:
                 ElmtSystem &elmtSystem,MateSystem &mateSystem,
                 SolutionSystem &solutionSystem,
                 Mat &AMATRIX,Vec &RHS);
+    // add the colored finite difference jacobian of the 'jacobian=fd' blocks to AMATRIX, which
+    // must already contain the analytic part of the same iterate(solutionSystem._Unew and _V)
+    void FormFDJacobian(const double &t,const double &dt,const double (&ctan)[2],
+                Mesh &mesh,const DofHandler &dofHandler,FE &fe,
+                ElmtSystem &elmtSystem,MateSystem &mateSystem,
+                SolutionSystem &solutionSystem,
+                Mat &AMATRIX);
+    // the residual of the 'imex=explicit' blocks as the rhs of the IMEX time stepping, i.e. RHS=-R_explicit
+    void FormExplicitResidual(const double &t,const double &dt,const double (&ctan)[2],
+                Mesh &mesh,const DofHandler &dofHandler,FE &fe,
+                ElmtSystem &elmtSystem,MateSystem &mateSystem,
+                SolutionSystem &solutionSystem,
+                Mat &AMATRIX,Vec &RHS);
+    // assemble the consistent mass matrix rho*N_a*N_b of each dof once, it has the sparsity of AMATRIX
+    void FormBulkMass(Mesh &mesh,const DofHandler &dofHandler,FE &fe,Mat &AMATRIX);
+    // RHS+=M*Uddot, it must be called before the boundary conditions are applied
+    void AddMassResidual(const Vec &Uddot,Vec &RHS);
+    // AMATRIX+=shiftA*M, where shiftA=dUddot/dU
+    void AddMassJacobian(const double &shiftA,Mat &AMATRIX);
     
     
 private:
     //*********************************************************
     //*** assemble residual to local and global one
     //*********************************************************
-    void AssembleSubResidualToLocalResidual(const int &ndofspernode,const int &dofs,const int &iInd,
-                                            const VectorXd &subR,VectorXd &localR);
+    void AssembleSubResidualToLocalResidual(const int &ndofspernode,const vector<int> &localDofIndex,const int &iInd,
+                                            const VectorXd &subR,ElmtVectorXd &localR);
     void AccumulateLocalResidual(const int &dofs,const vector<double> &dofsactiveflag,const double &JxW,
-                                 const VectorXd &localR,vector<double> &sumR);
+                                 const ElmtVectorXd &localR,vector<double> &sumR);
     void AssembleLocalResidualToGlobalResidual(const int &ndofs,const vector<int> &dofindex,
                                             const vector<double> &residual,Vec &rhs);
 
     //*********************************************************
     //*** assemble jacobian to local and global one
     //*********************************************************
-    void AssembleSubJacobianToLocalJacobian(const int &ndofspernode,
+    void AssembleSubJacobianToLocalJacobian(const int &ndofspernode,const vector<int> &localDofIndex,
+                                            const vector<int> &couplingMask,
                                             const int &iInd,const int &jInd,
-                                            const MatrixXd &subK,MatrixXd &localK);
+                                            const MatrixXd &subK,ElmtMatrixXd &localK);
     void AccumulateLocalJacobian(const int &dofs,const vector<double> &dofsactiveflag,const double &JxW,
-                                 const MatrixXd &localK,vector<double> &sumK);
-    void AssembleLocalJacobianToGlobalJacobian(const int &ndofs,const vector<int> &dofindex,
+                                 const ElmtMatrixXd &localK,vector<double> &sumK);
+    // dofCouplingMask is the one of DofHandler::GetIthBulkElmtDofCouplingMask, empty for the dense one
+    void AssembleLocalJacobianToGlobalJacobian(const int &ndofs,const int &ndofspernode,const vector<int> &dofindex,
+                                            const vector<int> &dofCouplingMask,
                                             const vector<double> &jacobian,Mat &K);
 
+    // evaluate the batch kernel on the element batch and assemble all its lanes
+    void FlushBulkElmtBatch(const FECalcType &calctype,const BulkElmtBatchKernel &batchKernel,Mat &AMATRIX,Vec &RHS);
+
     void AssembleLocalToGlobal(const int &isw,const int &ndofs,vector<int> &elDofs,
                                vector<double> &localK,vector<double> &localR,
                                Mat &AMATRIX,Vec &RHS);
@@ -129,20 +188,47 @@ private:
     //*********************************************************
     void AssembleSubHistToLocal(const int &e,const int &ngp,const int &gpInd,const Materials &mate,SolutionSystem &solutionSystem);
     void AssembleLocalHistToGlobal(const int &e,const int &ngp,SolutionSystem &solutionSystem);
+
+    //*********************************************************
+    //*** for the shape functions on each qpoint
+    //*********************************************************
+    double CalcBulkShapeFunOnIthQpoint(const int &nDim,const int &gpInd,const QPoint &qpoint,ShapeFun &shp);
+
+    //*********************************************************
+    //*** for the work batches of the local elements
+    //*********************************************************
+    void CreateBulkElmtWorkBatches(const int &eStart,const int &eEnd,const Mesh &mesh,
+                                   const DofHandler &dofHandler,const ElmtSystem &elmtSystem);
+
+    //*********************************************************
+    //*** for the material cache
+    //*********************************************************
+    bool InitMateCache(const int &eStart,const int &eEnd,const int &nQp,const DofHandler &dofHandler,const Materials &mate);
+
+    //*********************************************************
+    //*** for the finite difference jacobian
+    //*********************************************************
+    // the residual of the 'jacobian=fd' blocks at the perturbed U, it is called by MatFDColoringApply
+    static PetscErrorCode ComputeFDResidual(void *dummy,Vec U,Vec F,void *ctx);
+    // the max value of the assembled AMATRIX is taken into _MaxKMatrixValue(the penalty of the dirichlet bc)
+    void UpdateMaxAMatrixValue(Mat &AMATRIX);
     
 
 public:
     void PrintFESystemInfo() const;
+    void PrintActiveSetSummary() const;// the fraction of the plastic/damaged qpoints
+    void ReleaseMem();
 
 
 
 private:
     double _BulkVolumes=0.0;
-    MatrixXd _localK;    //used in uel, the size is the maximum dofs per element
-    VectorXd _localR;    //used in uel, the size is the maximum dofs per element
+    ElmtMatrixXd _localK;//used in uel, reserved once to the largest element, resized to the dofs of each element
+    ElmtVectorXd _localR;//used in uel, reserved once to the largest element, resized to the dofs of each element
     MatrixXd _subK; // used in each sub element, the size is the maximum dofs per node
     VectorXd _subR; // used in each sub element, the size is the maximum dofs per node
     vector<double> _K,_R;//used in assemble
+    vector<int> _maskedCols;vector<double> _maskedVals;// one row of the masked jacobian
     
     
     Nodes _elNodes;
@@ -161,10 +247,70 @@ private:
     int _nHist,_nProj,_nGPoints;
     double _MaxKMatrixValue=-1.0e9,_KMatrixFactor=0.1;
 
-    ElmtType elmttype;
-    MateType matetype;
-    vector<int> localDofIndex;
-    int mateindex;
+    //*** for the batched material calculation, all the qpoints of one element are kept
+    BulkMateBatch _mateBatch;
+    int _nMaxNodes;
+    vector<double> _gpJxW;            // JxW of each qpoint
+    vector<double> _gpShpVal;         // shape value, index=(qp-1)*_nMaxNodes+i-1
+    vector<Vector3d> _gpShpGrad;      // shape gradient, same index as _gpShpVal
+    vector<map<string,double>> _gpProjList;// projection quantities of each qpoint
+    int _nElasticQpoints,_nInelasticQpoints;// the qpoint states reported by the materials
+    vector<int> _elQPointIndex;       // the qpoint rule(see FE::GetBulkQPoint) of each bulk element
+    vector<int> _elMeshTypeIndex;     // the mesh type index(see FE::GetBulkMeshTypeIndex) of each bulk element
+    vector<BulkElmtWorkBatch> _elmtWorkBatchList;// the local bulk elements, grouped by the mesh type and kernels
+
+    //*** for the material cache, the materials of each sub element and qpoint evaluated in the
+    //*** residual pass are reused by the jacobian pass if the iterate is not changed
+    bool _UseMateCache=false,_IsMateCacheFilled=false,_IsMateCacheReusable=false;
+    double _MateCacheMaxMemMB=512.0;
+    vector<Materials> _MateCache;  // index=_MateCacheOffset[e-eStart]+(ielmt-1)*_nGPoints+qp
+    vector<int> _MateCacheOffset;
+    bool _IsMateCacheVecCreated=false;
+    Vec _MateCacheVec[2];               // U and V of the last residual
+    Vec _MateCacheU,_MateCacheV;        // the copy of their values
+    PetscObjectState _MateCacheState[4];// state of U, V, Uold, Vold
+    double _MateCacheTime[2];           // t and dt
+
+    //*** for the elastic short-circuit, the sub elements whose qpoints are all ELASTIC(see MateQpState)
+    //*** in the residual pass keep the constant elastic tangent, so the jacobian pass of the same
+    //*** iterate skips their material calculation, it only needs one flag for each sub element
+    bool _HasElasticTangentKernel=false,_IsElasticKernelListFilled=false,_IsElasticKernelListReusable=false;
+    vector<int> _ElmtKernelOffset;      // the offset of each local element in _ElasticKernelList
+    vector<char> _ElasticKernelList;    // index=_ElmtKernelOffset[e-eStart]+ielmt-1
+
+    //*** for the cross-element batched assembly, the elements of the work batch with a single
+    //*** batchable kernel are gathered into the element batch, and assembled once it is full
+    bool _UseElmtBatch=false;
+    BulkElmtBatch _elmtBatch;
+
+    //*** for the fused assembly, the jacobian is assembled together with the residual, and the
+    //*** jacobian evaluation of the same iterate only applies the boundary conditions
+    bool _UseFusedAssembly=false,_IsFusedJacobianFilled=false,_IsFusedJacobianReusable=false;
+    double _FusedJacobianCtan[2]={0.0,0.0};
+
+    //*** for the finite difference jacobian, the coloring is created from the sparsity of the first
+    //*** jacobian, then the residual of the 'jacobian=fd' blocks is evaluated once for each color
+    bool _HasFDJacobian=false,_IsFDResidualPass=false,_IsFDColoringCreated=false;
+    MatFDColoring _FDColoring;
+    ISColoring _FDISColoring;
+    Mat _AFD;           // the finite difference part of the jacobian
+    Vec _FDU0,_FDV0;    // U and V of current iterate
+    struct{
+        double t,dt,ctan[2];
+        Mesh *mesh;const DofHandler *dofHandler;FE *fe;
+        ElmtSystem *elmtSystem;MateSystem *mateSystem;SolutionSystem *solutionSystem;
+    } _FDContext;       // the arguments of FormBulkFE used by ComputeFDResidual
+
+    //*** for the mass matrix, it only depends on the mesh and the density, so it is assembled once
+    bool _HasMassMatrix=false,_IsMassMatrixCreated=false;
+    Mat _MMATRIX;
+
+    //*** for the IMEX time stepping, FormBulkFE only takes the implicit blocks, unless it is the
+    //*** explicit pass of FormExplicitResidual, which only takes the explicit ones
+    bool _UseIMEX=false,_HasExplicitPart=false,_IsImplicitPartLinear=false,_IsExplicitPass=false;
+
+    //*** for the multirate time stepping, the sub step of one dofs group skips the kernels of the other one
+    bool _HasFrozenKernel=false;
 
 private:
     //************************************
@@ -44,6 +44,7 @@
 #include "OutputSystem/OutputSystem.h"
 #include "Postprocess/Postprocess.h"
 #include "FEProblem/FEJobBlock.h"
+#include "MatDriver/MatDriverBlock.h"
 
 
 class InputSystem{
@@ -64,6 +65,9 @@ public:
 
     bool IsReadOnlyMode()const{return _IsReadOnly;}
 
+    // for the material point driver, only [mates] and [matdriver] are read
+    bool ReadMatDriverInputFile(MateSystem &mateSystem,MatDriverBlock &matDriverBlock);
+
 private:
     //******************************************************
     //*** functions for reading each block
@@ -115,6 +119,11 @@ private:
     //******************************************************
     bool ReadFEJobBlock(ifstream &in,string str,int &linenum,FEJobBlock &feJobBlock);
 
+    //******************************************************
+    //*** functions for reading [matdriver]
+    //******************************************************
+    bool ReadMatDriverBlock(ifstream &in,string str,int &linenum,MatDriverBlock &matDriverBlock);
+
     
     //******************************************************
     //*** private variables
@@ -0,0 +1,68 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: The material point driver, it runs one material of
+//+++          the [mates] block along a prescribed strain path
+//+++          without any mesh/dofs/solver, then reports the
+//+++          stress path, the finite difference check of the
+//+++          jacobian and the throughput(qpoints/s)
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "MateSystem/MateSystem.h"
+#include "MatDriver/MatDriverBlock.h"
+
+using namespace std;
+
+class MatDriver{
+public:
+    MatDriver();
+
+    void Run(MateSystem &mateSystem,const MatDriverBlock &matDriverBlock);
+
+private:
+    void FindMateBlock(const MateSystem &mateSystem,const MatDriverBlock &matDriverBlock);
+    void Init(MateSystem &mateSystem,const MatDriverBlock &matDriverBlock);
+    // set the displacement gradient for the given load factor(0~1) of the target
+    void SetGradU(const MatDriverBlock &matDriverBlock,const double &factor);
+    void RunMate(MateSystem &mateSystem,const double &t);
+    // returns the max relative error between the finite difference tangent and the jacobian,
+    // a negative value means the material has no stress or jacobian to check
+    double CheckJacobian(MateSystem &mateSystem,const double &t,const double &eps);
+    // it is called at the peak load, the history(MaterialsOld) is not touched
+    void RunBenchmark(MateSystem &mateSystem,const MatDriverBlock &matDriverBlock,const double &t);
+
+    void WriteHeader(ofstream &out,const Materials &mate)const;
+    void WriteStep(ofstream &out,const int &step,const double &t,const double &factor,const Materials &mate)const;
+
+    double Duration(chrono::high_resolution_clock::time_point &p1,chrono::high_resolution_clock::time_point &p2){
+        return chrono::duration_cast<std::chrono::microseconds>(p2-p1).count()/1.0e6;
+    }
+
+private:
+    MateType _MateType;
+    int _MateIndex;
+    int _nDim;
+    double _dt;
+    const int _nMaxDofs=10;// the 0-th slot is not used
+    Vector3d _gpCoord;
+    vector<double> _gpU,_gpUOld,_gpUdot,_gpUdotOld;
+    vector<Vector3d> _gpGradU,_gpGradUOld,_gpGradUdot,_gpGradUdotOld;
+    BulkMateBatch _Batch;
+};
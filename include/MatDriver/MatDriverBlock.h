@@ -0,0 +1,80 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Define the [matdriver] block for the material point
+//+++          driver(asfem-matdriver), it prescribes the strain
+//+++          (or displacement gradient) path of one qpoint
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Utils/MessagePrinter.h"
+
+using namespace std;
+
+enum class MatDriverPathType{
+    STRAIN,   // 6 components: 11,22,33,23,13,12, the displacement gradient is symmetric
+    GRADU,    // 9 components of the displacement gradient, row by row
+    DEFORMGRAD// 9 components of the deformation gradient F, grad(u)=F-I
+};
+
+class MatDriverBlock{
+public:
+    string _MateBlockName="";// empty means the first [mates] sub block
+    int _nDim=3;
+    MatDriverPathType _PathType=MatDriverPathType::STRAIN;
+    string _PathTypeName="strain";
+    vector<double> _Target;  // the final value of the path
+    int _nSteps=10;          // steps from zero to the target
+    bool _IsUnload=false;    // go back to zero after the target is reached
+    double _dt=1.0;          // time increment of each step
+    int _nRepeats=100000;    // material evaluations for the throughput measurement
+    int _BatchSize=8;        // qpoints per batched call
+    bool _IsFDCheck=true;    // finite difference check of the jacobian
+    double _FDEps=1.0e-7;
+    string _OutputFileName="matdriver.csv";
+
+    void Init(){
+        _MateBlockName="";
+        _nDim=3;
+        _PathType=MatDriverPathType::STRAIN;
+        _PathTypeName="strain";
+        _Target.assign(9,0.0);
+        _nSteps=10;
+        _IsUnload=false;
+        _dt=1.0;
+        _nRepeats=100000;
+        _BatchSize=8;
+        _IsFDCheck=true;
+        _FDEps=1.0e-7;
+        _OutputFileName="matdriver.csv";
+    }
+
+    void PrintMatDriverInfo()const{
+        char buff[70];
+        MessagePrinter::PrintNormalTxt("Material point driver information summary:");
+        MessagePrinter::PrintNormalTxt("  mate block="+(_MateBlockName.size()?_MateBlockName:string("(first one)"))+", path type="+_PathTypeName);
+        snprintf(buff,70,"  dim=%d, steps=%d, dt=%12.5e, unload=%s",_nDim,_nSteps,_dt,_IsUnload?"true":"false");
+        MessagePrinter::PrintNormalTxt(string(buff));
+        snprintf(buff,70,"  repeats=%d, batch size=%d",_nRepeats,_BatchSize);
+        MessagePrinter::PrintNormalTxt(string(buff));
+        if(_IsFDCheck){
+            snprintf(buff,70,"  finite difference check is enabled, eps=%12.5e",_FDEps);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
+        MessagePrinter::PrintNormalTxt("  output file="+_OutputFileName);
+        MessagePrinter::PrintDashLine();
+    }
+};
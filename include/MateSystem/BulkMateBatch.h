@@ -0,0 +1,116 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Define the qpoint batch used by the batched material
+//+++          calculation, it holds the inputs (dofs and their
+//+++          gradients) and the outputs (materials) of all the
+//+++          qpoints of one element, so one material call can
+//+++          evaluate all of them
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "MateSystem/MateTypeDefine.h"
+#include "Utils/Vector3d.h"
+#include "Utils/RankTwoTensor.h"
+
+using namespace std;
+
+//*** the state reported by the material for each qpoint, ELASTIC means the internal
+//*** state(plastic strain, damage, ...) is unchanged, INELASTIC means it evolves
+enum class MateQpState{
+    UNKNOWN,
+    ELASTIC,
+    INELASTIC
+};
+
+class BulkMateBatch{
+public:
+    BulkMateBatch(){
+        _nQp=0;_nMaxQp=0;
+    }
+    void Init(const int &maxqp,const int &maxdofs){
+        // maxdofs should include the 0-th slot, since the dofs index starts from 1
+        _nMaxQp=maxqp;_nQp=maxqp;
+        _gpCoord.assign(maxqp,Vector3d(0.0));
+        _gpU.assign(maxqp,vector<double>(maxdofs,0.0));
+        _gpUOld.assign(maxqp,vector<double>(maxdofs,0.0));
+        _gpUdot.assign(maxqp,vector<double>(maxdofs,0.0));
+        _gpUdotOld.assign(maxqp,vector<double>(maxdofs,0.0));
+        _gpGradU.assign(maxqp,vector<Vector3d>(maxdofs,Vector3d(0.0)));
+        _gpGradUOld.assign(maxqp,vector<Vector3d>(maxdofs,Vector3d(0.0)));
+        _gpGradUdot.assign(maxqp,vector<Vector3d>(maxdofs,Vector3d(0.0)));
+        _gpGradUdotOld.assign(maxqp,vector<Vector3d>(maxdofs,Vector3d(0.0)));
+        _Mates.resize(maxqp);
+        _MatesOld.resize(maxqp);
+        _QpState.assign(maxqp,MateQpState::UNKNOWN);
+    }
+    inline int GetQpPointsNum()const{return _nQp;}
+    //*** for the qpoint state, if several materials act on the same qpoint, the inelastic one wins
+    inline void ResetQpState(){
+        for(int qp=0;qp<_nQp;qp++) _QpState[qp]=MateQpState::UNKNOWN;
+    }
+    inline void SetIthQpState(const int &qp,const MateQpState &state){
+        if(static_cast<int>(state)>static_cast<int>(_QpState[qp])) _QpState[qp]=state;
+    }
+    //*** the Mandel tangent(see Materials::SymTangent) must be given again by each material call
+    inline void ResetSymTangent(){
+        for(int qp=0;qp<_nQp;qp++) _Mates[qp].HasSymTangent=false;
+    }
+    //*****************************************************************************
+    //*** SoA buffers for the small strain materials, the layout is component
+    //*** major: val[(c-1)*nQp+qp], where c=1~6 follows 11,22,33,23,13,12
+    //*****************************************************************************
+    inline void ComputeSmallStrainSoA(const int &nDim){
+        const int nqp=_nQp;
+        if(static_cast<int>(_Strain.size())<6*nqp){
+            _Strain.resize(6*nqp,0.0);
+            _Stress.resize(6*nqp,0.0);
+            _Scalar.resize(nqp,0.0);
+        }
+        double *e=_Strain.data();
+        for(int c=0;c<6*nqp;c++) e[c]=0.0;
+        for(int qp=0;qp<nqp;qp++){
+            const vector<Vector3d> &g=_gpGradU[qp];
+            e[qp]=g[1](1);
+            if(nDim>=2){
+                e[  nqp+qp]=g[2](2);
+                e[5*nqp+qp]=0.5*(g[1](2)+g[2](1));
+            }
+            if(nDim==3){
+                e[2*nqp+qp]=g[3](3);
+                e[3*nqp+qp]=0.5*(g[2](3)+g[3](2));
+                e[4*nqp+qp]=0.5*(g[1](3)+g[3](1));
+            }
+        }
+    }
+    inline void GetIthSoATensor(const vector<double> &vals,const int &qp,RankTwoTensor &a) const{
+        // qp starts from 0
+        a.SetFromVoigt(vals[qp],vals[_nQp+qp],vals[2*_nQp+qp],
+                       vals[3*_nQp+qp],vals[4*_nQp+qp],vals[5*_nQp+qp]);
+    }
+
+public:
+    int _nQp;   // the number of qpoints in current batch
+    int _nMaxQp;// the capacity of the batch
+    //*** inputs of each qpoint, the index is [qp][dof], qp starts from 0 and dof starts from 1
+    vector<Vector3d> _gpCoord;
+    vector<vector<double>> _gpU,_gpUOld,_gpUdot,_gpUdotOld;
+    vector<vector<Vector3d>> _gpGradU,_gpGradUOld,_gpGradUdot,_gpGradUdotOld;
+    //*** outputs(and the history) of each qpoint
+    vector<Materials> _Mates,_MatesOld;
+    vector<MateQpState> _QpState;
+    //*** SoA work arrays of the small strain materials
+    vector<double> _Strain,_Stress,_Scalar;
+};
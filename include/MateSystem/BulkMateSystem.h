@@ -47,6 +47,7 @@
 #include "MateSystem/Plastic1DMaterial.h"
 #include "MateSystem/J2PlasticityMaterial.h"
 #include "MateSystem/MieheFractureMaterial.h"
+#include "MateSystem/User1Material.h"
 
 class BulkMateSystem: public ConstPoissonMaterial,
                       public ConstDiffusionMaterial,
@@ -56,7 +57,8 @@ class BulkMateSystem: public ConstPoissonMaterial,
                       public NeoHookeanMaterial,
                       public Plastic1DMaterial,
                       public J2PlasticityMaterial,
-                      public MieheFractureMaterial{
+                      public MieheFractureMaterial,
+                      public User1Material{
 public:
     BulkMateSystem();
     void InitBulkMateSystem();
@@ -66,6 +68,7 @@ public:
     //********************************************
     inline int GetMateBlockNums()const{return _nBulkMateBlocks;}
     inline MateBlock GetIthMateBlock(const int &i)const{return _BulkMateBlockList[i-1];}
+    inline const MateConstants& GetIthMateConstants(const int &i)const{return _BulkMateBlockList[i-1]._Constants;}
     inline vector<MateBlock> GetMateBlockVec()const{return _BulkMateBlockList;}
 
 
@@ -179,6 +182,13 @@ public:
                           const vector<double> &gpU,const vector<double> &gpUdot,
                           const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot);
 
+    // the batched version, all the qpoints in Batch are evaluated by one material call
+    void RunBulkMateLibsBatch(const MateType &imate,const int &mateindex,const int &nDim,
+                              const double &t,const double &dt,BulkMateBatch &Batch);
+    void InitBulkMateLibsBatch(const MateType &imate,const int &mateindex,const int &nDim,BulkMateBatch &Batch);
+
+    void SetupBulkMateLibs(const MateType &imate,const int &mateindex);
+
 
 
     void PrintBulkMateSystemInfo()const;
@@ -213,13 +223,4 @@ protected:
                                 const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradV,
                                 vector<double> &gpHist,const vector<double> &gpHistOld);
 
-    //******************************************************************************
-    //*** for User-Defined-Materials (UMAT)
-    //******************************************************************************
-    void User1Material(const int &nDim,const double &t,const double &dt,
-                               const vector<double> &InputParams,
-                               const Vector3d &gpCoord,
-                               const vector<double> &gpU,const vector<double> &gpV,
-                               const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradV,
-                               vector<double> &gpHist,const vector<double> &gpHistOld);
 };
\ No newline at end of file
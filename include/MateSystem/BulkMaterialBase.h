@@ -23,11 +23,21 @@
 
 // For AsFem's own header files
 #include "MateSystem/MateTypeDefine.h"
+#include "MateSystem/MateConstants.h"
+#include "MateSystem/BulkMateBatch.h"
+#include "Utils/MessagePrinter.h"
 
 using namespace std;
 
 class BulkMaterialBase{
 public:
+    // called once for each [mates] block before the analysis, the parameters are checked here
+    // and the derived constants(lame constants, elastic tensor, ...) are stored in Consts
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+        if(InputParams.size()){}
+        Consts._IsSetup=true;
+    }
+
     virtual void InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
                                         const vector<double> &gpU,const vector<double> &gpUdot,
                                         const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
@@ -35,10 +45,36 @@ public:
 
     virtual void ComputeMaterialProperties(const double &t,const double &dt,const int &nDim,
                                            const Vector3d &gpCoord,const vector<double> &InputParams,
-                                           const vector<double> &gpU,const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                            const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
                                            const Materials &MateOld,Materials &Mate)=0;// the calculation of different materials
 
+    //*****************************************************************************
+    //*** the batched version, all the qpoints of Batch are evaluated in one call,
+    //*** by default it just loops over the qpoints, materials which can be written
+    //*** in SoA form (i.e. small strain mechanics) should override it
+    //*****************************************************************************
+    virtual void InitMaterialPropertiesBatch(const int &nDim,const vector<double> &InputParams,BulkMateBatch &Batch){
+        for(int qp=0;qp<Batch._nQp;qp++){
+            InitMaterialProperties(nDim,Batch._gpCoord[qp],InputParams,
+                                   Batch._gpU[qp],Batch._gpUdot[qp],
+                                   Batch._gpGradU[qp],Batch._gpGradUdot[qp],
+                                   Batch._Mates[qp]);
+        }
+    }
+    virtual void ComputeMaterialPropertiesBatch(const double &t,const double &dt,const int &nDim,
+                                                const vector<double> &InputParams,const MateConstants &Consts,
+                                                BulkMateBatch &Batch){
+        for(int qp=0;qp<Batch._nQp;qp++){
+            ComputeMaterialProperties(t,dt,nDim,Batch._gpCoord[qp],InputParams,Consts,
+                                      Batch._gpU[qp],Batch._gpUOld[qp],
+                                      Batch._gpUdot[qp],Batch._gpUdotOld[qp],
+                                      Batch._gpGradU[qp],Batch._gpGradUOld[qp],
+                                      Batch._gpGradUdot[qp],Batch._gpGradUdotOld[qp],
+                                      Batch._MatesOld[qp],Batch._Mates[qp]);
+        }
+    }
+
 };
\ No newline at end of file
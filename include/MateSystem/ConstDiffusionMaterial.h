@@ -21,6 +21,8 @@
 
 class ConstDiffusionMaterial:public BulkMaterialBase{
 public:
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
     virtual void InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,const vector<double> &InputParams,
                                         const vector<double> &gpU,const vector<double> &gpUdot,
                                         const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
@@ -28,7 +30,7 @@ public:
 
     virtual void ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                            const Vector3d &gpCoord, const vector<double> &InputParams,
-                                           const vector<double> &gpU, const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                            const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
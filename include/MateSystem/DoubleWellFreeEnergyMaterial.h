@@ -20,6 +20,8 @@
 class DoubleWellFreeEnergyMaterial: public FreeEnergyMaterialBase{
 public:
     DoubleWellFreeEnergyMaterial();
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
     virtual void InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
                                         const vector<double> &gpU,const vector<double> &gpUdot,
                                         const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
@@ -27,7 +29,7 @@ public:
 
     virtual void ComputeMaterialProperties(const double &t, const double &dt,const int &nDim,
                                            const Vector3d &gpCoord,const vector<double> &InputParams,
-                                           const vector<double> &gpU,const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                            const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
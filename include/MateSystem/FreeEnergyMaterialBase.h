@@ -21,4 +21,16 @@ protected:
     virtual void ComputedFdU(const vector<double> &InputParams,const vector<double> &U,const vector<double> &dUdt,vector<double> &dF)=0;
     virtual void Computed2FdU2(const vector<double> &InputParams,const vector<double> &U,const vector<double> &dUdt,vector<double> &d2F)=0;
 
+    //*******************************************************************
+    //*** the tabulated free energy, F and dF/dU of nVars(1 or 2) variables
+    //*** are tabulated on [umin,umax]^nVars with n intervals in the setup
+    //*** stage, then the qpoints use the table instead of the analytic form.
+    //*** for two variables, d2F is stored as F,11 F,12 F,21 F,22
+    //*******************************************************************
+    void SetupFreeEnergyTable(const vector<double> &InputParams,const int &nVars,const int &n,
+                              const double &umin,const double &umax,MateConstants &Consts);
+    // returns false if U is out of the table range, then the analytic form should be used
+    bool ComputeFreeEnergyFromTable(const MateConstants &Consts,const vector<double> &U,
+                                    vector<double> &F,vector<double> &dF,vector<double> &d2F)const;
+
 };
\ No newline at end of file
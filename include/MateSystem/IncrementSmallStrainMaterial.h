@@ -18,6 +18,8 @@
 
 class IncrementSmallStrainMaterial: public MechanicsMaterialBase{
 public:
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
     virtual void InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
                                         const vector<double> &gpU,const vector<double> &gpUdot,
                                         const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
@@ -25,7 +27,7 @@ public:
 
     virtual void ComputeMaterialProperties(const double &t, const double &dt,const int &nDim,
                                            const Vector3d &gpCoord,const vector<double> &InputParams,
-                                           const vector<double> &gpU,const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                            const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
@@ -33,9 +35,9 @@ public:
 
 private:
     virtual void ComputeStrain(const int &nDim,const vector<Vector3d> &GradDisp, RankTwoTensor &Strain) override;
-    virtual void ComputeStressAndJacobian(const vector<double> &InputParams,const RankTwoTensor &Strain,RankTwoTensor &Stress,RankFourTensor &Jacobian) override;
+    virtual void ComputeStressAndJacobian(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &Strain,RankTwoTensor &Stress,RankFourTensor &Jacobian) override;
 
 private:
-    RankTwoTensor _GradU,_Strain,_StrainOld,_DeltaStrain,_Stress,_StressOld,_DeltaStress,_I,_devStress;
+    RankTwoTensor _GradU,_Strain,_StrainOld,_DeltaStrain,_Stress,_StressOld,_DeltaStress,_devStress;
     RankFourTensor _Jac;
 };
\ No newline at end of file
@@ -18,6 +18,8 @@
 
 class J2PlasticityMaterial:public PlasticMaterialBase{
 public:
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
     virtual void InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                         const vector<double> &InputParams,
                                         const vector<double> &gpU, const vector<double> &gpUdot,
@@ -27,7 +29,7 @@ public:
     virtual void ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                            const Vector3d &gpCoord,
                                            const vector<double> &InputParams,
-                                           const vector<double> &gpU, const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,
                                            const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,
@@ -36,6 +38,10 @@ public:
                                            const vector<Vector3d> &gpGradUdotOld,
                                            const Materials &MateOld, Materials &Mate) override;
 
+    virtual void ComputeMaterialPropertiesBatch(const double &t,const double &dt,const int &nDim,
+                                                const vector<double> &InputParams,const MateConstants &Consts,
+                                                BulkMateBatch &Batch) override;
+
 
 private:
     virtual void ComputeStrain(const int &nDim,const vector<Vector3d> &GradDisp,RankTwoTensor &Strain) override;
@@ -43,6 +49,9 @@ private:
 
     virtual double ComputeYieldFunction(const vector<double> &InputParams,const double &trial_strss,const double &effect_plastic_strain) override;
 
+    // the radial return from the trial state(_STrial, _F), shared by the single and the batched version
+    void ComputeReturnMapping(const MateConstants &Consts,Materials &Mate);
+
     inline double Sign(const double &x){
         if(x>0.0){
             return 1.0;
@@ -52,15 +61,17 @@ private:
         }
     }
 private:
-    RankTwoTensor _GradU,_Stress,_Strain,_I;
+    RankTwoTensor _GradU,_Stress,_Strain;
     RankTwoTensor _devStress,_devStrain;
     RankTwoTensor _plastic_strain_old;
     RankTwoTensor _STrial,_N;
-    RankFourTensor _Jac,_I4Sym;
-    double _E,_nu,_Lambda,_Mu,_Effect_Plastic_Strain_Old;
+    RankFourTensor _Jac;
+    SymRankFourTensor _SymJac;// _Jac in the Mandel storage
+    double _Effect_Plastic_Strain_Old;
     double _F,_DeltaGamma;
-    double _hardening_modulus;
     double _thetabar,_theta;
+    vector<double> _BatchPlasticStrainOld,_BatchEffectPlasticStrainOld;// SoA history for the batched version
+    vector<double> _BatchVonMises;
 
 
 
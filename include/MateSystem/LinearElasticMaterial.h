@@ -17,6 +17,8 @@
 
 class LinearElasticMaterial: public MechanicsMaterialBase{
 public:
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
     virtual void InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
                                         const vector<double> &gpU,const vector<double> &gpUdot,
                                         const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
@@ -24,17 +26,21 @@ public:
 
     virtual void ComputeMaterialProperties(const double &t, const double &dt,const int &nDim,
                                            const Vector3d &gpCoord,const vector<double> &InputParams,
-                                           const vector<double> &gpU,const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                            const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
                                            const Materials &MateOld, Materials &Mate) override;
 
+    virtual void ComputeMaterialPropertiesBatch(const double &t,const double &dt,const int &nDim,
+                                                const vector<double> &InputParams,const MateConstants &Consts,
+                                                BulkMateBatch &Batch) override;
+
 private:
     virtual void ComputeStrain(const int &nDim,const vector<Vector3d> &GradDisp, RankTwoTensor &Strain) override;
-    virtual void ComputeStressAndJacobian(const vector<double> &InputParams,const RankTwoTensor &Strain,RankTwoTensor &Stress,RankFourTensor &Jacobian) override;
+    virtual void ComputeStressAndJacobian(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &Strain,RankTwoTensor &Stress,RankFourTensor &Jacobian) override;
 
 private:
-    RankTwoTensor _GradU,_Strain,_Stress,_I,_devStress;
+    RankTwoTensor _GradU,_Strain,_Stress,_devStress;
     RankFourTensor _Jac;
 };
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "Utils/MessagePrinter.h"
 
 #include "MateSystem/MateType.h"
+#include "MateSystem/MateConstants.h"
 
 using namespace std;
 
@@ -33,6 +34,7 @@ public:
         _MateType=MateType::NULLMATE;
         _Parameters.clear();
         _MateBlockIndex=0;
+        _Constants.Init();
     }
 
     string         _MateBlockName;
@@ -40,6 +42,7 @@ public:
     MateType       _MateType;
     vector<double> _Parameters;
     int            _MateBlockIndex;
+    MateConstants  _Constants;// filled by the material's setup stage
 
     void Init(){
         _MateBlockName.clear();
@@ -47,5 +50,6 @@ public:
         _MateType=MateType::NULLMATE;
         _Parameters.clear();
         _MateBlockIndex=0;
+        _Constants.Init();
     }
 };
\ No newline at end of file
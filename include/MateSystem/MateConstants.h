@@ -0,0 +1,57 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Define the per-block material constants, they are
+//+++          computed once in the setup stage of each [mates]
+//+++          block (i.e. lame constants, elastic tensor), then
+//+++          the qpoint routine only reads them
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "Utils/RankTwoTensor.h"
+#include "Utils/RankFourTensor.h"
+#include "Utils/SymRankFourTensor.h"
+#include "Utils/SplineTable.h"
+
+using namespace std;
+
+class MateConstants{
+public:
+    MateConstants(){
+        Init();
+    }
+
+    bool           _IsSetup;
+    vector<double> _Scalars; // derived scalar constants, the order is defined by each material
+    RankTwoTensor  _I;       // rank-2 identity tensor
+    RankFourTensor _I4Sym;   // symmetric rank-4 identity tensor
+    RankFourTensor _ElasticC;// constant elastic tensor (if any)
+    SymRankFourTensor _ElasticSymC;// _ElasticC in the Mandel storage, it is set together with _IsElasticTangentConst
+    bool           _IsElasticTangentConst;// true if the tangent of the ELASTIC qpoints(see MateQpState) is _ElasticC
+    vector<SplineTable1D> _Tables1D;// tabulated functions of one variable (if any)
+    vector<SplineTable2D> _Tables2D;// tabulated functions of two variables (if any)
+
+    void Init(){
+        _IsSetup=false;
+        _Scalars.clear();
+        _I.SetToIdentity();
+        _I4Sym.SetToIdentitySymmetric4();
+        _ElasticC.SetToZeros();
+        _ElasticSymC.SetToZeros();
+        _IsElasticTangentConst=false;
+        _Tables1D.clear();
+        _Tables2D.clear();
+    }
+};
@@ -22,6 +22,7 @@
 #include "Utils/Vector3d.h"
 #include "Utils/RankTwoTensor.h"
 #include "Utils/RankFourTensor.h"
+#include "Utils/SymRankFourTensor.h"
 
 using namespace std;
 //*******************************************
@@ -36,4 +37,8 @@ struct Materials{
     VectorMateType VectorMaterials;
     Rank2MateType Rank2Materials;
     Rank4MateType Rank4Materials;
+    // Rank4Materials["jacobian"] in the 6x6 Mandel storage, it is only given(HasSymTangent=true) by
+    // the materials whose tangent has the minor symmetry, the mechanics kernels contract it directly
+    SymRankFourTensor SymTangent;
+    bool HasSymTangent=false;
 };
\ No newline at end of file
@@ -20,7 +20,7 @@
 class MechanicsMaterialBase: public BulkMaterialBase{
 public:
     virtual void ComputeStrain(const int &nDim,const vector<Vector3d> &GradDisp,RankTwoTensor &Strain)=0;
-    virtual void ComputeStressAndJacobian(const vector<double> &InputParams,const RankTwoTensor &Strain,
+    virtual void ComputeStressAndJacobian(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &Strain,
                                           RankTwoTensor &Stress,RankFourTensor &Jacobian)=0;
 
 
@@ -24,6 +24,8 @@
 
 class MieheFractureMaterial:public PhaseFieldFractureMaterialBase{
 public:
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
     virtual void InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
                                         const vector<double> &gpU,const vector<double> &gpUdot,
                                         const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
@@ -31,24 +33,30 @@ public:
 
     virtual void ComputeMaterialProperties(const double &t, const double &dt,const int &nDim, const Vector3d &gpCoord,
                                            const vector<double> &InputParams,
-                                           const vector<double> &gpU,const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                            const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
                                            const Materials &MateOld, Materials &Mate) override;
 
+    virtual void ComputeMaterialPropertiesBatch(const double &t,const double &dt,const int &nDim,
+                                                const vector<double> &InputParams,const MateConstants &Consts,
+                                                BulkMateBatch &Batch) override;
+
 private:
     virtual void ComputeStrain(const int &nDim, const vector<Vector3d> &GradDisp,RankTwoTensor &strain) override;
 
-    virtual void ComputeConstitutiveLaws(const vector<double> &InputParams,const RankTwoTensor &strain,const double &damage,
+    virtual void ComputeConstitutiveLaws(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &strain,const double &damage,
                                          const Materials &MateOld, Materials &Mate) override;
 
     virtual double DegradationFun(const double &x) override;
     virtual double DegradationFunDeriv(const double &x) override;
 
 private:
-    RankTwoTensor I,StressPos,StressNeg,DevStress,GradU;
+    RankTwoTensor StressPos,StressNeg,DevStress,GradU;
     RankTwoTensor Strain,EpsPos,EpsNeg;
-    RankFourTensor I4Sym,ProjPos,ProjNeg;
+    RankTwoTensor EigVec,Ma;
+    double EigVal[3];
+    RankFourTensor ProjPos,ProjNeg;
 
 };
\ No newline at end of file
@@ -23,7 +23,7 @@
 class PhaseFieldFractureMaterialBase: public BulkMaterialBase{
 protected:
     virtual void ComputeStrain(const int &nDim,const vector<Vector3d> &GradDisp,RankTwoTensor &Strain)=0;
-    virtual void ComputeConstitutiveLaws(const vector<double> &InputParams,const RankTwoTensor &strain,const double &damage,
+    virtual void ComputeConstitutiveLaws(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &strain,const double &damage,
                                          const Materials &MateOld, Materials &Mate)=0;
     virtual double DegradationFun(const double &x)=0;
     virtual double DegradationFunDeriv(const double &x)=0;
@@ -18,6 +18,8 @@
 
 class Plastic1DMaterial:public PlasticMaterialBase{
 public:
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
     virtual void InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                         const vector<double> &InputParams,
                                         const vector<double> &gpU, const vector<double> &gpUdot,
@@ -27,7 +29,7 @@ public:
     virtual void ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                            const Vector3d &gpCoord,
                                            const vector<double> &InputParams,
-                                           const vector<double> &gpU, const vector<double> &gpUOld,
+                                           const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                            const vector<double> &gpUdot,
                                            const vector<double> &gpUdotOld,
                                            const vector<Vector3d> &gpGradU,
@@ -52,7 +54,7 @@ private:
         }
     }
 private:
-    RankTwoTensor _GradU,_Stress,_Strain,_I,_devStress;
+    RankTwoTensor _GradU,_Stress,_Strain,_devStress;
     RankFourTensor _Jac;
     double _E,_PlasticStrainOld,_TrialStrain,_TrialStress;
     double _F,_DeltaGamma;
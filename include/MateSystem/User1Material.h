@@ -0,0 +1,61 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Implement the User-Defined-Material (UMAT) 1, only
+//+++          the stress is written(as a template), the
+//+++          consistent tangent is obtained by the automatic
+//+++          differentiation. The example is a nonlinear elastic
+//+++          material with the shear stiffening:
+//+++            sigma=K*tr(eps)*I+2*mu*(1+alpha*e:e)*e, e=dev(eps)
+//+++          parameters: E, nu, alpha(0 for linear elastic)
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+#pragma once
+
+#include "MateSystem/MechanicsMaterialBase.h"
+#include "Utils/AutoDiff.h"
+
+class User1Material: public MechanicsMaterialBase{
+public:
+    virtual void SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts) override;
+
+    virtual void InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
+                                        const vector<double> &gpU,const vector<double> &gpUdot,
+                                        const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
+                                        Materials &Mate) override;
+
+    virtual void ComputeMaterialProperties(const double &t, const double &dt,const int &nDim,
+                                           const Vector3d &gpCoord,const vector<double> &InputParams,
+                                           const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
+                                           const vector<double> &gpUdot,const vector<double> &gpUdotOld,
+                                           const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
+                                           const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
+                                           const Materials &MateOld, Materials &Mate) override;
+
+private:
+    virtual void ComputeStrain(const int &nDim,const vector<Vector3d> &GradDisp, RankTwoTensor &Strain) override;
+    virtual void ComputeStressAndJacobian(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &Strain,RankTwoTensor &Stress,RankFourTensor &Jacobian) override;
+
+    //*** the stress is the only thing users need to write, T is double or the dual number
+    template<typename T>
+    RankTwoTensorT<T> ComputeUserStress(const MateConstants &Consts,const RankTwoTensorT<T> &strain) const{
+        const double K=Consts._Scalars[0];
+        const double mu=Consts._Scalars[1];
+        const double alpha=Consts._Scalars[2];
+        RankTwoTensorT<T> I,e;
+        I.SetToIdentity();
+        e=strain.Dev();
+        return I*(K*strain.Trace())+e*(2.0*mu*(1.0+alpha*e.DoubleDot(e)));
+    }
+
+private:
+    RankTwoTensor _GradU,_Strain,_Stress,_devStress;
+    RankFourTensor _Jac;
+};
@@ -43,6 +43,8 @@ public:
     LagrangeMesh();
 
     bool CreateLagrangeMesh();
+    // collect the mesh types of the bulk elements, it should be called once the mesh is created or imported
+    void CreateBulkMeshTypeList();
     void SaveLagrangeMesh(string inputfilename="") const;
     //************************************************************
     //*** for the basic settings
@@ -132,6 +134,10 @@ public:
     inline int GetBulkMeshOrder()const{return _nOrder;}
     //*** for mesh type
     inline MeshType GetBulkMeshBulkElmtType()const{return _BulkMeshType;}
+    // for the mixed mesh(i.e. quad4+tri3), each bulk element has its own mesh type
+    inline MeshType GetBulkMeshIthBulkElmtMeshType(const int &i)const{return _ElmtMeshTypeList[i+_nElmts-_nBulkElmts-1];}
+    inline int GetBulkMeshBulkElmtTypesNum()const{return static_cast<int>(_BulkMeshTypeList.size());}
+    inline const vector<MeshType>& GetBulkMeshBulkElmtTypeList()const{return _BulkMeshTypeList;}
     inline MeshType GetBulkMeshSurfaceElmtType()const{return _SurfaceMeshType;}
     inline MeshType GetBulkMeshLineElmtType()const{return _LineMeshType;}
     inline string   GetBulkMeshBulkElmtTypeName()const{return _BulkMeshTypeName;}
@@ -178,6 +184,7 @@ public:
     inline int  GetBulkMeshIthElmtPhyID(const int &i)const{return _ElmtPhyIDList[i-1];}
 
     inline int  GetBulkMeshIthElmtVTKCellType(const int &i)const{return _ElmtVTKCellTypeList[i-1];}
+    inline MeshType GetBulkMeshIthElmtMeshType(const int &i)const{return _ElmtMeshTypeList[i-1];}
     inline int  GetBulkMeshIthBulkElmtVTKCellType(const int &i)const{return _ElmtVTKCellTypeList[i+_nElmts-_nBulkElmts-1];}
     
     inline int  GetBulkMeshIthElmtNodesNum(const int &i)const{return _ElmtConn[i-1][0];}
@@ -339,6 +346,7 @@ protected:
     vector<int>         _ElmtPhyIDList;
     vector<int>         _ElmtDimList;
     vector<MeshType>    _ElmtMeshTypeList;
+    vector<MeshType>    _BulkMeshTypeList;// the unique mesh types of the bulk elements
     int                 _BulkElmtVTKCellType;
     string              _BulkMeshTypeName;
     double              _TotalVolume;
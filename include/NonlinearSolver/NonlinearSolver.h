@@ -36,7 +36,10 @@
 #include "FE/FE.h"
 #include "FESystem/FESystem.h"
 #include "EquationSystem/EquationSystem.h"
+#include "OutputSystem/OutputSystem.h"
+#include "Postprocess/Postprocess.h"
 #include "NonlinearSolver/NonlinearSolverBlock.h"
+#include "NonlinearSolver/SNESMixingOptions.h"
 #include "FEProblem/FEControlInfo.h"
 
 
@@ -65,6 +68,7 @@ typedef struct{
 } MonitorCtx;
 
 extern PetscErrorCode MyMonitor(SNES snes,PetscInt iters,PetscReal rnorm,void* ctx);
+extern PetscErrorCode Monitor(SNES snes,PetscInt iters,PetscReal rnorm,void* ctx);
 extern PetscErrorCode MyConvergent(SNES snes,PetscInt iters,PetscReal xnorm,PetscReal snorm,PetscReal fnorm,SNESConvergedReason *reason, void *cctx);
 
 //************************************************************************
@@ -86,6 +90,19 @@ public:
             SolutionSystem &solutionSystem,EquationSystem &equationSystem,
             FE &fe,FESystem &feSystem,
             FEControlInfo &fectrlinfo);
+    //*** for the static load stepping, the loads(bcs) are ramped by the load factor
+    void SetLoadSteppingOption(const int &nsteps,const bool &arclength,const int &maxcutbacks){
+        _nLoadSteps=nsteps;_UseArcLength=arclength;_MaxCutbacks=maxcutbacks;
+    }
+    inline bool IsLoadSteppingEnabled()const{return _nLoadSteps>1||_UseArcLength;}
+    bool SolveLoadSteps(Mesh &mesh,DofHandler &dofHandler,
+            ElmtSystem &elmtSystem,MateSystem &mateSystem,
+            BCSystem &bcSystem,ICSystem &icSystem,
+            SolutionSystem &solutionSystem,EquationSystem &equationSystem,
+            FE &fe,FESystem &feSystem,
+            OutputSystem &outputSystem,
+            Postprocess &postprocessSystem,
+            FEControlInfo &fectrlinfo);
 
     void ReleaseMem();
 
@@ -105,6 +122,9 @@ private:
     NonlinearSolverType _SolverType;
     string _LinearSolverName,_SolverTypeName;
     string _PCTypeName;
+    bool _UseNewtonNPC;// for anderson and ngmres, see NonlinearSolverBlock
+    int _Depth;
+    double _Damping;
 
     //*********************************************
     //*** For nonlinear solver's related components
@@ -117,4 +137,24 @@ private:
     AppCtx _appctx;
     MonitorCtx _monctx;
 
+private:
+    //*********************************************
+    //*** For the static load stepping
+    //*********************************************
+    // the load factor increment of one load(or arc-length) step, it returns false if the step is failed
+    bool SolveLoadControlStep(const double &lambda,const double &dlambda,Vec &Un);
+    bool SolveArcLengthStep(const double &lambda,const double &dl,Vec &Un,Vec &dUprev,double &dlambda);
+    // Ut=dU/dlambda at the converged state(lambda,U), the dirichlet dofs follow G
+    void ComputeLoadTangent(const double &lambda,Vec &U,Vec &Ut);
+    // q=dR/dlambda at (lambda,U), R is the residual of (lambda,U), U is not changed
+    void ComputeLoadDerivative(const double &lambda,Vec &U,const Vec &R,Vec &q);
+    double GetLoadStepResidualNorm(const double &lambda,Vec &U,Vec &R);
+
+    int _nLoadSteps=1;      // the initial load increment is 1/_nLoadSteps
+    bool _UseArcLength=false;// the cylindrical arc-length(Crisfield) instead of the load control
+    int _MaxCutbacks=5;     // the max successive cutbacks of the increment
+    int _LoadStepIters=0;   // the iterations of the last load step
+    Vec _LoadG;             // the dirichlet values of the unit load factor
+    Vec _LoadWork[6];       // the work vectors of the load stepping
+
 };
\ No newline at end of file
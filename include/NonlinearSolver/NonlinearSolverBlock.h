@@ -34,6 +34,9 @@ public:
         _STol=1.0e-16; // |dx|<|x|*stol
         _PCTypeName="lu";
         _LinearSolverName="petsc";
+        _UseNewtonNPC=false;
+        _Depth=-1;
+        _Damping=-1.0;
     }
 
     string              _SolverTypeName;
@@ -44,6 +47,11 @@ public:
 
     string _PCTypeName;
 
+    //*** for anderson and ngmres, <0 means the PETSc default
+    bool   _UseNewtonNPC;// one newton step is the nonlinear preconditioner
+    int    _Depth;       // the number of the previous iterates used by the mixing
+    double _Damping;     // the damping(mixing) factor
+
     void Init(){
         _SolverTypeName="newton with line search";
         _SolverType=NonlinearSolverType::NEWTONLS;
@@ -53,5 +61,8 @@ public:
         _STol=1.0e-16; // |dx|<|x|*stol
         _PCTypeName="lu";
         _LinearSolverName="petsc";
+        _UseNewtonNPC=false;
+        _Depth=-1;
+        _Damping=-1.0;
     }
 };
\ No newline at end of file
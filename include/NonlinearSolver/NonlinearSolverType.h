@@ -22,5 +22,6 @@ enum class NonlinearSolverType{
     NEWTONGMRES,
     BFGS,
     BROYDEN,
-    BADBROYDEN
+    BADBROYDEN,
+    ANDERSON
 };
\ No newline at end of file
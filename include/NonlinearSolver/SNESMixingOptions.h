@@ -0,0 +1,35 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the settings of the anderson and ngmres solvers, they
+//+++          are shared by NonlinearSolver and TimeStepping, so the
+//+++          static and the transient analysis use the same ones
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include "petsc.h"
+
+#include "NonlinearSolver/NonlinearSolverType.h"
+
+// true for the solvers which mix the previous iterates(anderson and ngmres)
+inline bool IsSNESMixingType(const NonlinearSolverType &solvertype){
+    return solvertype==NonlinearSolverType::ANDERSON||solvertype==NonlinearSolverType::NEWTONGMRES;
+}
+
+//****************************************************************
+//*** set the type, depth and damping of snes, the newton step of the
+//*** nonlinear preconditioner(if used) shares ksp, the configured
+//*** linear solver. depth<=0 and damping<=0 mean the PETSc default
+//****************************************************************
+void SetSNESMixingOptions(SNES &snes,KSP &ksp,const NonlinearSolverType &solvertype,
+                          const bool &useNewtonNPC,const int &depth,const double &damping,
+                          const double &rabstol,const double &rreltol,const double &stol);
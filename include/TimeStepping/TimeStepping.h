@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "Utils/MessagePrinter.h"
 
@@ -39,6 +40,7 @@
 #include "Postprocess/Postprocess.h"
 
 #include "NonlinearSolver/NonlinearSolverBlock.h"
+#include "NonlinearSolver/SNESMixingOptions.h"
 
 #include "TimeStepping/TimeSteppingBlock.h"
 #include "TimeStepping/TimeSteppingType.h"
@@ -80,14 +82,22 @@ typedef struct{
     double CutbackFactor;
     double DtMin;
     double DtMax;
+    //**************************
+    bool IsLinearImplicit;// the implicit jacobian only depends on the shift(dt), see 'imex=linear'
+    PetscReal LinearShift;// the shift of the assembled implicit jacobian, <0 means no one
 } TSAppCtx;
 
 //************************************************************************
 //*** subroutines for the calculation of Residual and Jacobian
 extern PetscErrorCode ComputeIResidual(TS ts,PetscReal t,Vec U,Vec V,Vec RHS,void *ctx);
 extern PetscErrorCode ComputeIJacobian(TS ts,PetscReal t,Vec U,Vec V,PetscReal s,Mat A,Mat B,void *ctx);
+//*** for the second order system M*Uddot+R(U,Udot)=0, the mass part M is assembled once, see FESystem::FormBulkMass
+extern PetscErrorCode ComputeI2Residual(TS ts,PetscReal t,Vec U,Vec V,Vec A,Vec RHS,void *ctx);
+extern PetscErrorCode ComputeI2Jacobian(TS ts,PetscReal t,Vec U,Vec V,Vec A,PetscReal shiftV,PetscReal shiftA,Mat J,Mat P,void *ctx);
 extern PetscErrorCode MyTSMonitor(TS ts,PetscInt step,PetscReal time,Vec U,void *ctx);
 extern PetscErrorCode MySNESMonitor(SNES snes,PetscInt iters,PetscReal rnorm,void* ctx);
+//*** the explicit part(rhs function) of the IMEX time stepping
+extern PetscErrorCode ComputeExplicitRHS(TS ts,PetscReal t,Vec U,Vec RHS,void *ctx);
 //************************************************************************
 
 class TimeStepping{
@@ -112,6 +122,27 @@ public:
     void ReleaseMem();
 
     void PrintTimeSteppingInfo()const;
+
+    // true for alpha2 and newmark, they solve M*Uddot+R(U,Udot)=0 by TS2
+    inline bool IsSecondOrder()const{
+        return _TimeSteppingType==TimeSteppingType::ALPHA2||_TimeSteppingType==TimeSteppingType::NEWMARK;
+    }
+    // true if the slow dofs are stepped with dt*subcycles, while the others are subcycled with dt
+    inline bool IsMultirate()const{return _nSubcycles>1&&!_SlowDofNameList.empty();}
+private:
+    // the ksp, pc and snes settings of the TS solver, they are also used by the multirate sub step solvers
+    void SetSNESOptions(SNES &snes,KSP &ksp,PC &pc);
+    //*****************************************************************
+    //*** for the multirate time stepping, each macro step(dt*subcycles)
+    //*** solves the slow dofs once with the fast ones frozen, then the
+    //*** fast dofs are subcycled with dt, the slow ones are interpolated
+    //*****************************************************************
+    bool SolveMultirate();
+    bool SolveMultirateSubStep(const double &t,const double &dt,const int &group);
+    void MultirateMonitor(const int &step,const double &time,const double &dt);
+    // backward euler residual and jacobian of the active dofs, the frozen ones are kept in Unew
+    static PetscErrorCode ComputeMultirateResidual(SNES snes,Vec U,Vec RHS,void *ctx);
+    static PetscErrorCode ComputeMultirateJacobian(SNES snes,Vec U,Mat A,Mat B,void *ctx);
 private:
     //*****************************************************************
     //*** basic variables for time stepping
@@ -127,6 +158,9 @@ private:
     double _GrowthFactor=1.1,_CutBackFactor=0.85;
     int _OptIters;
     double _DtMin,_DtMax;
+    double _RhoInf;
+    vector<string> _SlowDofNameList;
+    int _nSubcycles=1;
 
 private:
     //*****************************************************************
@@ -142,6 +176,9 @@ private:
     bool _IsConvergent;
     NonlinearSolverType _SolverType;
     string _PCTypeName;
+    bool _UseNewtonNPC=false;// for anderson and ngmres, see NonlinearSolverBlock
+    int _Depth=-1;
+    double _Damping=-1.0;
     //*****************************************************************
     //*** for TS components from PETSc
     //*****************************************************************
@@ -151,5 +188,15 @@ private:
     KSP _ksp;
     PC _pc;
     SNESConvergedReason _snesreason;
+    Vec _U2dot;// the velocity of the second order system, it is given to TS2SetSolution
+    bool _IsU2dotCreated=false;
+    //*** for the multirate stepping
+    IS _SlowDofsIS,_FastDofsIS;
+    IS _ActiveDofsIS;  // one of the above two, for the current sub step
+    vector<bool> _IsFrozenDof[2];// the frozen dofs(per node) of the slow(0) and the fast(1) sub step
+    SNES _MRSnes[2];   // the solver of each group, see SetSNESOptions
+    Mat _MRA[2];       // the jacobian of each group, it is the sub matrix of AMATRIX
+    Vec _MRU[2],_MRF[2];// the solution and the residual of each group
+    double _MRTime,_MRDt;// the end time and the dt of the current sub step
     TSAppCtx _appctx;
 };
\ No newline at end of file
@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "TimeStepping/TimeSteppingType.h"
 
@@ -38,6 +39,9 @@ public:
     double _FinalT=1.0e-3;
     double _DtMin=1.0e-12;
     double _DtMax=1.0e2;
+    double _RhoInf=-1.0;// the spectral radius of alpha2, <0 means the PETSc default
+    vector<string> _SlowDofNameList;// the slow dofs of the multirate stepping, their dt is dt*subcycles
+    int _nSubcycles=1;
 
     void Init(){
         _TimeSteppingType=TimeSteppingType::BACKWARDEULER;
@@ -50,5 +54,8 @@ public:
         _DtMin=1.0e-12;
         _DtMax=1.0e2;
         _FinalT=1.0e-3;
+        _RhoInf=-1.0;
+        _SlowDofNameList.clear();
+        _nSubcycles=1;
     }
 };
\ No newline at end of file
@@ -19,5 +19,8 @@ enum class TimeSteppingType{
     CRANCKNICLSON,
     ALPHA,
     GL,
-    ROSW
+    ROSW,
+    ALPHA2, // second order(M*Uddot+...), generalized-alpha
+    NEWMARK,// second order, TSALPHA2 with the newmark parameters
+    ARKIMEX // the IMEX runge-kutta, the 'imex=explicit' blocks are explicit
 };
\ No newline at end of file
@@ -0,0 +1,155 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Some helper functions for the automatic
+//+++          differentiation, the user only writes the stress
+//+++          (or the residual) as a template, and the consistent
+//+++          tangent(or the K matrix) is derived from it:
+//+++           1) ADComputeSymStressAndJacobian: sigma(eps), eps is
+//+++              symmetric, 6 independent variables
+//+++           2) ADComputeStressAndJacobian: P(F), 9 variables
+//+++           3) ADComputeElmtResidual/ADComputeElmtJacobian: the
+//+++              local residual and K of the user element
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "Utils/Vector3d.h"
+#include "Utils/RankTwoTensor.h"
+#include "Utils/RankFourTensor.h"
+#include "Utils/VectorXd.h"
+#include "Utils/MatrixXd.h"
+#include "Utils/DualNumber.h"
+#include "Utils/TensorT.h"
+
+using namespace std;
+
+typedef DualNumber<6> ADSymReal;// for the symmetric tensor, i.e. small strain
+typedef DualNumber<9> ADReal;   // for the full tensor, i.e. deformation gradient
+typedef DualNumber<1> ADDirReal;// for the directional derivative, i.e. K_IJ of one trial function
+
+//****************************************************************************
+//*** StressFun(const RankTwoTensorT<ADSymReal> &strain)->RankTwoTensorT<ADSymReal>
+//*** the 6 components(11,22,33,23,13,12) of strain are the independent variables,
+//*** since eps_23 and eps_32 share the same variable, the shear derivative is halved
+//****************************************************************************
+template<typename StressFun>
+inline void ADComputeSymStressAndJacobian(const RankTwoTensor &Strain,StressFun stressfun,
+                                          RankTwoTensor &Stress,RankFourTensor &Jacobian){
+    const int VoigtI[3][3]={{1,6,5},{6,2,4},{5,4,3}};
+    RankTwoTensorT<ADSymReal> strain;
+    int i,j,k,l;
+    for(i=1;i<=3;i++){
+        for(j=1;j<=3;j++){
+            strain(i,j)=ADSymReal(Strain(i,j),VoigtI[i-1][j-1]);
+        }
+    }
+    RankTwoTensorT<ADSymReal> stress=stressfun(strain);
+    for(i=1;i<=3;i++){
+        for(j=1;j<=3;j++){
+            Stress(i,j)=stress(i,j).Value();
+            for(k=1;k<=3;k++){
+                for(l=1;l<=3;l++){
+                    Jacobian(i,j,k,l)=stress(i,j).Der(VoigtI[k-1][l-1])*((k==l)?1.0:0.5);
+                }
+            }
+        }
+    }
+}
+//****************************************************************************
+//*** StressFun(const RankTwoTensorT<ADReal> &F)->RankTwoTensorT<ADReal>
+//*** all the 9 components are independent, Jacobian_ijkl=dStress_ij/dF_kl
+//****************************************************************************
+template<typename StressFun>
+inline void ADComputeStressAndJacobian(const RankTwoTensor &F,StressFun stressfun,
+                                       RankTwoTensor &Stress,RankFourTensor &Jacobian){
+    RankTwoTensorT<ADReal> f;
+    int i,j,k,l;
+    for(i=1;i<=3;i++){
+        for(j=1;j<=3;j++){
+            f(i,j)=ADReal(F(i,j),(i-1)*3+j);
+        }
+    }
+    RankTwoTensorT<ADReal> stress=stressfun(f);
+    for(i=1;i<=3;i++){
+        for(j=1;j<=3;j++){
+            Stress(i,j)=stress(i,j).Value();
+            for(k=1;k<=3;k++){
+                for(l=1;l<=3;l++){
+                    Jacobian(i,j,k,l)=stress(i,j).Der((k-1)*3+l);
+                }
+            }
+        }
+    }
+}
+
+//****************************************************************************
+//*** for the user element, ResidualFun is a generic lambda(or a template):
+//***   ResidualFun(const vector<T> &U,const vector<T> &V,
+//***               const vector<Vector3dT<T>> &GradU,const vector<Vector3dT<T>> &GradV,
+//***               vector<T> &R)
+//*** the dofs index starts from 1, same as gpU, and R(1~nDofs) is the residual of
+//*** the current test function. The residual is evaluated with T=double, the jacobian
+//*** with T=ADDirReal, where U,V and their gradients are seeded along the trial
+//*** function of the J-th dof, so R_I'=dR_I/dU_J*ctan[0]+dR_I/dV_J*ctan[1]=K_IJ.
+//*** Only the explicit dependence is differentiated, the material properties are
+//*** constants here, the ones depending on U should be computed inside ResidualFun
+//****************************************************************************
+template<typename ResidualFun>
+inline void ADComputeElmtResidual(const int &nDofs,
+                                  const vector<double> &gpU,const vector<double> &gpV,
+                                  const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradV,
+                                  ResidualFun residualfun,VectorXd &localR){
+    vector<Vector3dT<double>> gradu(nDofs+1),gradv(nDofs+1);
+    vector<double> r(nDofs+1,0.0);
+    for(int I=1;I<=nDofs;I++){
+        gradu[I]=gpGradU[I];
+        gradv[I]=gpGradV[I];
+    }
+    residualfun(gpU,gpV,gradu,gradv,r);
+    for(int I=1;I<=nDofs;I++) localR(I)=r[I];
+}
+//****************************************************************************
+template<typename ResidualFun>
+inline void ADComputeElmtJacobian(const int &nDofs,const double (&ctan)[2],
+                                  const vector<double> &gpU,const vector<double> &gpV,
+                                  const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradV,
+                                  const double &trial,const Vector3d &grad_trial,
+                                  ResidualFun residualfun,MatrixXd &localK){
+    vector<ADDirReal> u(nDofs+1),v(nDofs+1),r(nDofs+1);
+    vector<Vector3dT<ADDirReal>> gradu(nDofs+1),gradv(nDofs+1);
+    int I,J,k;
+    for(I=1;I<=nDofs;I++){
+        u[I]=gpU[I];v[I]=gpV[I];
+        gradu[I]=gpGradU[I];gradv[I]=gpGradV[I];
+    }
+    for(J=1;J<=nDofs;J++){
+        // seed the J-th dof along the trial function
+        u[J].Der(1)=trial*ctan[0];
+        v[J].Der(1)=trial*ctan[1];
+        for(k=1;k<=3;k++){
+            gradu[J](k).Der(1)=grad_trial(k)*ctan[0];
+            gradv[J](k).Der(1)=grad_trial(k)*ctan[1];
+        }
+        for(I=1;I<=nDofs;I++) r[I]=0.0;
+        residualfun(u,v,gradu,gradv,r);
+        for(I=1;I<=nDofs;I++) localK(I,J)=r[I].Der(1);
+        // clear the seed for the next dof
+        u[J].Der(1)=0.0;v[J].Der(1)=0.0;
+        for(k=1;k<=3;k++){
+            gradu[J](k).Der(1)=0.0;
+            gradv[J](k).Der(1)=0.0;
+        }
+    }
+}
@@ -0,0 +1,202 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Implement the dual number for the forward mode
+//+++          automatic differentiation, a dual number carries
+//+++          its value and the derivatives w.r.t. N independent
+//+++          variables:  a=val+sum(der_i*eps_i), eps_i*eps_j=0
+//+++          all the derivatives are kept on the stack, so N
+//+++          should be small(i.e. 6 or 9 for strain tensor)
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+
+template<int N>
+class DualNumber{
+public:
+    DualNumber(){
+        _val=0.0;
+        for(int i=0;i<N;++i) _der[i]=0.0;
+    }
+    DualNumber(const double &val){
+        // a constant, all the derivatives are zero
+        _val=val;
+        for(int i=0;i<N;++i) _der[i]=0.0;
+    }
+    DualNumber(const double &val,const int &i){
+        // the i-th independent variable, i starts from 1
+        _val=val;
+        for(int j=0;j<N;++j) _der[j]=0.0;
+        _der[i-1]=1.0;
+    }
+    DualNumber(const DualNumber &a)=default;
+    DualNumber& operator=(const DualNumber &a)=default;
+
+    //*****************************************
+    //*** for the value and derivatives
+    //*****************************************
+    inline double Value()const{return _val;}
+    inline double& Value(){return _val;}
+    inline double Der(const int &i)const{return _der[i-1];}// i starts from 1
+    inline double& Der(const int &i){return _der[i-1];}
+    inline static int GetDerNums(){return N;}
+    inline void Seed(const int &i){
+        for(int j=0;j<N;++j) _der[j]=0.0;
+        _der[i-1]=1.0;
+    }
+
+    //*****************************************
+    //*** for the math operators
+    //*****************************************
+    inline DualNumber& operator=(const double &a){
+        _val=a;
+        for(int i=0;i<N;++i) _der[i]=0.0;
+        return *this;
+    }
+    inline DualNumber operator-()const{
+        DualNumber temp;
+        temp._val=-_val;
+        for(int i=0;i<N;++i) temp._der[i]=-_der[i];
+        return temp;
+    }
+    //*** for +
+    inline DualNumber& operator+=(const DualNumber &a){
+        _val+=a._val;
+        for(int i=0;i<N;++i) _der[i]+=a._der[i];
+        return *this;
+    }
+    inline DualNumber& operator+=(const double &a){
+        _val+=a;
+        return *this;
+    }
+    //*** for -
+    inline DualNumber& operator-=(const DualNumber &a){
+        _val-=a._val;
+        for(int i=0;i<N;++i) _der[i]-=a._der[i];
+        return *this;
+    }
+    inline DualNumber& operator-=(const double &a){
+        _val-=a;
+        return *this;
+    }
+    //*** for *, (ab)'=a'b+ab'
+    inline DualNumber& operator*=(const DualNumber &a){
+        for(int i=0;i<N;++i) _der[i]=_der[i]*a._val+_val*a._der[i];
+        _val*=a._val;
+        return *this;
+    }
+    inline DualNumber& operator*=(const double &a){
+        _val*=a;
+        for(int i=0;i<N;++i) _der[i]*=a;
+        return *this;
+    }
+    //*** for /, (a/b)'=(a'b-ab')/b^2
+    inline DualNumber& operator/=(const DualNumber &a){
+        const double inv=1.0/a._val;
+        _val*=inv;
+        for(int i=0;i<N;++i) _der[i]=(_der[i]-_val*a._der[i])*inv;
+        return *this;
+    }
+    inline DualNumber& operator/=(const double &a){
+        const double inv=1.0/a;
+        _val*=inv;
+        for(int i=0;i<N;++i) _der[i]*=inv;
+        return *this;
+    }
+
+    //*** the binary operators are defined as friends, so double-->DualNumber is allowed on both sides
+    friend inline DualNumber operator+(DualNumber a,const DualNumber &b){return a+=b;}
+    friend inline DualNumber operator+(DualNumber a,const double &b){return a+=b;}
+    friend inline DualNumber operator+(const double &a,DualNumber b){return b+=a;}
+    friend inline DualNumber operator-(DualNumber a,const DualNumber &b){return a-=b;}
+    friend inline DualNumber operator-(DualNumber a,const double &b){return a-=b;}
+    friend inline DualNumber operator-(const double &a,const DualNumber &b){return (-b)+=a;}
+    friend inline DualNumber operator*(DualNumber a,const DualNumber &b){return a*=b;}
+    friend inline DualNumber operator*(DualNumber a,const double &b){return a*=b;}
+    friend inline DualNumber operator*(const double &a,DualNumber b){return b*=a;}
+    friend inline DualNumber operator/(DualNumber a,const DualNumber &b){return a/=b;}
+    friend inline DualNumber operator/(DualNumber a,const double &b){return a/=b;}
+    friend inline DualNumber operator/(const double &a,const DualNumber &b){return DualNumber(a)/=b;}
+
+    //*** the comparison only looks at the value, so the branches(i.e. yield check) work as usual
+    friend inline bool operator< (const DualNumber &a,const DualNumber &b){return a._val< b._val;}
+    friend inline bool operator> (const DualNumber &a,const DualNumber &b){return a._val> b._val;}
+    friend inline bool operator<=(const DualNumber &a,const DualNumber &b){return a._val<=b._val;}
+    friend inline bool operator>=(const DualNumber &a,const DualNumber &b){return a._val>=b._val;}
+    friend inline bool operator==(const DualNumber &a,const DualNumber &b){return a._val==b._val;}
+    friend inline bool operator!=(const DualNumber &a,const DualNumber &b){return a._val!=b._val;}
+
+    friend ostream& operator<<(ostream &os,const DualNumber &a){
+        os<<a._val<<" [";
+        for(int i=0;i<N;++i) os<<" "<<a._der[i];
+        os<<" ]";
+        return os;
+    }
+
+    //*****************************************
+    //*** for the math functions, f(a)'=f'(a)*a'
+    //*****************************************
+    friend inline DualNumber sqrt(const DualNumber &a){
+        return ChainRule(a,std::sqrt(a._val),0.5/std::sqrt(a._val));
+    }
+    friend inline DualNumber exp(const DualNumber &a){
+        const double val=std::exp(a._val);
+        return ChainRule(a,val,val);
+    }
+    friend inline DualNumber log(const DualNumber &a){
+        return ChainRule(a,std::log(a._val),1.0/a._val);
+    }
+    friend inline DualNumber pow(const DualNumber &a,const double &n){
+        return ChainRule(a,std::pow(a._val,n),n*std::pow(a._val,n-1.0));
+    }
+    friend inline DualNumber pow(const DualNumber &a,const DualNumber &b){
+        // a^b=exp(b*log(a))
+        return exp(b*log(a));
+    }
+    friend inline DualNumber abs(const DualNumber &a){
+        return ChainRule(a,std::abs(a._val),(a._val<0.0)?-1.0:1.0);
+    }
+    friend inline DualNumber sin(const DualNumber &a){
+        return ChainRule(a,std::sin(a._val),std::cos(a._val));
+    }
+    friend inline DualNumber cos(const DualNumber &a){
+        return ChainRule(a,std::cos(a._val),-std::sin(a._val));
+    }
+    friend inline DualNumber tanh(const DualNumber &a){
+        const double val=std::tanh(a._val);
+        return ChainRule(a,val,1.0-val*val);
+    }
+
+private:
+    inline static DualNumber ChainRule(const DualNumber &a,const double &val,const double &dval){
+        DualNumber temp;
+        temp._val=val;
+        for(int i=0;i<N;++i) temp._der[i]=dval*a._der[i];
+        return temp;
+    }
+
+private:
+    double _val;
+    double _der[N];
+};
+
+//***************************************************
+//*** get the value of a double or a dual number, so
+//*** the templated code can work with both of them
+//***************************************************
+inline double GetADValue(const double &a){return a;}
+template<int N>
+inline double GetADValue(const DualNumber<N> &a){return a.Value();}
@@ -0,0 +1,137 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Define the vector and matrix for the element local
+//+++          arrays of the bulk element, the storage is reserved once
+//+++          (to the largest element in the mesh) and only the
+//+++          active part(m x n) is used, the active part is
+//+++          stored contiguously(row major), so:
+//+++            1) operator() is 1-based, the same as MatrixXd
+//+++            2) Coeff() and GetDataPtr() are 0-based
+//+++          Resize() only changes the active size, it never
+//+++          allocates memory within the reserved capacity
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Utils/MessagePrinter.h"
+
+using namespace std;
+
+//*******************************************************
+//*** the element local vector, the storage is reserved
+//*** once, Resize() only changes the active size as long
+//*** as it fits the reserved storage
+//*******************************************************
+class ElmtVectorXd{
+public:
+    ElmtVectorXd(){_M=0;}
+    ElmtVectorXd(const int &m){_M=0;Resize(m);setZero();}
+    void Reserve(const int &maxm){
+        if(maxm>static_cast<int>(_vals.size())) _vals.resize(maxm,0.0);
+    }
+    void Resize(const int &m){
+        if(m<0){
+            MessagePrinter::PrintErrorTxt("the size("+to_string(m)+") of ElmtVectorXd is invalid");
+            MessagePrinter::AsFem_Exit();
+        }
+        Reserve(m);// only allocates if the capacity is exceeded
+        _M=m;
+    }
+    void Clean(){_M=0;_vals.clear();}
+    inline int GetM()const{return _M;}
+    inline double* GetDataPtr(){return _vals.data();}
+    inline const double* GetDataPtr()const{return _vals.data();}
+    //*****************************************
+    //*** 1-based access
+    //*****************************************
+    inline double& operator()(const int &i){return _vals[i-1];}
+    inline double operator()(const int &i)const{return _vals[i-1];}
+    //*****************************************
+    //*** 0-based access
+    //*****************************************
+    inline double& Coeff(const int &i){return _vals[i];}
+    inline double Coeff(const int &i)const{return _vals[i];}
+
+    inline void setZero(){
+        for(int i=0;i<_M;++i) _vals[i]=0.0;
+    }
+    inline ElmtVectorXd& operator=(const double &val){
+        for(int i=0;i<_M;++i) _vals[i]=val;
+        return *this;
+    }
+    inline ElmtVectorXd& operator*=(const double &val){
+        for(int i=0;i<_M;++i) _vals[i]*=val;
+        return *this;
+    }
+
+private:
+    vector<double> _vals;
+    int _M;
+};
+
+//*******************************************************
+//*** the element local matrix, the active part is m x n
+//*** and the storage is reserved once, as above
+//*******************************************************
+class ElmtMatrixXd{
+public:
+    ElmtMatrixXd(){_M=0;_N=0;_MN=0;}
+    ElmtMatrixXd(const int &m,const int &n){_M=0;_N=0;_MN=0;Resize(m,n);setZero();}
+    void Reserve(const int &maxm,const int &maxn){
+        if(maxm*maxn>static_cast<int>(_vals.size())) _vals.resize(maxm*maxn,0.0);
+    }
+    void Resize(const int &m,const int &n){
+        if(m<0||n<0){
+            MessagePrinter::PrintErrorTxt("the size("+to_string(m)+"x"+to_string(n)+") of ElmtMatrixXd is invalid");
+            MessagePrinter::AsFem_Exit();
+        }
+        Reserve(m,n);// only allocates if the capacity is exceeded
+        _M=m;_N=n;_MN=m*n;
+    }
+    void Clean(){_M=0;_N=0;_MN=0;_vals.clear();}
+    inline int GetM()const{return _M;}
+    inline int GetN()const{return _N;}
+    inline double* GetDataPtr(){return _vals.data();}
+    inline const double* GetDataPtr()const{return _vals.data();}
+    //*****************************************
+    //*** 1-based access
+    //*****************************************
+    inline double& operator()(const int &i,const int &j){return _vals[(i-1)*_N+j-1];}
+    inline double operator()(const int &i,const int &j)const{return _vals[(i-1)*_N+j-1];}
+    //*****************************************
+    //*** 0-based access
+    //*****************************************
+    inline double& Coeff(const int &i,const int &j){return _vals[i*_N+j];}
+    inline double Coeff(const int &i,const int &j)const{return _vals[i*_N+j];}
+    inline double& Coeff(const int &i){return _vals[i];}
+    inline double Coeff(const int &i)const{return _vals[i];}
+
+    inline void setZero(){
+        for(int i=0;i<_MN;++i) _vals[i]=0.0;
+    }
+    inline ElmtMatrixXd& operator=(const double &val){
+        for(int i=0;i<_MN;++i) _vals[i]=val;
+        return *this;
+    }
+    inline ElmtMatrixXd& operator*=(const double &val){
+        for(int i=0;i<_MN;++i) _vals[i]*=val;
+        return *this;
+    }
+
+private:
+    vector<double> _vals;
+    int _M,_N,_MN;
+};
@@ -28,6 +28,55 @@
 
 using namespace std;
 
+//*******************************************************
+//*** closed form determinant and inverse of the small
+//*** (n<=3) row major matrix, they are used by the
+//*** Det() and Inverse() of MatrixXd
+//*******************************************************
+inline double SmallMatrixDet(const int &n,const double *a){
+    if(n==1){
+        return a[0];
+    }
+    else if(n==2){
+        return a[0]*a[3]-a[1]*a[2];
+    }
+    else if(n==3){
+        return a[0]*(a[4]*a[8]-a[5]*a[7])
+              -a[1]*(a[3]*a[8]-a[5]*a[6])
+              +a[2]*(a[3]*a[7]-a[4]*a[6]);
+    }
+    MessagePrinter::PrintErrorTxt("the closed form determinant only works for 1x1, 2x2 and 3x3 matrix");
+    MessagePrinter::AsFem_Exit();
+    return 0.0;
+}
+// ainv=inverse(a), ainv must not be the same memory as a, the determinant is returned
+inline double SmallMatrixInverse(const int &n,const double *a,double *ainv){
+    const double det=SmallMatrixDet(n,a);
+    if(det==0.0){
+        MessagePrinter::PrintErrorTxt("singular matrix detected in the small matrix inverse");
+        MessagePrinter::AsFem_Exit();
+    }
+    const double invdet=1.0/det;
+    if(n==1){
+        ainv[0]=invdet;
+    }
+    else if(n==2){
+        ainv[0]= a[3]*invdet;ainv[1]=-a[1]*invdet;
+        ainv[2]=-a[2]*invdet;ainv[3]= a[0]*invdet;
+    }
+    else{
+        ainv[0]=(a[4]*a[8]-a[5]*a[7])*invdet;
+        ainv[1]=(a[2]*a[7]-a[1]*a[8])*invdet;
+        ainv[2]=(a[1]*a[5]-a[2]*a[4])*invdet;
+        ainv[3]=(a[5]*a[6]-a[3]*a[8])*invdet;
+        ainv[4]=(a[0]*a[8]-a[2]*a[6])*invdet;
+        ainv[5]=(a[2]*a[3]-a[0]*a[5])*invdet;
+        ainv[6]=(a[3]*a[7]-a[4]*a[6])*invdet;
+        ainv[7]=(a[1]*a[6]-a[0]*a[7])*invdet;
+        ainv[8]=(a[0]*a[4]-a[1]*a[3])*invdet;
+    }
+    return det;
+}
 
 class MatrixXd{
 public:
@@ -230,8 +279,13 @@ public:
         for(int i=0;i<_MN;++i) _vals[i]=static_cast<double>(1.0*rand()/RAND_MAX);
     }
     inline MatrixXd Inverse()const{
-        Eigen::MatrixXd Mat(_M,_N),MatInv(_M,_N);
         MatrixXd temp(_M,_N);
+        if(_M==_N&&_M>=1&&_M<=3){
+            // the closed form for the small matrix, no temporary Eigen matrix is needed
+            SmallMatrixInverse(_M,_vals.data(),temp._vals.data());
+            return temp;
+        }
+        Eigen::MatrixXd Mat(_M,_N),MatInv(_M,_N);
 
         for(int i=1;i<=_M;i++){
             for(int j=1;j<=_N;j++){
@@ -247,6 +301,7 @@ public:
         return temp;
     }
     inline double Det()const{
+        if(_M==_N&&_M>=1&&_M<=3) return SmallMatrixDet(_M,_vals.data());
         Eigen::MatrixXd Mat(_M,_N);
         for(int i=1;i<=_M;i++){
             for(int j=1;j<=_N;j++){
@@ -76,9 +76,14 @@ public:
     inline double& operator[](const int &i){
         return _vals[i-1];
     }
+    inline double GetVoigtComponent(const int &I,const int &J)const{
+        // I,J=1~6, the order is 11,22,33,23,31,12(same as PrintVoigt)
+        const int ii[6]={1,2,3,2,3,1},jj[6]={1,2,3,3,1,2};
+        return (*this)(ii[I-1],jj[I-1],ii[J-1],jj[J-1]);
+    }
     inline double GetIthVoigtComponent(const int &i)const{
-        // TODO: implement efficient voigt access!!!
-        return _vals[i];
+        // i=1~36, the row-major component of the 6x6 Voigt matrix
+        return GetVoigtComponent((i-1)/6+1,(i-1)%6+1);
     }
     //*** for =
     inline RankFourTensor& operator=(const double &a){
@@ -145,6 +150,32 @@ public:
         for(int i=0;i<_N4;++i) _vals[i]=_vals[i]*a;
         return *this;
     }
+    //*******************************************************************
+    //*** in-place fused operations, they write into this tensor directly
+    //*** and avoid the rank-4 temporaries of the operator chain, i.e.
+    //***   C+=s*A       --> C.AddScaled(s,A)
+    //***   C+=s*a.CrossDot(b) --> C.AddScaledCrossDot(s,a,b)
+    //*******************************************************************
+    inline RankFourTensor& AddScaled(const double &s,const RankFourTensor &a){
+        for(int i=0;i<_N4;++i) _vals[i]+=s*a._vals[i];
+        return *this;
+    }
+    inline RankFourTensor& AddScaledIdentitySymmetric4(const double &s){
+        // C_ijkl+=s*0.5*(de_ik*de_jl+de_il*de_jk)
+        for(int i=1;i<=_N;++i){
+            for(int j=1;j<=_N;++j){
+                (*this)(i,j,i,j)+=0.5*s;
+                (*this)(i,j,j,i)+=0.5*s;
+            }
+        }
+        return *this;
+    }
+    // C_ijkl+=s*a_ij*b_kl
+    RankFourTensor& AddScaledCrossDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b);
+    // C_ijkl+=s*a_ik*b_jl
+    RankFourTensor& AddScaledIkJlDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b);
+    // C_ijkl+=s*a_il*b_jk
+    RankFourTensor& AddScaledIlJkDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b);
     //*** for double dot operator
     RankTwoTensor DoubleDot(const RankTwoTensor &a) const;
     inline RankFourTensor DoubleDot(const RankFourTensor &a) const{
@@ -200,6 +200,15 @@ public:
         }
         return temp;
     }
+    //*** in-place fused operation: this+=s*a, without the temporary of a*s
+    inline RankTwoTensor& AddScaled(const double &s,const RankTwoTensor &a){
+        for(int i=0;i<_N2;++i) _vals[i]+=s*a._vals[i];
+        return *this;
+    }
+    inline RankTwoTensor& AddScaledIdentity(const double &s){
+        (*this)(1,1)+=s;(*this)(2,2)+=s;(*this)(3,3)+=s;
+        return *this;
+    }
     //*** for *= operator
     inline RankTwoTensor& operator*=(const double &a) {
         for(int i=0;i<_N2;++i) _vals[i]*=a;
@@ -328,6 +337,11 @@ public:
     //**** For stress and strain decomposition
     //********************************************************
     void CalcEigenValueAndEigenVectors(double (&eigval)[3],RankTwoTensor &eigvec) const;
+    // for symmetric tensor only(strain, stress), eigen values are sorted in ascending order
+    void CalcSymmetricEigenValueAndEigenVectors(double (&eigval)[3],RankTwoTensor &eigvec) const;
+    // fused positive and negative projection tensor, ProjPos+ProjNeg=I4Sym
+    void CalcPosAndNegProjTensor(double (&eigval)[3],RankTwoTensor &eigvec,
+                                 RankFourTensor &ProjPos,RankFourTensor &ProjNeg) const;
     RankFourTensor CalcPostiveProjTensor(double (&eigval)[3],RankTwoTensor &eigvec) const;
     RankFourTensor GetPostiveProjTensor() const;
     //*******************************************************************
@@ -0,0 +1,112 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Tabulate a scalar function of one(cubic spline) or
+//+++          two(bicubic) variables on a uniform grid, then the
+//+++          function and its first derivatives are evaluated by
+//+++          a table lookup, this is used to replace the expensive
+//+++          free energy(i.e. CALPHAD-like log terms) at qpoints
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+
+//*******************************************************
+//*** 1d cubic spline, f(x)=a+b*t+c*t^2+d*t^3 in each
+//*** interval, where t=x-x_i
+//*******************************************************
+class SplineTable1D{
+public:
+    SplineTable1D();
+    // vals are the function values on the n+1 nodes of [xmin,xmax],
+    // the end slopes are used if IsClamped is true, otherwise the natural spline is used
+    void Build(const int &n,const double &xmin,const double &xmax,const vector<double> &vals,
+               const bool &IsClamped=false,const double &dleft=0.0,const double &dright=0.0);
+
+    inline bool IsBuilt()const{return _n>0;}
+    inline bool IsInRange(const double &x)const{return x>=_xmin&&x<=_xmax;}
+    inline int GetIntervalsNum()const{return _n;}
+
+    // f and df/dx at x, x must be in the range
+    inline void Eval(const double &x,double &f,double &dfdx)const{
+        int i=static_cast<int>((x-_xmin)*_invh);
+        if(i>=_n) i=_n-1;
+        if(i<0) i=0;
+        const double t=x-_xmin-i*_h;
+        const double *c=&_coefs[4*i];
+        f=c[0]+t*(c[1]+t*(c[2]+t*c[3]));
+        dfdx=c[1]+t*(2.0*c[2]+3.0*t*c[3]);
+    }
+    // the derivative of the spline at the i-th node, i=0~n
+    double GetNodeDerivative(const int &i)const;
+
+private:
+    int _n;
+    double _xmin,_xmax,_h,_invh;
+    vector<double> _coefs;// 4 coefficients of each interval
+};
+
+//*******************************************************
+//*** 2d bicubic table, the node derivatives are either
+//*** given or computed by the 1d splines along each direction
+//*******************************************************
+class SplineTable2D{
+public:
+    SplineTable2D();
+    // vals are stored as vals[i+j*(nx+1)], i=0~nx for x and j=0~ny for y,
+    // the node derivatives can be given in the same layout, the empty ones are
+    // estimated by the 1d splines
+    void Build(const int &nx,const int &ny,
+               const double &xmin,const double &xmax,
+               const double &ymin,const double &ymax,
+               const vector<double> &vals,
+               const vector<double> &dvdx=vector<double>(),
+               const vector<double> &dvdy=vector<double>(),
+               const vector<double> &d2vdxdy=vector<double>());
+
+    inline bool IsBuilt()const{return _nx>0&&_ny>0;}
+    inline bool IsInRange(const double &x,const double &y)const{
+        return x>=_xmin&&x<=_xmax&&y>=_ymin&&y<=_ymax;
+    }
+
+    // f, df/dx and df/dy at (x,y), (x,y) must be in the range
+    inline void Eval(const double &x,const double &y,double &f,double &dfdx,double &dfdy)const{
+        int i=static_cast<int>((x-_xmin)*_invhx);
+        int j=static_cast<int>((y-_ymin)*_invhy);
+        if(i>=_nx) i=_nx-1;
+        if(i<0) i=0;
+        if(j>=_ny) j=_ny-1;
+        if(j<0) j=0;
+        const double u=(x-_xmin)*_invhx-i;
+        const double v=(y-_ymin)*_invhy-j;
+        const double *a=&_coefs[16*(i+j*_nx)];
+        double fv[4],dfv[4];
+        // p(u,v)=sum a[p*4+q]*u^p*v^q
+        for(int p=0;p<4;p++){
+            fv[p]=a[4*p]+v*(a[4*p+1]+v*(a[4*p+2]+v*a[4*p+3]));
+            dfv[p]=a[4*p+1]+v*(2.0*a[4*p+2]+3.0*v*a[4*p+3]);
+        }
+        f=fv[0]+u*(fv[1]+u*(fv[2]+u*fv[3]));
+        dfdx=(fv[1]+u*(2.0*fv[2]+3.0*u*fv[3]))*_invhx;
+        dfdy=(dfv[0]+u*(dfv[1]+u*(dfv[2]+u*dfv[3])))*_invhy;
+    }
+
+private:
+    int _nx,_ny;
+    double _xmin,_xmax,_ymin,_ymax;
+    double _hx,_hy,_invhx,_invhy;
+    vector<double> _coefs;// 16 coefficients of each cell
+};
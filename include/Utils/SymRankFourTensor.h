@@ -0,0 +1,180 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Implement the rank-4 tensor with minor symmetry, i.e.
+//+++          C_ijkl=C_jikl=C_ijlk, it is stored as a 6x6 matrix
+//+++          in Mandel notation, the index order is:
+//+++            1->11, 2->22, 3->33, 4->23, 5->13, 6->12
+//+++          and the shear terms are scaled by sqrt(2), so the
+//+++          double dot becomes a plain matrix-vector product
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+#include "petsc.h"
+
+//****************************
+#include "Utils/MessagePrinter.h"
+#include "Utils/Vector3d.h"
+#include "Utils/RankTwoTensor.h"
+#include "Utils/RankFourTensor.h"
+
+using namespace std;
+
+class SymRankFourTensor{
+public:
+    SymRankFourTensor();
+    SymRankFourTensor(const double &val);
+    SymRankFourTensor(const SymRankFourTensor &a);
+    SymRankFourTensor(const RankFourTensor &a);
+
+    //********************************************
+    //*** For the index mapping
+    //********************************************
+    inline static int VoigtIndex(const int &i,const int &j){
+        // (i,j)-->Mandel index, i,j start from 1
+        if(i==j) return i;
+        return 9-i-j;// (2,3)->4, (1,3)->5, (1,2)->6
+    }
+    inline static void GetIndexPair(const int &I,int &i,int &j){
+        // Mandel index-->(i,j), the inverse of VoigtIndex
+        const int ii[6]={1,2,3,2,1,1},jj[6]={1,2,3,3,3,2};
+        i=ii[I-1];j=jj[I-1];
+    }
+    inline static double MandelFactor(const int &I){
+        return (I<=3)?1.0:sqrt(2.0);
+    }
+    //********************************************
+    //*** For operator overload
+    //********************************************
+    // Mandel component based access, I,J=1~6
+    inline double operator()(const int &I,const int &J) const{
+        return _vals[(I-1)*6+J-1];
+    }
+    inline double& operator()(const int &I,const int &J){
+        return _vals[(I-1)*6+J-1];
+    }
+    // tensor component based access, return C_ijkl
+    inline double operator()(const int &i,const int &j,const int &k,const int &l) const{
+        const int I=VoigtIndex(i,j),J=VoigtIndex(k,l);
+        return _vals[(I-1)*6+J-1]/(MandelFactor(I)*MandelFactor(J));
+    }
+    inline double GetIKjlComponent(const int &i,const int &k,
+                                   const Vector3d &grad_test,
+                                   const Vector3d &grad_phi)const{
+        // K_ik=C_ijkl*N,j*N,l, same as the one in RankFourTensor, but only the
+        // 3 Mandel rows/cols which contain i(and k) are touched
+        double sum=0.0,val;
+        int I,J;
+        for(int j=1;j<=3;++j){
+            I=VoigtIndex(i,j);
+            val=0.0;
+            for(int l=1;l<=3;++l){
+                J=VoigtIndex(k,l);
+                val+=_vals[(I-1)*6+J-1]*_InvW[J-1]*grad_phi(l);
+            }
+            sum+=val*_InvW[I-1]*grad_test(j);
+        }
+        return sum;
+    }
+    //*** for =
+    inline SymRankFourTensor& operator=(const double &a){
+        for(int i=0;i<_N2;++i) _vals[i]=a;
+        return *this;
+    }
+    inline SymRankFourTensor& operator=(const SymRankFourTensor &a){
+        for(int i=0;i<_N2;++i) _vals[i]=a._vals[i];
+        return *this;
+    }
+    SymRankFourTensor& operator=(const RankFourTensor &a);
+    //*** for +
+    inline SymRankFourTensor operator+(const SymRankFourTensor &a) const{
+        SymRankFourTensor temp(0.0);
+        for(int i=0;i<_N2;++i) temp._vals[i]=_vals[i]+a._vals[i];
+        return temp;
+    }
+    inline SymRankFourTensor& operator+=(const SymRankFourTensor &a){
+        for(int i=0;i<_N2;++i) _vals[i]+=a._vals[i];
+        return *this;
+    }
+    //*** for -
+    inline SymRankFourTensor operator-(const SymRankFourTensor &a) const{
+        SymRankFourTensor temp(0.0);
+        for(int i=0;i<_N2;++i) temp._vals[i]=_vals[i]-a._vals[i];
+        return temp;
+    }
+    inline SymRankFourTensor& operator-=(const SymRankFourTensor &a){
+        for(int i=0;i<_N2;++i) _vals[i]-=a._vals[i];
+        return *this;
+    }
+    //*** for *
+    inline SymRankFourTensor operator*(const double &a) const{
+        SymRankFourTensor temp(0.0);
+        for(int i=0;i<_N2;++i) temp._vals[i]=_vals[i]*a;
+        return temp;
+    }
+    friend SymRankFourTensor operator*(const double &lhs,const SymRankFourTensor &a);
+    inline SymRankFourTensor& operator*=(const double &a){
+        for(int i=0;i<_N2;++i) _vals[i]*=a;
+        return *this;
+    }
+    //*** the in place update, see the same ones of RankFourTensor
+    inline SymRankFourTensor& AddScaled(const double &s,const SymRankFourTensor &a){
+        for(int i=0;i<_N2;++i) _vals[i]+=s*a._vals[i];
+        return *this;
+    }
+    inline SymRankFourTensor& AddScaledIdentitySymmetric4(const double &s){
+        // I4Sym is the 6x6 identity matrix
+        for(int I=0;I<_N;++I) _vals[I*6+I]+=s;
+        return *this;
+    }
+    // C_ijkl+=s*a_ij*b_kl, a and b are symmetric
+    SymRankFourTensor& AddScaledCrossDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b);
+    //*** for double dot operator
+    // C_ijkl:B_lk, B is assumed to be symmetric(strain or stress)
+    RankTwoTensor DoubleDot(const RankTwoTensor &a) const;
+    // C_ijmn*B_nmkl, which is just the 6x6 matrix product in Mandel notation
+    SymRankFourTensor DoubleDot(const SymRankFourTensor &a) const;
+    //**********************************************
+    //*** some setting functions
+    //**********************************************
+    inline void SetToZeros(){
+        for(int i=0;i<_N2;++i) _vals[i]=0.0;
+    }
+    inline void SetToIdentitySymmetric4(){
+        // in Mandel notation, I4Sym is the 6x6 identity matrix
+        SetToZeros();
+        for(int I=1;I<=_N;++I) (*this)(I,I)=1.0;
+    }
+    void SetFromLameandG(const double &Lame,const double &G);
+    void SetFromEandNu(const double &E,const double &Nu);
+    void SetFromRankFourTensor(const RankFourTensor &a);
+    RankFourTensor ToRankFourTensor() const;
+    //*****************************************
+    //*** Print the Mandel matrix
+    //*****************************************
+    inline void Print() const{
+        for(int I=1;I<=_N;++I){
+            PetscPrintf(PETSC_COMM_WORLD,"*** %12.5e  %12.5e  %12.5e  %12.5e  %12.5e  %12.5e***\n",
+                        (*this)(I,1),(*this)(I,2),(*this)(I,3),(*this)(I,4),(*this)(I,5),(*this)(I,6));
+        }
+    }
+private:
+    double _vals[36];
+    const int _N=6;
+    const int _N2=36;
+    // 1/MandelFactor(I)
+    static constexpr double _InvW[6]={1.0,1.0,1.0,0.70710678118654752440,0.70710678118654752440,0.70710678118654752440};
+};
@@ -0,0 +1,246 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Implement the templated vector and rank-2 tensor,
+//+++          T can be double or DualNumber<N>, so the stress
+//+++          (or residual) written once with these classes can
+//+++          be differentiated automatically. The interface
+//+++          follows Vector3d and RankTwoTensor, index starts
+//+++          from 1
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <cmath>
+#include <type_traits>
+
+#include "Utils/Vector3d.h"
+#include "Utils/RankTwoTensor.h"
+#include "Utils/DualNumber.h"
+
+using namespace std;
+
+template<typename T>
+class Vector3dT{
+public:
+    Vector3dT(){
+        for(int i=0;i<3;++i) _vals[i]=0.0;
+    }
+    explicit Vector3dT(const double &val){
+        for(int i=0;i<3;++i) _vals[i]=val;
+    }
+    Vector3dT(const Vector3d &a){
+        for(int i=1;i<=3;++i) _vals[i-1]=a(i);
+    }
+    inline T& operator()(const int &i){return _vals[i-1];}
+    inline const T& operator()(const int &i)const{return _vals[i-1];}
+
+    //*** for + and -
+    inline Vector3dT operator+(const Vector3dT &a)const{
+        Vector3dT temp;
+        for(int i=0;i<3;++i) temp._vals[i]=_vals[i]+a._vals[i];
+        return temp;
+    }
+    inline Vector3dT operator-(const Vector3dT &a)const{
+        Vector3dT temp;
+        for(int i=0;i<3;++i) temp._vals[i]=_vals[i]-a._vals[i];
+        return temp;
+    }
+    //*** for scalar product
+    inline Vector3dT operator*(const T &a)const{
+        Vector3dT temp;
+        for(int i=0;i<3;++i) temp._vals[i]=_vals[i]*a;
+        return temp;
+    }
+    friend inline Vector3dT operator*(const T &lhs,const Vector3dT &a){
+        return a*lhs;
+    }
+    // for plain numbers, otherwise double-->T and double-->Vector3d are ambiguous
+    template<typename S,typename enable_if<is_arithmetic<S>::value,int>::type=0>
+    inline Vector3dT operator*(const S &a)const{
+        Vector3dT temp;
+        for(int i=0;i<3;++i) temp._vals[i]=_vals[i]*static_cast<double>(a);
+        return temp;
+    }
+    template<typename S,typename enable_if<is_arithmetic<S>::value,int>::type=0>
+    friend inline Vector3dT operator*(const S &lhs,const Vector3dT &a){
+        return a*static_cast<double>(lhs);
+    }
+    //*** for dot product
+    inline T operator*(const Vector3dT &a)const{
+        return _vals[0]*a._vals[0]+_vals[1]*a._vals[1]+_vals[2]*a._vals[2];
+    }
+    inline T operator*(const Vector3d &a)const{
+        return _vals[0]*a(1)+_vals[1]*a(2)+_vals[2]*a(3);
+    }
+    inline T Norm()const{
+        return sqrt((*this)*(*this));
+    }
+    inline Vector3d GetValue()const{
+        Vector3d temp(0.0);
+        for(int i=1;i<=3;++i) temp(i)=GetADValue(_vals[i-1]);
+        return temp;
+    }
+
+private:
+    T _vals[3];
+};
+
+//**************************************************************
+template<typename T>
+class RankTwoTensorT{
+public:
+    RankTwoTensorT(){
+        for(int i=0;i<9;++i) _vals[i]=0.0;
+    }
+    explicit RankTwoTensorT(const double &val){
+        for(int i=0;i<9;++i) _vals[i]=val;
+    }
+    RankTwoTensorT(const RankTwoTensor &a){
+        for(int i=1;i<=9;++i) _vals[i-1]=a[i];
+    }
+    inline T& operator()(const int &i,const int &j){return _vals[(i-1)*3+j-1];}
+    inline const T& operator()(const int &i,const int &j)const{return _vals[(i-1)*3+j-1];}
+    inline Vector3dT<T> IthRow(const int &i)const{
+        Vector3dT<T> temp;
+        for(int j=1;j<=3;++j) temp(j)=(*this)(i,j);
+        return temp;
+    }
+
+    //*****************************************
+    //*** for the math operators
+    //*****************************************
+    inline RankTwoTensorT operator+(const RankTwoTensorT &a)const{
+        RankTwoTensorT temp;
+        for(int i=0;i<9;++i) temp._vals[i]=_vals[i]+a._vals[i];
+        return temp;
+    }
+    inline RankTwoTensorT& operator+=(const RankTwoTensorT &a){
+        for(int i=0;i<9;++i) _vals[i]+=a._vals[i];
+        return *this;
+    }
+    inline RankTwoTensorT operator-(const RankTwoTensorT &a)const{
+        RankTwoTensorT temp;
+        for(int i=0;i<9;++i) temp._vals[i]=_vals[i]-a._vals[i];
+        return temp;
+    }
+    inline RankTwoTensorT& operator-=(const RankTwoTensorT &a){
+        for(int i=0;i<9;++i) _vals[i]-=a._vals[i];
+        return *this;
+    }
+    inline RankTwoTensorT operator*(const T &a)const{
+        RankTwoTensorT temp;
+        for(int i=0;i<9;++i) temp._vals[i]=_vals[i]*a;
+        return temp;
+    }
+    friend inline RankTwoTensorT operator*(const T &lhs,const RankTwoTensorT &a){
+        return a*lhs;
+    }
+    // for plain numbers, otherwise double-->T and double-->RankTwoTensorT are ambiguous
+    template<typename S,typename enable_if<is_arithmetic<S>::value,int>::type=0>
+    inline RankTwoTensorT operator*(const S &a)const{
+        RankTwoTensorT temp;
+        for(int i=0;i<9;++i) temp._vals[i]=_vals[i]*static_cast<double>(a);
+        return temp;
+    }
+    template<typename S,typename enable_if<is_arithmetic<S>::value,int>::type=0>
+    friend inline RankTwoTensorT operator*(const S &lhs,const RankTwoTensorT &a){
+        return a*static_cast<double>(lhs);
+    }
+    inline RankTwoTensorT& operator*=(const T &a){
+        for(int i=0;i<9;++i) _vals[i]*=a;
+        return *this;
+    }
+    inline RankTwoTensorT operator*(const RankTwoTensorT &a)const{
+        // A*B
+        RankTwoTensorT temp;
+        for(int i=1;i<=3;++i){
+            for(int j=1;j<=3;++j){
+                for(int k=1;k<=3;++k){
+                    temp(i,j)+=(*this)(i,k)*a(k,j);
+                }
+            }
+        }
+        return temp;
+    }
+    inline Vector3dT<T> operator*(const Vector3dT<T> &a)const{
+        Vector3dT<T> temp;
+        for(int i=1;i<=3;++i){
+            for(int j=1;j<=3;++j) temp(i)+=(*this)(i,j)*a(j);
+        }
+        return temp;
+    }
+    inline T DoubleDot(const RankTwoTensorT &a)const{
+        // A:B=A_ij*B_ij
+        T sum(0.0);
+        for(int i=0;i<9;++i) sum+=_vals[i]*a._vals[i];
+        return sum;
+    }
+
+    //*****************************************
+    //*** for some common tensor calculation
+    //*****************************************
+    inline void SetToZeros(){
+        for(int i=0;i<9;++i) _vals[i]=0.0;
+    }
+    inline void SetToIdentity(){
+        SetToZeros();
+        _vals[0]=1.0;_vals[4]=1.0;_vals[8]=1.0;
+    }
+    inline T Trace()const{
+        return _vals[0]+_vals[4]+_vals[8];
+    }
+    inline RankTwoTensorT Transpose()const{
+        RankTwoTensorT temp;
+        for(int i=1;i<=3;++i){
+            for(int j=1;j<=3;++j) temp(i,j)=(*this)(j,i);
+        }
+        return temp;
+    }
+    inline RankTwoTensorT Dev()const{
+        // deviatoric part, A-tr(A)/3*I
+        RankTwoTensorT temp(*this);
+        const T p=Trace()/3.0;
+        temp._vals[0]-=p;temp._vals[4]-=p;temp._vals[8]-=p;
+        return temp;
+    }
+    inline T Det()const{
+        const RankTwoTensorT &a=*this;
+        return a(1,1)*(a(2,2)*a(3,3)-a(2,3)*a(3,2))
+              -a(1,2)*(a(2,1)*a(3,3)-a(2,3)*a(3,1))
+              +a(1,3)*(a(2,1)*a(3,2)-a(2,2)*a(3,1));
+    }
+    inline RankTwoTensorT Inverse()const{
+        // the adjugate divided by the determinant
+        const RankTwoTensorT &a=*this;
+        const T invdet=1.0/Det();
+        RankTwoTensorT temp;
+        temp(1,1)=(a(2,2)*a(3,3)-a(2,3)*a(3,2))*invdet;
+        temp(1,2)=(a(1,3)*a(3,2)-a(1,2)*a(3,3))*invdet;
+        temp(1,3)=(a(1,2)*a(2,3)-a(1,3)*a(2,2))*invdet;
+        temp(2,1)=(a(2,3)*a(3,1)-a(2,1)*a(3,3))*invdet;
+        temp(2,2)=(a(1,1)*a(3,3)-a(1,3)*a(3,1))*invdet;
+        temp(2,3)=(a(1,3)*a(2,1)-a(1,1)*a(2,3))*invdet;
+        temp(3,1)=(a(2,1)*a(3,2)-a(2,2)*a(3,1))*invdet;
+        temp(3,2)=(a(1,2)*a(3,1)-a(1,1)*a(3,2))*invdet;
+        temp(3,3)=(a(1,1)*a(2,2)-a(1,2)*a(2,1))*invdet;
+        return temp;
+    }
+    inline RankTwoTensor GetValue()const{
+        RankTwoTensor temp(0.0);
+        for(int i=1;i<=9;++i) temp[i]=GetADValue(_vals[i-1]);
+        return temp;
+    }
+
+private:
+    T _vals[9];
+};
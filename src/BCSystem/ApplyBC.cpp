@@ -24,6 +24,7 @@ void BCSystem::ApplyBC(const Mesh &mesh,const DofHandler &dofHandler,FE &fe,cons
     for(auto it:_BCBlockList){
         bcvalue=it._BCValue;
         if(it._IsTimeDependent) bcvalue=it._BCValue*t;
+        if(IsLoadBC(it._BCType)) bcvalue*=_LoadFactor;
         DofIndex=it._DofID;
         bcnamelist=it._BoundaryNameList;
         if(it._BCType==BCType::DIRICHLETBC){
@@ -283,6 +284,7 @@ void BCSystem::ApplyInitialBC(const Mesh &mesh,const DofHandler &dofHandler,cons
     for(auto it:_BCBlockList){
         bcvalue=it._BCValue;
         if(it._IsTimeDependent) bcvalue=t*it._BCValue;
+        if(IsLoadBC(it._BCType)) bcvalue*=_LoadFactor;
         bcnamelist=it._BoundaryNameList;
         DofIndex=it._DofID;
         if(it._BCType==BCType::DIRICHLETBC){
@@ -308,4 +310,24 @@ void BCSystem::ApplyInitialBC(const Mesh &mesh,const DofHandler &dofHandler,cons
 
     VecAssemblyBegin(U);
     VecAssemblyEnd(U);
-}
\ No newline at end of file
+}
+//***********************************************************************
+void BCSystem::ApplyDirichletBCToRHS(const Mesh &mesh,const DofHandler &dofHandler,const double &t,Vec &U,Vec &RHS){
+    double bcvalue;
+    Mat K=NULL;// not used by the residual
+    for(auto it:_BCBlockList){
+        bcvalue=it._BCValue;
+        if(it._IsTimeDependent) bcvalue=t*it._BCValue;
+        if(IsLoadBC(it._BCType)) bcvalue*=_LoadFactor;
+        if(it._BCType==BCType::DIRICHLETBC){
+            ApplyDirichletBC(mesh,dofHandler,FECalcType::ComputeResidual,it._DofID,bcvalue,it._BoundaryNameList,U,K,RHS);
+        }
+        else if(it._BCType==BCType::NODALDIRICHLETBC){
+            ApplyNodalDirichletBC(mesh,dofHandler,FECalcType::ComputeResidual,it._DofID,bcvalue,it._BoundaryNameList,U,K,RHS);
+        }
+    }
+    VecAssemblyBegin(RHS);
+    VecAssemblyEnd(RHS);
+    VecAssemblyBegin(U);
+    VecAssemblyEnd(U);
+}
@@ -23,6 +23,7 @@ BCSystem::BCSystem(){
     _BCBlockList.clear();
 
     _PenaltyFactor=1.0e15;
+    _LoadFactor=1.0;
     _nBCDim=0;_nBulkDim=0;_nNodesPerBCElmt=0;
     _xi=0.0;_eta=0.0;_JxW=0.0;
     
@@ -64,6 +65,7 @@ void BCSystem::AddBCBlock2List(BCBlock &bcblock){
 
 void BCSystem::InitBCSystem(const Mesh &mesh){
     _PenaltyFactor=1.0e15;
+    _LoadFactor=1.0;
     _nBCDim=0;
     _nBulkDim=mesh.GetBulkMeshDim();
     _nNodesPerBCElmt=mesh.GetBulkMeshNodesNumPerBulkElmt();
@@ -41,6 +41,8 @@ void BulkDofHandler::CreateBulkDofsMap(const Mesh &mesh,BCSystem &bcSystem,ElmtS
     }
     _ElmtLocalDofIndex.resize(_nBulkElmts,vector<vector<int>>(0));
     _ElmtElmtMateIndexList.resize(_nBulkElmts,vector<int>(0));
+    _ElmtElmtQPointIndexList.resize(_nBulkElmts,vector<int>(0));
+    _ElmtElmtBlockIndexList.resize(_nBulkElmts,vector<int>(0));
 
 
     _nDofs=_nNodes*_nDofsPerNode;
@@ -117,7 +119,7 @@ void BulkDofHandler::CreateBulkDofsMap(const Mesh &mesh,BCSystem &bcSystem,ElmtS
 
     ElmtType elmttype;
     MateType matetype;
-    int mateindex;
+    int mateindex,qpointindex;
     for(iblock=1;iblock<=elmtSystem.GetBulkElmtBlockNums();iblock++){
         domainname=elmtSystem.GetIthBulkElmtBlock(iblock)._DomainName;
         dofindex=elmtSystem.GetIthBulkElmtBlock(iblock)._DofsIDList; // the dof index could be discontinue case, i.e. 1,2,4 !!!
@@ -125,12 +127,15 @@ void BulkDofHandler::CreateBulkDofsMap(const Mesh &mesh,BCSystem &bcSystem,ElmtS
         elmttype=elmtSystem.GetIthBulkElmtBlock(iblock)._ElmtType;
         matetype=elmtSystem.GetIthBulkElmtBlock(iblock)._MateType;
         mateindex=elmtSystem.GetIthBulkElmtBlock(iblock)._MateIndex;
+        qpointindex=elmtSystem.GetIthBulkElmtBlock(iblock)._QPointIndex;
         for(auto e:mesh.GetBulkMeshElmtIDsViaPhysicalName(domainname)){
             // now we are in the elmt id vector
             ee=e-(mesh.GetBulkMeshElmtsNum()-mesh.GetBulkMeshBulkElmtsNum());
             _ElmtElmtMateTypePairList[ee-1].push_back(make_pair(elmttype,matetype));
             _ElmtLocalDofIndex[ee-1].push_back(dofindex);
             _ElmtElmtMateIndexList[ee-1].push_back(mateindex);
+            _ElmtElmtQPointIndexList[ee-1].push_back(qpointindex);
+            _ElmtElmtBlockIndexList[ee-1].push_back(iblock);
             for(i=1;i<=mesh.GetBulkMeshIthBulkElmtNodesNum(ee);i++){
                 iInd=mesh.GetBulkMeshIthBulkElmtJthNodeID(ee,i);
                 for(j=1;j<=ndofs;j++){
@@ -182,10 +187,55 @@ void BulkDofHandler::CreateBulkDofsMap(const Mesh &mesh,BCSystem &bcSystem,ElmtS
         }
     }
 
+    //*** the dofs coupling of each element, the elements with the same [elmts] sub blocks share the
+    //*** same mask, the structurally zero blocks are neither preallocated nor assembled. If some nodes
+    //*** of the element miss some dofs, the element is treated as the fully coupled one
+    map<vector<int>,int> maskIndex;
+    vector<int> mask,rowCoupledDofs(_nDofsPerNode,0);
+    int nElmtNodes,nElmtDofs,nCoupled;
+    bool IsFullyCoupled;
+    _DofCouplingMaskList.assign(1,vector<int>(0));
+    _ElmtDofCouplingMaskIndex.assign(_nBulkElmts,0);
+    for(e=1;e<=_nBulkElmts;e++){
+        nElmtNodes=mesh.GetBulkMeshIthBulkElmtNodesNum(e);
+        nElmtDofs=0;
+        for(j=1;j<=nElmtNodes;j++){
+            iInd=mesh.GetBulkMeshIthBulkElmtJthNodeID(e,j);
+            for(k=1;k<=_nDofsPerNode;k++){
+                if(_NodalDofFlag[iInd-1][k-1]>=0.0) nElmtDofs+=1;
+            }
+        }
+        if(nElmtDofs!=nElmtNodes*_nDofsPerNode) continue;
+        mask=elmtSystem.GetBulkElmtDofCouplingMask(_ElmtElmtBlockIndexList[e-1],_nDofsPerNode);
+        IsFullyCoupled=true;
+        for(const int &val:mask){
+            if(!val){IsFullyCoupled=false;break;}
+        }
+        if(IsFullyCoupled) continue;
+        if(maskIndex.find(mask)==maskIndex.end()){
+            maskIndex[mask]=static_cast<int>(_DofCouplingMaskList.size());
+            _DofCouplingMaskList.push_back(mask);
+        }
+        _ElmtDofCouplingMaskIndex[e-1]=maskIndex[mask];
+    }
+
     // now we remove all the empty space of some vectors
     _RowNNZ.resize(_nActiveDofs,0);
     _RowMaxNNZ=0;
     for(e=1;e<=_nBulkElmts;e++){
+        // the non-zeros of the k-th dof of each node
+        nElmtNodes=mesh.GetBulkMeshIthBulkElmtNodesNum(e);
+        const vector<int> &elMask=GetIthBulkElmtDofCouplingMask(e);
+        for(k=1;k<=_nDofsPerNode;k++){
+            if(elMask.empty()){
+                rowCoupledDofs[k-1]=_nMaxDofsPerElmt;
+            }
+            else{
+                nCoupled=0;
+                for(i=1;i<=_nDofsPerNode;i++) nCoupled+=elMask[(k-1)*_nDofsPerNode+i-1];
+                rowCoupledDofs[k-1]=nCoupled*nElmtNodes;
+            }
+        }
         for(j=1;j<=mesh.GetBulkMeshIthBulkElmtNodesNum(e);j++){
             iInd=mesh.GetBulkMeshIthBulkElmtJthNodeID(e,j);
             for(k=1;k<=_nDofsPerNode;k++){
@@ -193,7 +243,7 @@ void BulkDofHandler::CreateBulkDofsMap(const Mesh &mesh,BCSystem &bcSystem,ElmtS
 
                 if(_NodalDofFlag[iInd-1][k-1]>=0.0){
                     _ElmtDofsMap[e-1][ii]=_NodeDofsMap[iInd-1][k-1];
-                    _RowNNZ[_NodeDofsMap[iInd-1][k-1]-1]+=_nMaxDofsPerElmt;
+                    _RowNNZ[_NodeDofsMap[iInd-1][k-1]-1]+=rowCoupledDofs[k-1];
 
                     if(_RowNNZ[_NodeDofsMap[iInd-1][k-1]-1]>_RowMaxNNZ){
                         _RowMaxNNZ=_RowNNZ[_NodeDofsMap[iInd-1][k-1]-1];
@@ -0,0 +1,191 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: implement the benchmark of the scalar and the batch
+//+++          kernels for the linear elastic HEX8 element
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "ElmtBench/ElmtBatchBench.h"
+
+ElmtBatchBench::ElmtBatchBench(){
+    _nElmts=0;_nQp=0;
+}
+//****************************************************************
+void ElmtBatchBench::CreateElmts(const int &nElmts){
+    const double xi[8]  ={-1.0, 1.0, 1.0,-1.0,-1.0, 1.0, 1.0,-1.0};
+    const double eta[8] ={-1.0,-1.0, 1.0, 1.0,-1.0,-1.0, 1.0, 1.0};
+    const double zeta[8]={-1.0,-1.0,-1.0,-1.0, 1.0, 1.0, 1.0, 1.0};
+    ShapeFun shp(_nDim,MeshType::HEX8);
+    QPoint qpoint(_nDim,2);
+    Nodes elNodes(_nNodes);
+    RankFourTensor jacobian(0.0);
+    RankTwoTensor stress(0.0);
+    int e,a,i,qp;
+
+    shp.PreCalc();
+    qpoint.CreateQpoints(MeshType::HEX8);
+    _nElmts=nElmts;
+    _nQp=qpoint.GetQpPointsNum();
+    _gpJxW.assign(_nElmts*_nQp,0.0);
+    _gpShpVal.assign(_nElmts*_nQp*_nNodes,0.0);
+    _gpShpGrad.assign(_nElmts*_nQp*_nNodes,Vector3d(0.0));
+    _gpMates.resize(_nElmts*_nQp);
+
+    // the linear elastic material, the stress is not zero, so the residual is not trivial
+    jacobian.SetFromEandNu(210.0e3,0.3);
+    for(e=0;e<_nElmts;e++){
+        // a unit cube with the distorted nodes
+        for(a=1;a<=_nNodes;a++){
+            elNodes(a,1)=0.5*(1.0+xi[a-1])  +0.1*sin(1.3*e+2.1*a);
+            elNodes(a,2)=0.5*(1.0+eta[a-1]) +0.1*sin(0.7*e+1.7*a);
+            elNodes(a,3)=0.5*(1.0+zeta[a-1])+0.1*cos(1.1*e+0.9*a);
+        }
+        for(qp=0;qp<_nQp;qp++){
+            shp.Calc(qpoint.GetIthQpPointJthCoord(qp+1,1),qpoint.GetIthQpPointJthCoord(qp+1,2),
+                     qpoint.GetIthQpPointJthCoord(qp+1,3),elNodes,true);
+            _gpJxW[e*_nQp+qp]=qpoint.GetIthQpPointJthCoord(qp+1,0)*shp.GetDetJac();
+            for(a=1;a<=_nNodes;a++){
+                _gpShpVal[(e*_nQp+qp)*_nNodes+a-1]=shp.shape_value(a);
+                _gpShpGrad[(e*_nQp+qp)*_nNodes+a-1]=shp.shape_grad(a);
+            }
+            for(i=1;i<=_nDim;i++){
+                for(a=1;a<=_nDim;a++) stress(i,a)=1.0e-3*(i+a)+1.0e-4*sin(1.0*e+qp);
+            }
+            _gpMates[e*_nQp+qp].Rank2Materials["stress"]=stress;
+            _gpMates[e*_nQp+qp].Rank4Materials["jacobian"]=jacobian;
+        }
+    }
+
+    _localDofIndex.resize(_nDofsPerNode);
+    for(i=0;i<_nDofsPerNode;i++) _localDofIndex[i]=i+1;
+    _elDofs.resize(_nDofs);
+    _elDofsActiveFlag.assign(_nDofs,1.0);
+    for(i=0;i<_nDofs;i++) _elDofs[i]=i;
+    _gpU.assign(_nDofsPerNode+1,0.0);
+    _gpGradU.assign(_nDofsPerNode+1,Vector3d(0.0));
+
+    _batch.Init(_nDim,_nNodes,_nQp);
+    _ScalarK.assign(_nElmts*_nDofs*_nDofs,0.0);
+    _BatchK.assign(_nElmts*_nDofs*_nDofs,0.0);
+    _ScalarR.assign(_nElmts*_nDofs,0.0);
+    _BatchR.assign(_nElmts*_nDofs,0.0);
+}
+//****************************************************************
+void ElmtBatchBench::RunScalar(const FECalcType &calctype){
+    // the same as FormBulkFE without the batch: one qpoint of one element at a time
+    const double ctan[2]={1.0,0.0};
+    int e,qp,i,j;
+    double JxW;
+    _localK.Resize(_nDofs,_nDofs);
+    _localR.Resize(_nDofs);
+    for(e=0;e<_nElmts;e++){
+        double *K=_ScalarK.data()+e*_nDofs*_nDofs;
+        double *R=_ScalarR.data()+e*_nDofs;
+        for(qp=0;qp<_nQp;qp++){
+            JxW=_gpJxW[e*_nQp+qp];
+            if(calctype==FECalcType::ComputeResidual){
+                _localR.setZero();
+                MechanicsElmtKernelT<3,8>::Compute(calctype,_nDofsPerNode,_localDofIndex,ctan,
+                                                   &_gpShpVal[(e*_nQp+qp)*_nNodes],&_gpShpGrad[(e*_nQp+qp)*_nNodes],
+                                                   _gpU,_gpGradU,_gpMates[e*_nQp+qp],_localK,_localR);
+                for(i=0;i<_nDofs;i++) R[i]+=_localR.Coeff(i)*JxW*_elDofsActiveFlag[i];
+            }
+            else{
+                _localK.setZero();
+                MechanicsElmtKernelT<3,8>::Compute(calctype,_nDofsPerNode,_localDofIndex,ctan,
+                                                   &_gpShpVal[(e*_nQp+qp)*_nNodes],&_gpShpGrad[(e*_nQp+qp)*_nNodes],
+                                                   _gpU,_gpGradU,_gpMates[e*_nQp+qp],_localK,_localR);
+                for(i=0;i<_nDofs;i++){
+                    for(j=0;j<_nDofs;j++) K[i*_nDofs+j]+=_localK.Coeff(i,j)*JxW*_elDofsActiveFlag[i];
+                }
+            }
+        }
+    }
+}
+//****************************************************************
+void ElmtBatchBench::RunBatch(const FECalcType &calctype){
+    // the same as FormBulkFE with the batch: gather W elements, evaluate them at once, then scatter
+    int e,lane,i,j,e0=0;
+    _batch.Reset();
+    for(e=0;e<_nElmts;e++){
+        _batch.AppendLane(calctype,1.0,_nQp,_nNodes,&_gpJxW[e*_nQp],&_gpShpGrad[e*_nQp*_nNodes],&_gpMates[e*_nQp],
+                          _nDofs,_nDofsPerNode,_localDofIndex,_elDofs,_elDofsActiveFlag);
+        if(_batch.IsFull()||e==_nElmts-1){
+            MechanicsElmtBatchKernelT<3,8>::Compute(calctype,_batch);
+            for(lane=0;lane<_batch.GetLanesNum();lane++){
+                const vector<double> &flag=_batch.GetIthLaneDofsActiveFlag(lane);
+                if(calctype==FECalcType::ComputeResidual){
+                    double *R=_BatchR.data()+(e0+lane)*_nDofs;
+                    _batch.GetIthLaneResidual(lane,_localR);
+                    for(i=0;i<_nDofs;i++) R[i]+=_localR.Coeff(i)*flag[i];
+                }
+                else{
+                    double *K=_BatchK.data()+(e0+lane)*_nDofs*_nDofs;
+                    _batch.GetIthLaneJacobian(lane,_localK);
+                    for(i=0;i<_nDofs;i++){
+                        for(j=0;j<_nDofs;j++) K[i*_nDofs+j]+=_localK.Coeff(i,j)*flag[i];
+                    }
+                }
+            }
+            e0=e+1;
+            _batch.Reset();
+        }
+    }
+}
+//****************************************************************
+double ElmtBatchBench::GetMaxRelativeError(const vector<double> &a,const vector<double> &b)const{
+    double maxdiff=0.0,maxval=0.0;
+    for(int i=0;i<static_cast<int>(a.size());i++){
+        if(abs(a[i]-b[i])>maxdiff) maxdiff=abs(a[i]-b[i]);
+        if(abs(a[i])>maxval) maxval=abs(a[i]);
+    }
+    if(maxval<1.0e-16) return maxdiff;
+    return maxdiff/maxval;
+}
+//****************************************************************
+void ElmtBatchBench::Run(const int &nElmts,const int &nRepeats){
+    char buff[70];
+    double tscalar,tbatch;
+    CreateElmts(nElmts);
+
+    MessagePrinter::PrintNormalTxt("Element kernel benchmark(linear elastic HEX8):");
+    snprintf(buff,70,"  elements=%d, qpoints=%d, repeats=%d, batch width=%d",_nElmts,_nQp,nRepeats,AsFemElmtBatchWidth);
+    MessagePrinter::PrintNormalTxt(string(buff));
+
+    const FECalcType calctypes[2]={FECalcType::ComputeResidual,FECalcType::ComputeJacobian};
+    const string names[2]={"residual","jacobian"};
+    for(int icalc=0;icalc<2;icalc++){
+        const FECalcType &calctype=calctypes[icalc];
+        fill(_ScalarK.begin(),_ScalarK.end(),0.0);fill(_ScalarR.begin(),_ScalarR.end(),0.0);
+        fill(_BatchK.begin(),_BatchK.end(),0.0);fill(_BatchR.begin(),_BatchR.end(),0.0);
+        // the first run is used for the check, the timed runs just accumulate on top of it
+        RunScalar(calctype);
+        RunBatch(calctype);
+        const double err=(calctype==FECalcType::ComputeResidual)?GetMaxRelativeError(_ScalarR,_BatchR)
+                                                               :GetMaxRelativeError(_ScalarK,_BatchK);
+
+        auto t0=chrono::high_resolution_clock::now();
+        for(int it=0;it<nRepeats;it++) RunScalar(calctype);
+        auto t1=chrono::high_resolution_clock::now();
+        for(int it=0;it<nRepeats;it++) RunBatch(calctype);
+        auto t2=chrono::high_resolution_clock::now();
+        tscalar=chrono::duration_cast<chrono::microseconds>(t1-t0).count()*1.0e-6;
+        tbatch=chrono::duration_cast<chrono::microseconds>(t2-t1).count()*1.0e-6;
+
+        snprintf(buff,70,"  %s: scalar =%12.4e elmts/s",names[icalc].c_str(),tscalar>0.0?_nElmts*nRepeats/tscalar:0.0);
+        MessagePrinter::PrintNormalTxt(string(buff));
+        snprintf(buff,70,"  %s: batched=%12.4e elmts/s",names[icalc].c_str(),tbatch>0.0?_nElmts*nRepeats/tbatch:0.0);
+        MessagePrinter::PrintNormalTxt(string(buff));
+        snprintf(buff,70,"  %s: speedup=%8.3f, max relative error=%10.3e",names[icalc].c_str(),tbatch>0.0?tscalar/tbatch:0.0,err);
+        MessagePrinter::PrintNormalTxt(string(buff));
+    }
+    MessagePrinter::PrintDashLine();
+}
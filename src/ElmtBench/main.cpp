@@ -0,0 +1,51 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the main program of the element kernel benchmark
+//+++          (asfem-elmtbench), usage:
+//+++            asfem-elmtbench -n 20000 -r 10
+//+++          -n is the number of elements, -r is the repeats
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <iostream>
+#include "petsc.h"
+
+#include "Welcome.h"
+
+#include "ElmtBench/ElmtBatchBench.h"
+
+
+int main(int args,char *argv[]){
+    PetscErrorCode ierr;
+    ierr=PetscInitialize(&args,&argv,NULL,NULL);if (ierr) return ierr;
+
+    const PetscInt Year=2021;
+    const PetscInt Month=3;
+    const PetscInt Day=28;
+    const PetscReal Version=0.5;
+
+    Welcome(Year,Month,Day,Version);
+
+    PetscInt nElmts=20000,nRepeats=10;
+    PetscBool HasOption;
+    ierr=PetscOptionsGetInt(NULL,NULL,"-n",&nElmts,&HasOption);CHKERRQ(ierr);
+    ierr=PetscOptionsGetInt(NULL,NULL,"-r",&nRepeats,&HasOption);CHKERRQ(ierr);
+    if(nElmts<1||nRepeats<1){
+        MessagePrinter::PrintErrorTxt("-n and -r of asfem-elmtbench must be positive integers");
+        MessagePrinter::AsFem_Exit();
+    }
+
+    ElmtBatchBench elmtBatchBench;
+    elmtBatchBench.Run(nElmts,nRepeats);
+
+    ierr=PetscFinalize();CHKERRQ(ierr);
+    return ierr;
+}
@@ -0,0 +1,323 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: implement the compile-time specialized qpoint kernels
+//+++          and their explicit instantiations
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "ElmtSystem/BulkElmtKernelT.h"
+
+//****************************************************************************
+//*** the Mandel components of the small strain in Dim, 2D only has the in-plane
+//*** ones(11,22,12). The m-th component of the strain of the unit displacement
+//*** u_i of node a is: B_a(m,i)=Coef[m][i]*N_a,(Comp[m][i]+1)
+//****************************************************************************
+template<int Dim>
+class MandelStrainMap{
+public:
+    static constexpr int N=(Dim==2)?3:6;
+    MandelStrainMap(){
+        const int mandel[6]={1,2,(Dim==2)?6:3,4,5,6};
+        int p,q;
+        for(int m=0;m<N;m++){
+            I[m]=mandel[m];
+            SymRankFourTensor::GetIndexPair(I[m],p,q);
+            for(int i=0;i<Dim;i++){
+                Coef[m][i]=0.0;Comp[m][i]=0;
+                if(i==p-1){
+                    Coef[m][i]=(p==q)?1.0:sqrt(0.5);Comp[m][i]=q-1;
+                }
+                else if(i==q-1){
+                    Coef[m][i]=sqrt(0.5);Comp[m][i]=p-1;
+                }
+            }
+        }
+    }
+    int I[N];// the Mandel index of the m-th component
+    double Coef[N][Dim];
+    int Comp[N][Dim];
+};
+
+template<int Dim,int NNodes>
+void PoissonElmtKernelT<Dim,NNodes>::Compute(const FECalcType &calctype,const int &nDofsPerNode,
+                                             const vector<int> &localDofIndex,const double (&ctan)[2],
+                                             const double *shpval,const Vector3d *shpgrad,
+                                             const vector<double> &gpU,const vector<Vector3d> &gpGradU,
+                                             const Materials &Mate,ElmtMatrixXd &localK,ElmtVectorXd &localR){
+    if(gpU.size()){}
+    // the materials are taken once for all the nodes
+    const double sigma=Mate.ScalarMaterials.at("sigma");
+    const int k0=localDofIndex[0]-1;
+    double gradUgradN[NNodes];
+    for(int a=0;a<NNodes;a++){
+        gradUgradN[a]=0.0;
+        for(int j=1;j<=Dim;j++) gradUgradN[a]+=gpGradU[1](j)*shpgrad[a](j);
+    }
+    if(calctype==FECalcType::ComputeResidual){
+        const double f=Mate.ScalarMaterials.at("f");
+        for(int a=0;a<NNodes;a++){
+            localR.Coeff(a*nDofsPerNode+k0)+=sigma*gradUgradN[a]+f*shpval[a];
+        }
+    }
+    else if(calctype==FECalcType::ComputeJacobian){
+        const double dsigmadu=Mate.ScalarMaterials.at("dsigmadu")*ctan[0];
+        const double dfdu=Mate.ScalarMaterials.at("dfdu")*ctan[0];
+        const double sig=sigma*ctan[0];
+        double gradNgradN;
+        for(int a=0;a<NNodes;a++){
+            for(int b=0;b<NNodes;b++){
+                gradNgradN=0.0;
+                for(int j=1;j<=Dim;j++) gradNgradN+=shpgrad[a](j)*shpgrad[b](j);
+                localK.Coeff(a*nDofsPerNode+k0,b*nDofsPerNode+k0)+=dsigmadu*shpval[b]*gradUgradN[a]
+                                                                  +sig*gradNgradN
+                                                                  +dfdu*shpval[a]*shpval[b];
+            }
+        }
+    }
+}
+//****************************************************************************
+template<int Dim,int NNodes>
+void MechanicsElmtKernelT<Dim,NNodes>::Compute(const FECalcType &calctype,const int &nDofsPerNode,
+                                               const vector<int> &localDofIndex,const double (&ctan)[2],
+                                               const double *shpval,const Vector3d *shpgrad,
+                                               const vector<double> &gpU,const vector<Vector3d> &gpGradU,
+                                               const Materials &Mate,ElmtMatrixXd &localK,ElmtVectorXd &localR){
+    if(shpval[0]||gpU.size()||gpGradU.size()){}
+    int k[Dim];
+    for(int i=0;i<Dim;i++) k[i]=localDofIndex[i]-1;
+    if(calctype==FECalcType::ComputeResidual){
+        // R_ai=sigma_ij*N_a,j
+        const RankTwoTensor &stress=Mate.Rank2Materials.at("stress");
+        double s[Dim][Dim];
+        for(int i=0;i<Dim;i++){
+            for(int j=0;j<Dim;j++) s[i][j]=stress(i+1,j+1);
+        }
+        double val;
+        for(int a=0;a<NNodes;a++){
+            for(int i=0;i<Dim;i++){
+                val=0.0;
+                for(int j=0;j<Dim;j++) val+=s[i][j]*shpgrad[a](j+1);
+                localR.Coeff(a*nDofsPerNode+k[i])+=val;
+            }
+        }
+    }
+    else if(calctype==FECalcType::ComputeJacobian&&Mate.HasSymTangent){
+        // K_aibk=B_a(m,i)*D_mn*B_b(n,k), D is the Mandel tangent, only its components of current dim are read
+        static const MandelStrainMap<Dim> mandel;
+        const int NM=MandelStrainMap<Dim>::N;
+        double D[NM][NM],B[NNodes][NM][Dim],DB[NM][Dim],val;
+        for(int m=0;m<NM;m++){
+            for(int n=0;n<NM;n++) D[m][n]=Mate.SymTangent(mandel.I[m],mandel.I[n])*ctan[0];
+        }
+        for(int a=0;a<NNodes;a++){
+            for(int m=0;m<NM;m++){
+                for(int i=0;i<Dim;i++) B[a][m][i]=mandel.Coef[m][i]*shpgrad[a](mandel.Comp[m][i]+1);
+            }
+        }
+        for(int b=0;b<NNodes;b++){
+            for(int m=0;m<NM;m++){
+                for(int kk=0;kk<Dim;kk++){
+                    DB[m][kk]=0.0;
+                    for(int n=0;n<NM;n++) DB[m][kk]+=D[m][n]*B[b][n][kk];
+                }
+            }
+            for(int a=0;a<NNodes;a++){
+                for(int i=0;i<Dim;i++){
+                    for(int kk=0;kk<Dim;kk++){
+                        val=0.0;
+                        for(int m=0;m<NM;m++) val+=B[a][m][i]*DB[m][kk];
+                        localK.Coeff(a*nDofsPerNode+k[i],b*nDofsPerNode+k[kk])+=val;
+                    }
+                }
+            }
+        }
+    }
+    else if(calctype==FECalcType::ComputeJacobian){
+        // K_aibk=N_a,j*C_ijkl*N_b,l, the inner product with N_a is done first: A_a(i,k,l)=N_a,j*C_ijkl
+        const RankFourTensor &jacobian=Mate.Rank4Materials.at("jacobian");
+        double C[Dim][Dim][Dim][Dim];
+        for(int i=0;i<Dim;i++){
+            for(int j=0;j<Dim;j++){
+                for(int kk=0;kk<Dim;kk++){
+                    for(int l=0;l<Dim;l++) C[i][j][kk][l]=jacobian(i+1,j+1,kk+1,l+1)*ctan[0];
+                }
+            }
+        }
+        double A[Dim][Dim][Dim],val;
+        for(int a=0;a<NNodes;a++){
+            for(int i=0;i<Dim;i++){
+                for(int kk=0;kk<Dim;kk++){
+                    for(int l=0;l<Dim;l++){
+                        A[i][kk][l]=0.0;
+                        for(int j=0;j<Dim;j++) A[i][kk][l]+=shpgrad[a](j+1)*C[i][j][kk][l];
+                    }
+                }
+            }
+            for(int b=0;b<NNodes;b++){
+                for(int i=0;i<Dim;i++){
+                    for(int kk=0;kk<Dim;kk++){
+                        val=0.0;
+                        for(int l=0;l<Dim;l++) val+=A[i][kk][l]*shpgrad[b](l+1);
+                        localK.Coeff(a*nDofsPerNode+k[i],b*nDofsPerNode+k[kk])+=val;
+                    }
+                }
+            }
+        }
+    }
+}
+//****************************************************************************
+template<int Dim,int NNodes>
+void MechanicsElmtBatchKernelT<Dim,NNodes>::Compute(const FECalcType &calctype,BulkElmtBatch &batch){
+    // the same as MechanicsElmtKernelT, but each scalar becomes W lanes, all the lanes
+    // are computed even if the batch is not full, the empty lanes are never scattered
+    const int W=AsFemElmtBatchWidth;
+    const int ND=NNodes*Dim,D2=Dim*Dim,D4=D2*D2;
+    const int nQp=batch.GetQpPointsNum();
+    int qp,a,b,i,j,kk,l,w;
+    if(calctype==FECalcType::ComputeResidual){
+        // R_ai=sigma_ij*N_a,j
+        double *R=batch._R.data();
+        double s[D2*W],val[W];
+        for(i=0;i<ND*W;i++) R[i]=0.0;
+        for(qp=0;qp<nQp;qp++){
+            const double *g=batch._Grad.data()+qp*ND*W;
+            for(i=0;i<D2*W;i++) s[i]=batch._Stress[qp*D2*W+i];
+            for(a=0;a<NNodes;a++){
+                for(i=0;i<Dim;i++){
+                    for(w=0;w<W;w++) val[w]=0.0;
+                    for(j=0;j<Dim;j++){
+                        const double *gaj=g+(a*Dim+j)*W;
+                        for(w=0;w<W;w++) val[w]+=s[(i*Dim+j)*W+w]*gaj[w];
+                    }
+                    double *r=R+(a*Dim+i)*W;
+                    for(w=0;w<W;w++) r[w]+=val[w];
+                }
+            }
+        }
+    }
+    else if(calctype==FECalcType::ComputeJacobian&&batch._UseSymTangent){
+        // K_aibk=B_a(m,i)*D_mn*B_b(n,k), see MechanicsElmtKernelT, B of all the nodes is built
+        // once for each qpoint
+        static const MandelStrainMap<Dim> mandel;
+        const int NM=MandelStrainMap<Dim>::N;
+        double *K=batch._K.data();
+        double B[NNodes*NM*Dim*W],DB[NM*Dim*W],val[W];
+        for(i=0;i<ND*ND*W;i++) K[i]=0.0;
+        for(qp=0;qp<nQp;qp++){
+            const double *g=batch._Grad.data()+qp*ND*W;
+            const double *D=batch._SymTangent.data()+qp*NM*NM*W;
+            for(a=0;a<NNodes;a++){
+                for(int m=0;m<NM;m++){
+                    for(i=0;i<Dim;i++){
+                        const double c=mandel.Coef[m][i];
+                        const double *gaj=g+(a*Dim+mandel.Comp[m][i])*W;
+                        double *bami=B+((a*NM+m)*Dim+i)*W;
+                        for(w=0;w<W;w++) bami[w]=c*gaj[w];
+                    }
+                }
+            }
+            for(b=0;b<NNodes;b++){
+                for(int m=0;m<NM;m++){
+                    for(kk=0;kk<Dim;kk++){
+                        double *dbmk=DB+(m*Dim+kk)*W;
+                        for(w=0;w<W;w++) dbmk[w]=0.0;
+                        for(int n=0;n<NM;n++){
+                            const double *dmn=D+(m*NM+n)*W;
+                            const double *bbnk=B+((b*NM+n)*Dim+kk)*W;
+                            for(w=0;w<W;w++) dbmk[w]+=dmn[w]*bbnk[w];
+                        }
+                    }
+                }
+                for(a=0;a<NNodes;a++){
+                    for(i=0;i<Dim;i++){
+                        for(kk=0;kk<Dim;kk++){
+                            for(w=0;w<W;w++) val[w]=0.0;
+                            for(int m=0;m<NM;m++){
+                                const double *bami=B+((a*NM+m)*Dim+i)*W;
+                                const double *dbmk=DB+(m*Dim+kk)*W;
+                                for(w=0;w<W;w++) val[w]+=bami[w]*dbmk[w];
+                            }
+                            double *k=K+((a*Dim+i)*ND+b*Dim+kk)*W;
+                            for(w=0;w<W;w++) k[w]+=val[w];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else if(calctype==FECalcType::ComputeJacobian){
+        // K_aibk=N_a,j*C_ijkl*N_b,l, A_a(i,k,l)=N_a,j*C_ijkl is done first, the lanes of the
+        // gradients are copied to the local arrays, so the compiler knows they are not aliased with K
+        double *K=batch._K.data();
+        double A[D2*Dim*W],ga[Dim*W],gb[Dim*W],val[W];
+        for(i=0;i<ND*ND*W;i++) K[i]=0.0;
+        for(qp=0;qp<nQp;qp++){
+            const double *g=batch._Grad.data()+qp*ND*W;
+            const double *C=batch._Tangent.data()+qp*D4*W;
+            for(a=0;a<NNodes;a++){
+                for(i=0;i<Dim*W;i++) ga[i]=g[a*Dim*W+i];
+                for(i=0;i<Dim;i++){
+                    for(kk=0;kk<Dim;kk++){
+                        for(l=0;l<Dim;l++){
+                            double *aikl=A+((i*Dim+kk)*Dim+l)*W;
+                            for(w=0;w<W;w++) aikl[w]=0.0;
+                            for(j=0;j<Dim;j++){
+                                const double *c=C+(((i*Dim+j)*Dim+kk)*Dim+l)*W;
+                                for(w=0;w<W;w++) aikl[w]+=ga[j*W+w]*c[w];
+                            }
+                        }
+                    }
+                }
+                for(b=0;b<NNodes;b++){
+                    for(i=0;i<Dim*W;i++) gb[i]=g[b*Dim*W+i];
+                    for(i=0;i<Dim;i++){
+                        for(kk=0;kk<Dim;kk++){
+                            for(w=0;w<W;w++) val[w]=0.0;
+                            for(l=0;l<Dim;l++){
+                                for(w=0;w<W;w++) val[w]+=A[((i*Dim+kk)*Dim+l)*W+w]*gb[l*W+w];
+                            }
+                            double *k=K+((a*Dim+i)*ND+b*Dim+kk)*W;
+                            for(w=0;w<W;w++) k[w]+=val[w];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//****************************************************************************
+//*** the explicit instantiations, they must be the same as SelectBulkElmtQpKernel
+//*** and SelectBulkElmtBatchKernel
+//****************************************************************************
+template class PoissonElmtKernelT<2,3>;
+template class PoissonElmtKernelT<2,4>;
+template class PoissonElmtKernelT<2,9>;
+template class PoissonElmtKernelT<3,4>;
+template class PoissonElmtKernelT<3,8>;
+template class PoissonElmtKernelT<3,10>;
+template class PoissonElmtKernelT<3,27>;
+
+template class MechanicsElmtKernelT<2,3>;
+template class MechanicsElmtKernelT<2,4>;
+template class MechanicsElmtKernelT<2,9>;
+template class MechanicsElmtKernelT<3,4>;
+template class MechanicsElmtKernelT<3,8>;
+template class MechanicsElmtKernelT<3,10>;
+template class MechanicsElmtKernelT<3,27>;
+
+template class MechanicsElmtBatchKernelT<2,3>;
+template class MechanicsElmtBatchKernelT<2,4>;
+template class MechanicsElmtBatchKernelT<2,9>;
+template class MechanicsElmtBatchKernelT<3,4>;
+template class MechanicsElmtBatchKernelT<3,8>;
+template class MechanicsElmtBatchKernelT<3,10>;
+template class MechanicsElmtBatchKernelT<3,27>;
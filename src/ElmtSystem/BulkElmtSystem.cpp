@@ -13,6 +13,7 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "ElmtSystem/BulkElmtSystem.h"
+#include "FE/FE.h"
 
 BulkElmtSystem::BulkElmtSystem(){
     _nBulkElmtBlocks=0;
@@ -49,6 +50,25 @@ void BulkElmtSystem::InitBulkElmtMateInfo(MateSystem &matesystem){
     }
 }
 //***********************************
+void BulkElmtSystem::InitBulkElmtQPointInfo(FE &fe){
+    QPointType qptype;
+    int order;
+    for(int i=0;i<_nBulkElmtBlocks;i++){
+        qptype=fe.GetQPointType();
+        order=fe.GetBulkQpOrder();
+        if(_BulkElmtBlockList[i]._HasQpType) qptype=_BulkElmtBlockList[i]._QpType;
+        if(_BulkElmtBlockList[i]._QpOrder>=0){
+            order=_BulkElmtBlockList[i]._QpOrder;
+        }
+        else if(_BulkElmtBlockList[i]._ElmtType==ElmtType::MECHANICSRIELMT){
+            // the one-point gauss rule is the default one of the reduced integration element
+            if(!_BulkElmtBlockList[i]._HasQpType) qptype=QPointType::GAUSSLEGENDRE;
+            order=1;
+        }
+        _BulkElmtBlockList[i]._QPointIndex=fe.AddBulkQPoint(qptype,order);
+    }
+}
+//***********************************
 void BulkElmtSystem::AddBulkElmtBlock2List(ElmtBlock &elmtBlock){
     string msg;
     if(_BulkElmtBlockList.size()<1){
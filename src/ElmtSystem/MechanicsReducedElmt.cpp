@@ -0,0 +1,222 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: implement the hourglass control and the B-bar
+//+++          integration of the mechanics element
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "ElmtSystem/MechanicsReducedElmt.h"
+
+void MechanicsReducedElmt::ComputeMeanShapeGrad(const int &nNodes,const int &nQp,const int &nMaxNodes,
+                                                const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad){
+    if(static_cast<int>(_MeanShpGrad.size())<nNodes+1){
+        _MeanShpGrad.resize(nNodes+1,Vector3d(0.0));
+    }
+    _MeanVolume=0.0;
+    for(int i=1;i<=nNodes;i++){
+        _MeanShpGrad[i](1)=0.0;_MeanShpGrad[i](2)=0.0;_MeanShpGrad[i](3)=0.0;
+    }
+    for(int qp=0;qp<nQp;qp++){
+        _MeanVolume+=gpJxW[qp];
+        for(int i=1;i<=nNodes;i++){
+            const Vector3d &dshp=gpShpGrad[qp*nMaxNodes+i-1];
+            _MeanShpGrad[i](1)+=dshp(1)*gpJxW[qp];
+            _MeanShpGrad[i](2)+=dshp(2)*gpJxW[qp];
+            _MeanShpGrad[i](3)+=dshp(3)*gpJxW[qp];
+        }
+    }
+    for(int i=1;i<=nNodes;i++){
+        _MeanShpGrad[i](1)/=_MeanVolume;
+        _MeanShpGrad[i](2)/=_MeanVolume;
+        _MeanShpGrad[i](3)/=_MeanVolume;
+    }
+}
+//****************************************************************************
+void MechanicsReducedElmt::ModifyBBarGradU(const int &nDim,const vector<double> &gpJxW,BulkMateBatch &batch){
+    // for the plane strain case, the volumetric strain is the in-plane trace,
+    // so the correction is distributed over nDim components
+    const int nQp=batch.GetQpPointsNum();
+    double volume=0.0,divbar=0.0,divbarold=0.0,div,divold;
+    int i,qp;
+    for(qp=0;qp<nQp;qp++){
+        div=0.0;divold=0.0;
+        for(i=1;i<=nDim;i++){
+            div+=batch._gpGradU[qp][i](i);
+            divold+=batch._gpGradUOld[qp][i](i);
+        }
+        volume+=gpJxW[qp];
+        divbar+=div*gpJxW[qp];
+        divbarold+=divold*gpJxW[qp];
+    }
+    divbar/=volume;divbarold/=volume;
+    for(qp=0;qp<nQp;qp++){
+        div=0.0;divold=0.0;
+        for(i=1;i<=nDim;i++){
+            div+=batch._gpGradU[qp][i](i);
+            divold+=batch._gpGradUOld[qp][i](i);
+        }
+        for(i=1;i<=nDim;i++){
+            batch._gpGradU[qp][i](i)+=(divbar-div)/nDim;
+            batch._gpGradUOld[qp][i](i)+=(divbarold-divold)/nDim;
+        }
+    }
+}
+//****************************************************************************
+void MechanicsReducedElmt::ComputeBBar(const FECalcType &calctype,const int &nDim,const int &nNodes,const int &nDofsPerNode,
+                                       const vector<int> &localDofIndex,const double &ctan0,
+                                       const int &nQp,const int &nMaxNodes,
+                                       const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad,
+                                       const Materials *gpMates,ElmtMatrixXd &localK,ElmtVectorXd &localR){
+    // B-bar of node a and component i: sym(e_i x grad(N_a))+(bbar_ai-N_a,i)/nDim*I
+    ComputeMeanShapeGrad(nNodes,nQp,nMaxNodes,gpJxW,gpShpGrad);
+    const double invd=1.0/nDim;
+    int qp,a,b,i,k,l,p,iInd,kInd;
+    double JxW,trace,val;
+
+    if(calctype==FECalcType::ComputeResidual){
+        for(qp=0;qp<nQp;qp++){
+            JxW=gpJxW[qp];
+            const RankTwoTensor &stress=gpMates[qp].Rank2Materials.at("stress");
+            trace=0.0;
+            for(i=1;i<=nDim;i++) trace+=stress(i,i);
+            for(a=1;a<=nNodes;a++){
+                const Vector3d &grad=gpShpGrad[qp*nMaxNodes+a-1];
+                for(i=1;i<=nDim;i++){
+                    iInd=(a-1)*nDofsPerNode+localDofIndex[i-1];
+                    localR(iInd)+=(stress.IthRow(i)*grad+trace*invd*(_MeanShpGrad[a](i)-grad(i)))*JxW;
+                }
+            }
+        }
+    }
+    else if(calctype==FECalcType::ComputeJacobian){
+        double Cvol[4][4],CvolT[4][4],Cvv;
+        Vector3d CvolGa,CvolTGb;
+        for(qp=0;qp<nQp;qp++){
+            JxW=gpJxW[qp]*ctan0;
+            const RankFourTensor &jacobian=gpMates[qp].Rank4Materials.at("jacobian");
+            // Cvol_ij=C_ijpp, CvolT_kl=C_ppkl, p is summed over the nDim components
+            Cvv=0.0;
+            for(i=1;i<=3;i++){
+                for(k=1;k<=3;k++){
+                    Cvol[i][k]=0.0;CvolT[i][k]=0.0;
+                    for(p=1;p<=nDim;p++){
+                        Cvol[i][k]+=jacobian(i,k,p,p);
+                        CvolT[i][k]+=jacobian(p,p,i,k);
+                    }
+                }
+            }
+            for(i=1;i<=nDim;i++) Cvv+=Cvol[i][i];
+
+            for(a=1;a<=nNodes;a++){
+                const Vector3d &ga=gpShpGrad[qp*nMaxNodes+a-1];
+                for(i=1;i<=3;i++){
+                    CvolGa(i)=Cvol[i][1]*ga(1)+Cvol[i][2]*ga(2)+Cvol[i][3]*ga(3);
+                }
+                for(b=1;b<=nNodes;b++){
+                    const Vector3d &gb=gpShpGrad[qp*nMaxNodes+b-1];
+                    for(k=1;k<=3;k++){
+                        CvolTGb(k)=0.0;
+                        for(l=1;l<=3;l++) CvolTGb(k)+=CvolT[k][l]*gb(l);
+                    }
+                    for(i=1;i<=nDim;i++){
+                        iInd=(a-1)*nDofsPerNode+localDofIndex[i-1];
+                        for(k=1;k<=nDim;k++){
+                            kInd=(b-1)*nDofsPerNode+localDofIndex[k-1];
+                            val=jacobian.GetIKjlComponent(i,k,ga,gb)
+                               +(_MeanShpGrad[b](k)-gb(k))*invd*CvolGa(i)
+                               +(_MeanShpGrad[a](i)-ga(i))*invd*CvolTGb(k)
+                               +(_MeanShpGrad[a](i)-ga(i))*(_MeanShpGrad[b](k)-gb(k))*invd*invd*Cvv;
+                            localK(iInd,kInd)+=val*JxW;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+//****************************************************************************
+void MechanicsReducedElmt::ComputeHourglass(const FECalcType &calctype,const int &nDim,const int &nNodes,const int &nDofsPerNode,
+                                            const vector<int> &localDofIndex,const double &coef,const double &ctan0,
+                                            const Nodes &elNodes,const vector<double> &elU,
+                                            const int &nQp,const int &nMaxNodes,
+                                            const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad,
+                                            const Materials *gpMates,ElmtMatrixXd &localK,ElmtVectorXd &localR){
+    // the hourglass base vectors: xi*eta for QUAD4, and eta*zeta, xi*zeta, xi*eta, xi*eta*zeta for HEX8
+    const double Quad4Modes[1][4]={{ 1.0,-1.0, 1.0,-1.0}};
+    const double Hex8Modes[4][8]={{ 1.0, 1.0,-1.0,-1.0,-1.0,-1.0, 1.0, 1.0},
+                                  { 1.0,-1.0,-1.0, 1.0,-1.0, 1.0, 1.0,-1.0},
+                                  { 1.0,-1.0, 1.0,-1.0, 1.0,-1.0, 1.0,-1.0},
+                                  {-1.0, 1.0,-1.0, 1.0, 1.0,-1.0, 1.0,-1.0}};
+    int nModes;
+    if(nDim==2&&nNodes==4){
+        nModes=1;
+    }
+    else if(nDim==3&&nNodes==8){
+        nModes=4;
+    }
+    else{
+        MessagePrinter::PrintErrorTxt("the hourglass control of mechanicsri element only works for quad4 and hex8 mesh");
+        MessagePrinter::AsFem_Exit();
+        return;
+    }
+    if(coef<=0.0) return;
+
+    ComputeMeanShapeGrad(nNodes,nQp,nMaxNodes,gpJxW,gpShpGrad);
+
+    // the stiffness k=coef*2*mu*V*(b:b)/nDim, the shear modulus is taken from the tangent of the material
+    // and it is treated as a constant in the jacobian
+    double mu=0.0,bb=0.0,stiff,hx,q;
+    int a,b,i,m,iInd,jInd;
+    for(int qp=0;qp<nQp;qp++){
+        mu+=gpMates[qp].Rank4Materials.at("jacobian")(1,2,1,2);
+    }
+    mu/=nQp;
+    if(mu<0.0) mu=0.0;
+    for(a=1;a<=nNodes;a++){
+        for(i=1;i<=nDim;i++) bb+=_MeanShpGrad[a](i)*_MeanShpGrad[a](i);
+    }
+    stiff=coef*2.0*mu*_MeanVolume*bb/nDim;
+
+    _HgGamma.resize(nNodes+1,0.0);
+    for(m=0;m<nModes;m++){
+        const double *h=(nDim==2)?Quad4Modes[m]:Hex8Modes[m];
+        // gamma=(h-(h.x_i)b_i)/nNodes, which is orthogonal to the linear fields
+        for(a=1;a<=nNodes;a++) _HgGamma[a]=h[a-1];
+        for(i=1;i<=nDim;i++){
+            hx=0.0;
+            for(b=1;b<=nNodes;b++) hx+=h[b-1]*elNodes(b,i);
+            for(a=1;a<=nNodes;a++) _HgGamma[a]-=hx*_MeanShpGrad[a](i);
+        }
+        for(a=1;a<=nNodes;a++) _HgGamma[a]/=nNodes;
+
+        if(calctype==FECalcType::ComputeResidual){
+            for(i=1;i<=nDim;i++){
+                q=0.0;
+                for(b=1;b<=nNodes;b++) q+=_HgGamma[b]*elU[(b-1)*nDofsPerNode+localDofIndex[i-1]-1];
+                for(a=1;a<=nNodes;a++){
+                    iInd=(a-1)*nDofsPerNode+localDofIndex[i-1];
+                    localR(iInd)+=stiff*q*_HgGamma[a];
+                }
+            }
+        }
+        else if(calctype==FECalcType::ComputeJacobian){
+            for(i=1;i<=nDim;i++){
+                for(a=1;a<=nNodes;a++){
+                    iInd=(a-1)*nDofsPerNode+localDofIndex[i-1];
+                    for(b=1;b<=nNodes;b++){
+                        jInd=(b-1)*nDofsPerNode+localDofIndex[i-1];
+                        localK(iInd,jInd)+=stiff*_HgGamma[a]*_HgGamma[b]*ctan0;
+                    }
+                }
+            }
+        }
+    }
+}
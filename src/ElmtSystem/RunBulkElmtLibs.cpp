@@ -54,6 +54,8 @@ void BulkElmtSystem::RunBulkElmtLibs(const FECalcType &calctype,const ElmtType &
                                      Mate,MateOld,gpProj,localK,localR);
         break;
     case ElmtType::MECHANICSELMT:
+    case ElmtType::MECHANICSRIELMT:
+    case ElmtType::MECHANICSBBARELMT:
         MechanicsElmt::ComputeAll(calctype,nDim,nNodes,nDofs,t,dt,ctan,
                                   gpCoords,gpU,gpUold,gpV,gpVold,
                                   gpGradU,gpGradUold,gpGradV,gpGradVold,
@@ -67,9 +69,108 @@ void BulkElmtSystem::RunBulkElmtLibs(const FECalcType &calctype,const ElmtType &
                                       test,trial,grad_test,grad_trial,
                                       Mate,MateOld,gpProj,localK,localR);
         break;
+    case ElmtType::USER1ELMT:
+        User1Elmt::ComputeAll(calctype,nDim,nNodes,nDofs,t,dt,ctan,
+                              gpCoords,gpU,gpUold,gpV,gpVold,
+                              gpGradU,gpGradUold,gpGradV,gpGradVold,
+                              test,trial,grad_test,grad_trial,
+                              Mate,MateOld,gpProj,localK,localR);
+        break;
     default:
         MessagePrinter::PrintErrorTxt("unsupported element type in ElmtSystem, please check your code or your input file");
         MessagePrinter::AsFem_Exit();
         break;
     }
-}
\ No newline at end of file
+}
+//****************************************************************************
+BulkElmtQpKernel BulkElmtSystem::GetBulkElmtQpKernel(const ElmtType &elmttype,const int &nDim,const int &nNodes)const{
+    switch (elmttype){
+    case ElmtType::POISSONELMT:
+        return SelectBulkElmtQpKernel<PoissonElmtKernelT>(nDim,nNodes);
+    case ElmtType::MECHANICSELMT:
+    case ElmtType::MECHANICSRIELMT:
+        return SelectBulkElmtQpKernel<MechanicsElmtKernelT>(nDim,nNodes);
+    default:
+        return nullptr;
+    }
+}
+//****************************************************************************
+BulkElmtBatchKernel BulkElmtSystem::GetBulkElmtBatchKernel(const ElmtType &elmttype,const int &nDim,const int &nNodes)const{
+    switch (elmttype){
+    case ElmtType::MECHANICSELMT:
+        return SelectBulkElmtBatchKernel<MechanicsElmtBatchKernelT>(nDim,nNodes);
+    default:
+        return nullptr;
+    }
+}
+//****************************************************************************
+vector<int> BulkElmtSystem::GetBulkElmtCouplingMask(const ElmtType &elmttype,const int &nDofs)const{
+    // all the dofs are coupled by default, only the elements with the known zero blocks are listed here.
+    // for now this is only the time derivative element: the other multi-dof kernels fill every block
+    // (mechanics: the full C_ijkl, cahnhilliard: c<->mu, miehefrac: d<->u), and the coupled
+    // thermal/diffusion-mechanics elements have no kernel yet, add their masks once they are implemented
+    vector<int> mask(nDofs*nDofs,1);
+    switch (elmttype){
+    case ElmtType::TIMEDERIVELMT:
+        // each dof only depends on its own rate
+        for(int i=0;i<nDofs;i++){
+            for(int j=0;j<nDofs;j++) mask[i*nDofs+j]=(i==j)?1:0;
+        }
+        break;
+    default:
+        break;
+    }
+    return mask;
+}
+//****************************************************************************
+vector<int> BulkElmtSystem::GetBulkElmtDofCouplingMask(const vector<int> &blockIndexList,const int &nDofsPerNode)const{
+    vector<int> mask(nDofsPerNode*nDofsPerNode,0),subMask;
+    int i,j,nDofs;
+    for(i=0;i<nDofsPerNode;i++) mask[i*nDofsPerNode+i]=1;
+    for(const int &iblock:blockIndexList){
+        const ElmtBlock &elmtBlock=GetIthBulkElmtBlock(iblock);
+        nDofs=elmtBlock._nDofs;
+        subMask=GetBulkElmtCouplingMask(elmtBlock._ElmtType,nDofs);
+        for(i=0;i<nDofs;i++){
+            for(j=0;j<nDofs;j++){
+                if(subMask[i*nDofs+j]){
+                    mask[(elmtBlock._DofsIDList[i]-1)*nDofsPerNode+elmtBlock._DofsIDList[j]-1]=1;
+                }
+            }
+        }
+    }
+    return mask;
+}
+//****************************************************************************
+void BulkElmtSystem::PrepareBulkElmtBatch(const ElmtType &elmttype,const int &nDim,
+                                          const vector<double> &gpJxW,BulkMateBatch &batch){
+    switch (elmttype){
+    case ElmtType::MECHANICSBBARELMT:
+        MechanicsReducedElmt::ModifyBBarGradU(nDim,gpJxW,batch);
+        break;
+    default:
+        break;
+    }
+}
+//****************************************************************************
+void BulkElmtSystem::RunBulkElmtLibsOnElmt(const FECalcType &calctype,const ElmtType &elmttype,
+                                           const int &nDim,const int &nNodes,const int &nDofsPerNode,
+                                           const vector<int> &localDofIndex,const double (&ctan)[2],
+                                           const double &hgcoef,
+                                           const Nodes &elNodes,const vector<double> &elU,
+                                           const int &nQp,const int &nMaxNodes,
+                                           const vector<double> &gpJxW,const vector<Vector3d> &gpShpGrad,
+                                           const Materials *gpMates,ElmtMatrixXd &localK,ElmtVectorXd &localR){
+    switch (elmttype){
+    case ElmtType::MECHANICSRIELMT:
+        MechanicsReducedElmt::ComputeHourglass(calctype,nDim,nNodes,nDofsPerNode,localDofIndex,hgcoef,ctan[0],
+                                               elNodes,elU,nQp,nMaxNodes,gpJxW,gpShpGrad,gpMates,localK,localR);
+        break;
+    case ElmtType::MECHANICSBBARELMT:
+        MechanicsReducedElmt::ComputeBBar(calctype,nDim,nNodes,nDofsPerNode,localDofIndex,ctan[0],
+                                          nQp,nMaxNodes,gpJxW,gpShpGrad,gpMates,localK,localR);
+        break;
+    default:
+        break;
+    }
+}
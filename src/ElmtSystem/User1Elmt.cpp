@@ -10,95 +10,101 @@
 //+++ Author : Yang Bai
 //+++ Date   : 2021.01.18
 //+++ Purpose: implement the residual and jacobian for User-Defined-element
-//+++          1) dc/dt=div(D*grad(c))
-//+++          2) div(\Sigma)=0
-//+++          this is used for testing purpose
+//+++          dc/dt=div(D*(1+c^2)*grad(c))
+//+++          the jacobian is derived from the residual by the
+//+++          forward mode automatic differentiation
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-#include "ElmtSystem/BulkElmtSystem.h"
+#include "ElmtSystem/User1Elmt.h"
 
-void BulkElmtSystem::User1Elmt(const FECalcType &calctype, const int &nDim, const int &nNodes, const int &nDofs,
-                               const double &t, const double &dt, const double (&ctan)[2], const Vector3d &gpCoords,
-                               const vector<double> &gpU, const vector<double> &gpV, const vector<Vector3d> &gpGradU,
-                               const vector<Vector3d> &gpGradV, const double &test, const double &trial,
-                               const Vector3d &grad_test, const Vector3d &grad_trial,
-                               const ScalarMateType &ScalarMaterials, const VectorMateType &VectorMaterials,
-                               const Rank2MateType &Rank2Materials, const Rank4MateType &Rank4Materials,
-                               vector<double> &gpHist, vector<double> &gpHistOld,map<string,double> &gpProj,
-                               MatrixXd &localK, VectorXd &localR) {
-    //*******************************************************
-    //*** to get rid of the warning for unused variables  ***
-    //*** for normal users, you dont need to do this      ***
-    //*******************************************************
-    if(nDim||nNodes||nDofs||t||dt||ctan[0]||gpCoords(1)||gpU.size()||gpV.size()||
-       gpGradU.size()||gpGradV.size()||test||trial||grad_test(1)||grad_trial(1)||
-       ScalarMaterials.size()||VectorMaterials.size()||Rank2Materials.size()||Rank4Materials.size()||
-       gpHist.size()||gpHistOld.size()||gpProj.size()){}
-
-    // Dofs: C -->1
-    //       ux-->2
-    //       uy-->3
-    //       uz-->4
-    double D=ScalarMaterials.at("D");
-    switch (calctype){
-        case FECalcType::ComputeResidual:
-            // For R_d
-            localR(1)=gpV[1]*test+D*(gpGradU[1]*grad_test);
-            // For R_ux
-            localR(2)=Rank2Materials.at("stress").IthRow(1)*grad_test;
-            // For R_uy
-            localR(3)=Rank2Materials.at("stress").IthRow(2)*grad_test;
-            if(nDim==3){
-                // For R_uz
-                localR(4)=Rank2Materials.at("stress").IthRow(3)*grad_test;
-            }
-            break;
-        case FECalcType::ComputeJacobian:
-            // K_c,c
-            localK(1,1)=trial*test*ctan[1]+D*(grad_trial*grad_test)*ctan[0];
-            localK(1,2)=0.0;localK(1,3)=0.0;
-            //*******************************
-            // K_ux,c
-            localK(2,1)=0.0;
-            // K_ux,ux
-            localK(2,2)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(1,1,grad_test,grad_trial)*ctan[0];
-            // K_ux,uy
-            localK(2,3)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(1,2,grad_test,grad_trial)*ctan[0];
-
-            // K_uy,c
-            localK(3,1)=0.0;
-            // K_uy,uy
-            localK(3,3)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(2,2,grad_test,grad_trial)*ctan[0];
-            // K_uy,ux
-            localK(3,2)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(2,1,grad_test,grad_trial)*ctan[0];
-            if(nDim==3){
-                // K_ux,uz
-                localK(2,4)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(1,3,grad_test,grad_trial)*ctan[0];
+void User1Elmt::ComputeAll(const FECalcType &calctype, const int &nDim, const int &nNodes, const int &nDofs,
+                           const double &t, const double &dt, const double (&ctan)[2], const Vector3d &gpCoords,
+                           const vector<double> &gpU, const vector<double> &gpUold, const vector<double> &gpV,
+                           const vector<double> &gpVold, const vector<Vector3d> &gpGradU,
+                           const vector<Vector3d> &gpGradUold, const vector<Vector3d> &gpGradV,
+                           const vector<Vector3d> &gpGradVold, const double &test, const double &trial,
+                           const Vector3d &grad_test, const Vector3d &grad_trial, const Materials &Mate,
+                           const Materials &MateOld, map<string, double> &gpProj, MatrixXd &localK,
+                           VectorXd &localR) {
+    if(calctype==FECalcType::ComputeResidual){
+        ComputeResidual(nDim,nNodes,nDofs,t,dt,gpCoords,gpU,gpUold,gpV,gpVold,gpGradU,gpGradUold,gpGradV,gpGradVold,test,grad_test,
+                        Mate,MateOld,localR);
+    }
+    else if(calctype==FECalcType::ComputeJacobian){
+        ComputeJacobian(nDim,nNodes,nDofs,t,dt,ctan,gpCoords,gpU,gpUold,gpV,gpVold,gpGradU,gpGradUold,gpGradV,gpGradVold,
+                        test,trial,grad_test,grad_trial,Mate,MateOld,localK);
+    }
+    else if(calctype==FECalcType::Projection){
+        ComputeProjection(nDim,nNodes,nDofs,t,dt,ctan,gpCoords,gpU,gpUold,gpV,gpVold,gpGradU,gpGradUold,gpGradV,gpGradVold,
+                          test,grad_test,Mate,MateOld,gpProj);
+    }
+    else{
+        MessagePrinter::PrintErrorTxt("unsupported calculation type in User1Elmt, please check your related code");
+        MessagePrinter::AsFem_Exit();
+    }
+}
+//****************************************************************
+void User1Elmt::ComputeResidual(const int &nDim, const int &nNodes, const int &nDofs, const double &t,
+                                const double &dt, const Vector3d &gpCoords, const vector<double> &gpU,
+                                const vector<double> &gpUold, const vector<double> &gpV,
+                                const vector<double> &gpVold, const vector<Vector3d> &gpGradU,
+                                const vector<Vector3d> &gpGradUold, const vector<Vector3d> &gpGradV,
+                                const vector<Vector3d> &gpGradVold, const double &test, const Vector3d &grad_test,
+                                const Materials &Mate, const Materials &MateOld, VectorXd &localR) {
+    //***********************************************************
+    //*** get rid of unused warning
+    //***********************************************************
+    if(nDim||nNodes||nDofs||t||dt||gpCoords(1)||gpU[0]||gpUold[0]||gpV[0]||gpVold[0]||
+       gpGradU[0](1)||gpGradUold[0](1)||gpGradV[0](1)||gpGradVold[0](1)||
+       test||grad_test(1)||
+       Mate.ScalarMaterials.size()||MateOld.ScalarMaterials.size()){}
 
-                // K_uy,uz
-                localK(3,4)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(2,3,grad_test,grad_trial)*ctan[0];
+    const double D=Mate.ScalarMaterials.at("D");
+    ADComputeElmtResidual(nDofs,gpU,gpV,gpGradU,gpGradV,
+                          [&](const auto &U,const auto &V,const auto &GradU,const auto &GradV,auto &R){
+                              ComputeUserResidual(D,test,grad_test,U,V,GradU,GradV,R);
+                          },
+                          localR);
+}
+//****************************************************************************
+void User1Elmt::ComputeJacobian(const int &nDim, const int &nNodes, const int &nDofs, const double &t,
+                                const double &dt, const double (&ctan)[2], const Vector3d &gpCoords,
+                                const vector<double> &gpU, const vector<double> &gpUold, const vector<double> &gpV,
+                                const vector<double> &gpVold, const vector<Vector3d> &gpGradU,
+                                const vector<Vector3d> &gpGradUold, const vector<Vector3d> &gpGradV,
+                                const vector<Vector3d> &gpGradVold, const double &test, const double &trial,
+                                const Vector3d &grad_test, const Vector3d &grad_trial, const Materials &Mate,
+                                const Materials &MateOld, MatrixXd &localK) {
+    //***********************************************************
+    //*** get rid of unused warning
+    //***********************************************************
+    if(nDim||nNodes||nDofs||t||dt||ctan[0]||gpCoords(1)||gpU[0]||gpUold[0]||gpV[0]||gpVold[0]||
+       gpGradU[0](1)||gpGradUold[0](1)||gpGradV[0](1)||gpGradVold[0](1)||
+       test||trial||grad_test(1)||grad_trial(1)||
+       Mate.VectorMaterials.size()||MateOld.ScalarMaterials.size()){}
 
-                // K_uz,c
-                localK(4,1)=0.0;
-                // K_uz,uz
-                localK(4,4)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(3,3,grad_test,grad_trial)*ctan[0];
-                // K_uz,ux
-                localK(4,2)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(3,1,grad_test,grad_trial)*ctan[0];
-                // K_uz,uy
-                localK(4,3)=Rank4Materials.at("elasticity_tensor").GetIKjlComponent(3,2,grad_test,grad_trial)*ctan[0];
-            }
-            break;
-        case FECalcType::InitHistoryVariable:
-            fill(gpHist.begin(),gpHist.end(),0.0);
-            break;
-        case FECalcType::UpdateHistoryVariable:
-            gpHistOld=gpHist;
-            break;
-        case FECalcType::Projection:
-            break;
-        default:
-            MessagePrinter::PrintErrorTxt("unsupported FEM calculation type in User1 element");
-            MessagePrinter::AsFem_Exit();
-            break;
-    }
-}
\ No newline at end of file
+    // K_IJ is the derivative of the same residual along the trial function of the J-th dof
+    const double D=Mate.ScalarMaterials.at("D");
+    ADComputeElmtJacobian(nDofs,ctan,gpU,gpV,gpGradU,gpGradV,trial,grad_trial,
+                          [&](const auto &U,const auto &V,const auto &GradU,const auto &GradV,auto &R){
+                              ComputeUserResidual(D,test,grad_test,U,V,GradU,GradV,R);
+                          },
+                          localK);
+}
+//**************************************************************************
+void User1Elmt::ComputeProjection(const int &nDim, const int &nNodes, const int &nDofs, const double &t,
+                                  const double &dt, const double (&ctan)[2], const Vector3d &gpCoords,
+                                  const vector<double> &gpU, const vector<double> &gpUold,
+                                  const vector<double> &gpV, const vector<double> &gpVold,
+                                  const vector<Vector3d> &gpGradU, const vector<Vector3d> &gpGradUold,
+                                  const vector<Vector3d> &gpGradV, const vector<Vector3d> &gpGradVold,
+                                  const double &test, const Vector3d &grad_test, const Materials &Mate,
+                                  const Materials &MateOld, map<string, double> &gpProj) {
+    //***********************************************************
+    //*** get rid of unused warning
+    //***********************************************************
+    if(nDim||nNodes||nDofs||t||dt||ctan[0]||gpCoords(1)||gpU[0]||gpUold[0]||gpV[0]||gpVold[0]||
+       gpGradU[0](1)||gpGradUold[0](1)||gpGradV[0](1)||gpGradVold[0](1)||
+       test||grad_test(1)||gpProj.size()||
+       Mate.VectorMaterials.size()||MateOld.ScalarMaterials.size()){}
+}
@@ -24,15 +24,34 @@ void EquationSystem::CreateSparsityPattern(DofHandler &dofHandler){
     int eStart=rank*rankne;
     int eEnd=(rank+1)*rankne;
     if(rank==size-1) eEnd=dofHandler.GetBulkElmtNums();
-    int nDofs;
-    double localK[270];
-    int conn[27];
-    for(int i=0;i<270;++i){localK[i]=0.0;}
+    int nDofs,nNodes,nDofsPerNode,i,j,k,l,nCols;
+    vector<int> conn(dofHandler.GetMaxDofsNumPerBulkElmt(),0),cols(dofHandler.GetMaxDofsNumPerBulkElmt(),0);
+    vector<double> localK(dofHandler.GetMaxDofsNumPerBulkElmt()*dofHandler.GetMaxDofsNumPerBulkElmt(),0.0);
+    vector<double> activeFlag(dofHandler.GetMaxDofsNumPerBulkElmt(),0.0);
 
     for(int e=eStart;e<eEnd;++e){
-        dofHandler.GetIthBulkElmtDofIndex0(e+1,conn);
+        dofHandler.GetIthBulkElmtDofIndex0(e+1,conn,activeFlag);
         nDofs=dofHandler.GetIthBulkElmtDofsNum(e+1);
-        MatSetValues(_AMATRIX,nDofs,conn,nDofs,conn,localK,ADD_VALUES);
+        const vector<int> &mask=dofHandler.GetIthBulkElmtDofCouplingMask(e+1);
+        if(mask.empty()){
+            MatSetValues(_AMATRIX,nDofs,conn.data(),nDofs,conn.data(),localK.data(),ADD_VALUES);
+        }
+        else{
+            // only the coupled dofs of each row, the structurally zero blocks are not allocated
+            nDofsPerNode=dofHandler.GetDofsNumPerNode();
+            nNodes=nDofs/nDofsPerNode;
+            for(i=0;i<nNodes;i++){
+                for(k=0;k<nDofsPerNode;k++){
+                    nCols=0;
+                    for(j=0;j<nNodes;j++){
+                        for(l=0;l<nDofsPerNode;l++){
+                            if(mask[k*nDofsPerNode+l]) cols[nCols++]=conn[j*nDofsPerNode+l];
+                        }
+                    }
+                    MatSetValues(_AMATRIX,1,&conn[i*nDofsPerNode+k],nCols,cols.data(),localK.data(),ADD_VALUES);
+                }
+            }
+        }
     }
     MatAssemblyBegin(_AMATRIX,MAT_FINAL_ASSEMBLY);
     MatAssemblyEnd(_AMATRIX,MAT_FINAL_ASSEMBLY);
@@ -25,6 +25,11 @@ FE::FE(){
     _SurfaceQPoint.SetQPointType(QPointType::GAUSSLEGENDRE);
     _LineQPoint.SetQPointType(QPointType::GAUSSLEGENDRE);
     _nBulkQpOrder=1;_nBCQpOrder=1;
+    _BulkMeshType=MeshType::NULLTYPE;
+    _BulkMeshTypeList.clear();
+    _BulkShpList.clear();
+    _BulkQPointRuleList.clear();
+    _BulkQPointList.clear();
 }
 //**********************************************
 void FE::SetQPointType(QPointType qptype){
@@ -46,6 +51,14 @@ void FE::SetBCQpOrder(int order){
 //******************************************************
 void FE::CreateQPoints(Mesh &mesh){
     if(_HasDimSet){
+        _BulkMeshType=mesh.GetBulkMeshBulkElmtType();
+        // the default bulk mesh type is always the first one, so _BulkShp and _BulkQPoint
+        // are the same as the 1st entries of the lists
+        _BulkMeshTypeList.clear();
+        _BulkMeshTypeList.push_back(_BulkMeshType);
+        for(const auto &it:mesh.GetBulkMeshBulkElmtTypeList()){
+            if(it!=_BulkMeshType) _BulkMeshTypeList.push_back(it);
+        }
         if(GetDim()==1){
             _BulkQPoint.SetDim(1);
             _BulkQPoint.CreateQpoints(mesh.GetBulkMeshBulkElmtType());
@@ -67,12 +80,67 @@ void FE::CreateQPoints(Mesh &mesh){
             _LineQPoint.SetDim(1);
             _LineQPoint.CreateQpoints(mesh.GetBulkMeshLineElmtType());
         }
+        // rebuild the qpoints of all the rules for all the bulk mesh types
+        if(_BulkQPointRuleList.size()<1){
+            _BulkQPointRuleList.push_back(make_pair(_BulkQPoint.GetQpPointType(),_BulkQPoint.GetQpOrder()));
+        }
+        else{
+            _BulkQPointRuleList[0]=make_pair(_BulkQPoint.GetQpPointType(),_BulkQPoint.GetQpOrder());
+        }
+        _BulkQPointList.clear();
+        for(const auto &rule:_BulkQPointRuleList){
+            for(const auto &meshtype:_BulkMeshTypeList){
+                _BulkQPointList.push_back(CreateBulkQPoint(rule.first,rule.second,meshtype));
+            }
+        }
     }
     else{
         MessagePrinter::PrintErrorTxt("can\'t create qpoints for FE space, the dim has not been given yet");
         MessagePrinter::AsFem_Exit();
     }
 }
+//******************************************************
+QPoint FE::CreateBulkQPoint(const QPointType &qptype,const int &order,const MeshType &meshtype)const{
+    QPoint qpoint;
+    qpoint.SetQPointType(qptype);
+    qpoint.SetQPointOrder(order);
+    qpoint.SetDim(GetDim());
+    qpoint.CreateQpoints(meshtype);
+    return qpoint;
+}
+//******************************************************
+int FE::AddBulkQPoint(const QPointType &qptype,const int &order){
+    if(qptype==_BulkQPoint.GetQpPointType()&&order==_BulkQPoint.GetQpOrder()){
+        return 1;
+    }
+    for(int i=1;i<static_cast<int>(_BulkQPointRuleList.size());i++){
+        if(_BulkQPointRuleList[i].first==qptype&&_BulkQPointRuleList[i].second==order){
+            return i+1;
+        }
+    }
+    _BulkQPointRuleList.push_back(make_pair(qptype,order));
+    for(const auto &meshtype:_BulkMeshTypeList){
+        _BulkQPointList.push_back(CreateBulkQPoint(qptype,order,meshtype));
+    }
+    return static_cast<int>(_BulkQPointRuleList.size());
+}
+//******************************************************
+int FE::GetMaxBulkQpPointsNum()const{
+    int nmax=_BulkQPoint.GetQpPointsNum();
+    for(const auto &it:_BulkQPointList){
+        if(it.GetQpPointsNum()>nmax) nmax=it.GetQpPointsNum();
+    }
+    return nmax;
+}
+//******************************************************
+int FE::GetBulkMeshTypeIndex(const MeshType &meshtype)const{
+    for(int i=0;i<static_cast<int>(_BulkMeshTypeList.size());i++){
+        if(_BulkMeshTypeList[i]==meshtype) return i+1;
+    }
+    MessagePrinter::PrintErrorTxt("the bulk mesh type is not found in the FE space, please check your mesh");
+    MessagePrinter::AsFem_Exit();
+    return 0;
+}
 //**************************************************************************
 //*** for shape function related functions
 //**************************************************************************
@@ -83,6 +151,12 @@ void FE::CreateShapeFuns(Mesh &mesh){
     _BulkShp=ShapeFun(mesh.GetBulkMeshDim(),mesh.GetBulkMeshBulkElmtType());
     _BulkShp.PreCalc();
 
+    _BulkShpList.clear();
+    for(const auto &meshtype:_BulkMeshTypeList){
+        _BulkShpList.push_back(ShapeFun(mesh.GetBulkMeshDim(),meshtype));
+        _BulkShpList.back().PreCalc();
+    }
+
     _BulkNodes=Nodes(mesh.GetBulkMeshNodesNumPerBulkElmt());
     if(GetDim()==3){
         _SurfaceShp=ShapeFun(2,mesh.GetBulkMeshSurfaceElmtType());
@@ -141,5 +215,16 @@ void FE::PrintFEInfo()const{
            +", num of qpoints="+to_string(_SurfaceQPoint.GetQpPointsNum());
         MessagePrinter::PrintNormalTxt(msg);
     }
+    if(_BulkMeshTypeList.size()>1){
+        msg="  bulk mesh types="+to_string(_BulkMeshTypeList.size())+", each one has its own shape functions";
+        MessagePrinter::PrintNormalTxt(msg);
+    }
+    for(int i=1;i<static_cast<int>(_BulkQPointRuleList.size());i++){
+        msg="  for [elmts] blocks: type=";
+        msg+=(_BulkQPointRuleList[i].first==QPointType::GAUSSLEGENDRE)?"Gauss-Legendre":"Gauss-Lobatto";
+        msg+=", order="+to_string(_BulkQPointRuleList[i].second)
+            +", num of qpoints="+to_string(GetBulkQpPointsNum(i+1,1));
+        MessagePrinter::PrintNormalTxt(msg);
+    }
     MessagePrinter::PrintDashLine();
 }
\ No newline at end of file
@@ -32,5 +32,6 @@ void FEProblem::Finalize(){
         _equationSystem.ReleaseMem();
         _nonlinearSolver.ReleaseMem();
         _timestepping.ReleaseMem();
+        _feSystem.ReleaseMem();
     }
 }
\ No newline at end of file
@@ -39,6 +39,7 @@ void FEProblem::InitAllComponents(){
     //*** for boundary condition system initializing
     //***************************************************************
     _elmtSystem.InitBulkElmtMateInfo(_mateSystem);// set mate index for each elmt block
+    _elmtSystem.InitBulkElmtQPointInfo(_fe);// set qpoint rule for each elmt block
     _mateSystem.InitBulkMateSystem();// clean all the materials variables
     _bcSystem.InitBCSystem(_mesh);
     if(!_bcSystem.CheckAppliedBCNameIsValid(_mesh)){
@@ -94,7 +95,7 @@ void FEProblem::InitAllComponents(){
     _solutionSystem.SetHistNumPerGPoint(10);
     _solutionSystem.InitSolution(_dofHandler.GetActiveDofsNum(),
                             _mesh.GetBulkMeshBulkElmtsNum(),_mesh.GetBulkMeshNodesNum(),
-                            _fe._BulkQPoint.GetQpPointsNum());
+                            _fe.GetMaxBulkQpPointsNum());
     
     if(_rank==0){
         _TimerEnd=chrono::high_resolution_clock::now();
@@ -175,7 +176,11 @@ void FEProblem::InitAllComponents(){
     if(_rank==0){
         _TimerStart=chrono::high_resolution_clock::now();
     }
-    _feSystem.InitBulkFESystem(_mesh,_dofHandler,_fe,_solutionSystem);
+    _feSystem.InitBulkFESystem(_mesh,_dofHandler,_elmtSystem,_fe,_solutionSystem);
+    _feSystem.SetMateCacheOption(_feJobBlock._UseMateCache,_feJobBlock._MateCacheMemMB);
+    _feSystem.SetElmtBatchOption(_feJobBlock._UseElmtBatch);
+    _feSystem.SetFusedAssemblyOption(_feJobBlock._UseFusedAssembly);
+    _nonlinearSolver.SetLoadSteppingOption(_feJobBlock._nLoadSteps,_feJobBlock._UseArcLength,_feJobBlock._MaxCutbacks);
     if(_rank==0){
         _TimerEnd=chrono::high_resolution_clock::now();
         _Duration=Duration(_TimerStart,_TimerEnd);
@@ -20,7 +20,28 @@ void FEProblem::RunStaticAnalysis(){
         _TimerStart=chrono::high_resolution_clock::now();
     }
 
-    if(_nonlinearSolver.Solve(_mesh,_dofHandler,_elmtSystem,_mateSystem,
+    if(_nonlinearSolver.IsLoadSteppingEnabled()){
+        // the results of each load step are written by the load stepping itself
+        if(_nonlinearSolver.SolveLoadSteps(_mesh,_dofHandler,_elmtSystem,_mateSystem,
+            _bcSystem,_icSystem,
+            _solutionSystem,_equationSystem,
+            _fe,_feSystem,
+            _outputSystem,_postprocessSystem,
+            _feCtrlInfo)){
+            if(_rank==0){
+                _TimerEnd=chrono::high_resolution_clock::now();
+                _Duration=Duration(_TimerStart,_TimerEnd);
+            }
+            char buff[70];
+            snprintf(buff,70,"Static load stepping finished! [elapse time=%14.6e]",_Duration);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
+        else{
+            MessagePrinter::PrintNormalTxt("Static load stepping failed, try more loadsteps or arclength=true in [job] block");
+            MessagePrinter::AsFem_Exit();
+        }
+    }
+    else if(_nonlinearSolver.Solve(_mesh,_dofHandler,_elmtSystem,_mateSystem,
         _bcSystem,_icSystem,
         _solutionSystem,_equationSystem,
         _fe,_feSystem,_feCtrlInfo)){
@@ -32,6 +53,7 @@ void FEProblem::RunStaticAnalysis(){
         snprintf(buff,70,"Static analysis finished! [elapse time=%14.6e]",_Duration);
         str=buff;
         MessagePrinter::PrintNormalTxt(str);
+        _feSystem.PrintActiveSetSummary();
         if(_feCtrlInfo.IsProjection){
             _feSystem.FormBulkFE(FECalcType::Projection,_feCtrlInfo.dt,_feCtrlInfo.dt,_feCtrlInfo.ctan,
                 _mesh,_dofHandler,_fe,_elmtSystem,_mateSystem,
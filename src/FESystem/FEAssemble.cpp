@@ -15,18 +15,19 @@
 
 #include "FESystem/FESystem.h"
 
-void FESystem::AssembleSubResidualToLocalResidual(const int &ndofspernode,const int &dofs,const int &iInd,
-                                            const VectorXd &subR,VectorXd &localR){
-    // TODO: we need a better assemble algorithm for complex coupling case !!!
-    for(int i=1;i<=dofs;i++){
-        localR((iInd-1)*ndofspernode+i)+=subR(i);
+void FESystem::AssembleSubResidualToLocalResidual(const int &ndofspernode,const vector<int> &localDofIndex,const int &iInd,
+                                            const VectorXd &subR,ElmtVectorXd &localR){
+    // the i-th dof of the sub element is the localDofIndex[i-1]-th dof of the node
+    for(int i=1;i<=static_cast<int>(localDofIndex.size());i++){
+        localR((iInd-1)*ndofspernode+localDofIndex[i-1])+=subR(i);
     }
 }
 //***********************************
 void FESystem::AccumulateLocalResidual(const int &dofs,const vector<double> &dofsactiveflag,const double &JxW,
-                                const VectorXd &localR,vector<double> &sumR){
-    for(int i=1;i<=dofs;i++){
-        sumR[i-1]+=localR(i)*JxW*dofsactiveflag[i-1];
+                                const ElmtVectorXd &localR,vector<double> &sumR){
+    const double *r=localR.GetDataPtr();
+    for(int i=0;i<dofs;i++){
+        sumR[i]+=r[i]*JxW*dofsactiveflag[i];
     }
 }
 //*****************************************
@@ -35,29 +36,86 @@ void FESystem::AssembleLocalResidualToGlobalResidual(const int &ndofs,const vect
     VecSetValues(rhs,ndofs,dofindex.data(),residual.data(),ADD_VALUES);
 }
 //*************************************************************
-void FESystem::AssembleSubJacobianToLocalJacobian(const int &ndofspernode,
+void FESystem::AssembleSubJacobianToLocalJacobian(const int &ndofspernode,const vector<int> &localDofIndex,
+                                            const vector<int> &couplingMask,
                                             const int &iInd,const int &jInd,
-                                            const MatrixXd &subK,MatrixXd &localK){
-    for(int i=1;i<=ndofspernode;i++){
-        for(int j=1;j<=ndofspernode;j++){
-            localK((iInd-1)*ndofspernode+i,(jInd-1)*ndofspernode+j)+=subK(i,j);
+                                            const MatrixXd &subK,ElmtMatrixXd &localK){
+    // the structurally zero blocks(see BulkElmtSystem::GetBulkElmtCouplingMask) are skipped
+    const int dofs=static_cast<int>(localDofIndex.size());
+    for(int i=1;i<=dofs;i++){
+        for(int j=1;j<=dofs;j++){
+            if(!couplingMask[(i-1)*dofs+j-1]) continue;
+            localK((iInd-1)*ndofspernode+localDofIndex[i-1],(jInd-1)*ndofspernode+localDofIndex[j-1])+=subK(i,j);
         }
     }
 }
 void FESystem::AccumulateLocalJacobian(const int &dofs,const vector<double> &dofsactiveflag,const double &JxW,
-                                const MatrixXd &localK,vector<double> &sumK){
-    for(int i=1;i<=dofs;i++){
-        if(dofsactiveflag[i-1]>0.0){
-            for(int j=1;j<=dofs;j++){
-                sumK[(i-1)*dofs+j-1]+=localK(i,j)*JxW;
-                if(localK(i,j)*JxW>_MaxKMatrixValue) _MaxKMatrixValue=localK(i,j)*JxW;
+                                const ElmtMatrixXd &localK,vector<double> &sumK){
+    // the active part of localK is contiguous, the row stride is localK.GetN()
+    double val;
+    for(int i=0;i<dofs;i++){
+        if(dofsactiveflag[i]>0.0){
+            const double *k=localK.GetDataPtr()+i*localK.GetN();
+            double *sk=sumK.data()+i*dofs;
+            for(int j=0;j<dofs;j++){
+                val=k[j]*JxW;
+                sk[j]+=val;
+                if(val>_MaxKMatrixValue) _MaxKMatrixValue=val;
             }
         }
     }
 }
-void FESystem::AssembleLocalJacobianToGlobalJacobian(const int &ndofs,const vector<int> &dofindex,
+void FESystem::AssembleLocalJacobianToGlobalJacobian(const int &ndofs,const int &ndofspernode,const vector<int> &dofindex,
+                                            const vector<int> &dofCouplingMask,
                                             const vector<double> &jacobian,Mat &K){
-    MatSetValues(K,ndofs,dofindex.data(),ndofs,dofindex.data(),jacobian.data(),ADD_VALUES);
+    if(dofCouplingMask.empty()){
+        MatSetValues(K,ndofs,dofindex.data(),ndofs,dofindex.data(),jacobian.data(),ADD_VALUES);
+        return;
+    }
+    // only the coupled dofs of each row are inserted, they are the same as the sparsity pattern
+    // (see EquationSystem::CreateSparsityPattern), the other entries are never allocated
+    const int nnodes=ndofs/ndofspernode;
+    int i,j,k,l,ncols;
+    for(i=0;i<nnodes;i++){
+        for(k=0;k<ndofspernode;k++){
+            const double *row=jacobian.data()+(i*ndofspernode+k)*ndofs;
+            ncols=0;
+            for(j=0;j<nnodes;j++){
+                for(l=0;l<ndofspernode;l++){
+                    if(!dofCouplingMask[k*ndofspernode+l]) continue;
+                    _maskedCols[ncols]=dofindex[j*ndofspernode+l];
+                    _maskedVals[ncols]=row[j*ndofspernode+l];
+                    ncols+=1;
+                }
+            }
+            MatSetValues(K,1,&dofindex[i*ndofspernode+k],ncols,_maskedCols.data(),_maskedVals.data(),ADD_VALUES);
+        }
+    }
+}
+//**********************************************************************
+void FESystem::FlushBulkElmtBatch(const FECalcType &calctype,const BulkElmtBatchKernel &batchKernel,Mat &AMATRIX,Vec &RHS){
+    // the JxW is already included in the batch, the lanes are assembled one by one,
+    // so the active flags of each element are applied in the same way as the scalar path
+    BulkElmtBatch &elBatch=_elmtBatch;
+    if(elBatch.IsEmpty()) return;
+    batchKernel(calctype,elBatch);
+    for(int lane=0;lane<elBatch.GetLanesNum();lane++){
+        const vector<int> &laneDofs=elBatch.GetIthLaneDofs(lane);
+        const int nDofs=static_cast<int>(laneDofs.size());
+        if(calctype==FECalcType::ComputeResidual){
+            elBatch.GetIthLaneResidual(lane,_localR);
+            fill(_R.begin(),_R.begin()+nDofs,0.0);
+            AccumulateLocalResidual(nDofs,elBatch.GetIthLaneDofsActiveFlag(lane),1.0,_localR,_R);
+            AssembleLocalResidualToGlobalResidual(nDofs,laneDofs,_R,RHS);
+        }
+        else if(calctype==FECalcType::ComputeJacobian){
+            elBatch.GetIthLaneJacobian(lane,_localK);
+            fill(_K.begin(),_K.begin()+nDofs*nDofs,0.0);
+            AccumulateLocalJacobian(nDofs,elBatch.GetIthLaneDofsActiveFlag(lane),1.0,_localK,_K);
+            AssembleLocalJacobianToGlobalJacobian(nDofs,elBatch.GetIthLaneDofsPerNode(lane),laneDofs,elBatch.GetIthLaneDofCouplingMask(lane),_K,AMATRIX);
+        }
+    }
+    elBatch.Reset();
 }
 //**********************************************************************
 void FESystem::AssembleSubHistToLocal(const int &e,const int &ngp,const int &gpInd,const Materials &mate,SolutionSystem &solutionSystem){
@@ -29,6 +29,20 @@ FESystem::FESystem(){
     _MaterialValues.clear();
     _nHist=0;_nProj=0;
     _MaxKMatrixValue=-1.0e3;_KMatrixFactor=0.1;
+    _nElasticQpoints=0;_nInelasticQpoints=0;
 
     _localK.Clean();_localR.Clean();
-}
\ No newline at end of file
+}
+//**************************************************************
+void FESystem::PrintActiveSetSummary()const{
+    // the qpoint states reported by the materials in the last FormBulkFE call
+    int nlocal[2],nglobal[2];
+    nlocal[0]=_nElasticQpoints;nlocal[1]=_nInelasticQpoints;
+    MPI_Allreduce(nlocal,nglobal,2,MPI_INT,MPI_SUM,PETSC_COMM_WORLD);
+    if(nglobal[0]+nglobal[1]<1) return;// no material reports its state
+
+    char buff[70];
+    snprintf(buff,70,"  Active set: inelastic qpoints=%9d of %9d(%6.2f%%)",
+             nglobal[1],nglobal[0]+nglobal[1],100.0*nglobal[1]/(nglobal[0]+nglobal[1]));
+    MessagePrinter::PrintNormalTxt(string(buff));
+}
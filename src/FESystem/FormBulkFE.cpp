@@ -27,6 +27,10 @@ void FESystem::FormBulkFE(const FECalcType &calctype,const double &t,const doubl
     else if(calctype==FECalcType::ComputeJacobian){
         MatZeroEntries(AMATRIX);
     }
+    else if(calctype==FECalcType::ComputeResidualAndJacobian){
+        VecSet(RHS,0.0);
+        MatZeroEntries(AMATRIX);
+    }
     else if(calctype==FECalcType::Projection){
         VecSet(solutionSystem._Proj,0.0);
         VecSet(solutionSystem._ProjScalarMate,0.0);
@@ -75,103 +79,162 @@ void FESystem::FormBulkFE(const FECalcType &calctype,const double &t,const doubl
 
     PetscInt nDofs,nNodes,nDofsPerNode,nDofsPerSubElmt,e;
     PetscInt i,j,jj;
-    PetscInt nDim,gpInd;
-    PetscReal xi,eta,zeta,w,JxW,DetJac,elVolume;
+    PetscInt nDim,gpInd,nQp,qp;
+    bool IsElmtLevelOnly;
+    BulkElmtQpKernel qpKernel;
+    BulkElmtBatchKernel batchKernel;
+    PetscReal JxW,elVolume,shp;
     nDim=mesh.GetDim();
 
-    _BulkVolumes=0.0;
-    for(int ee=eStart;ee<eEnd;++ee){
-        e=ee+1;
-        mesh.GetBulkMeshIthBulkElmtNodes(e,_elNodes);
-        mesh.GetBulkMeshIthBulkElmtConn(e,_elConn);
-        dofHandler.GetIthBulkElmtDofIndex0(e,_elDofs,_elDofsActiveFlag);
-        nDofs=dofHandler.GetIthBulkElmtDofsNum(e);
-        nNodes=mesh.GetBulkMeshIthBulkElmtNodesNum(e);
-        nDofsPerNode=nDofs/nNodes;
-
-        // for the disp and velocity in current time step
-        VecGetValues(_Useq,nDofs,_elDofs.data(),_elU.data());
-        VecGetValues(_Vseq,nDofs,_elDofs.data(),_elV.data());
-        // for the disp and velocity in the previous time step
-        VecGetValues(_Uoldseq,nDofs,_elDofs.data(),_elUold.data());
-        VecGetValues(_Voldseq,nDofs,_elDofs.data(),_elVold.data());
-        
-        if(calctype==FECalcType::ComputeResidual){
-            fill(_R.begin(),_R.end(),0.0);
+    // the fused pass shares the geometry, the dofs and the materials of each element between the
+    // residual and the jacobian, the kernels themselves are still called once for each of them
+    const bool IsResidual=calctype==FECalcType::ComputeResidual||calctype==FECalcType::ComputeResidualAndJacobian;
+    const bool IsJacobian=calctype==FECalcType::ComputeJacobian||calctype==FECalcType::ComputeResidualAndJacobian;
+    // the finite difference and the explicit residual only contain a part of the kernels
+    const bool IsPartialPass=_IsFDResidualPass||_IsExplicitPass;
+    if((IsResidual||IsJacobian)&&!IsPartialPass) _IsFusedJacobianFilled=false;
+
+    // the material cache is filled by the residual pass and only read by the jacobian pass at the same iterate,
+    // the partial residual passes never touch it
+    bool FillMateCache=false,ReadMateCache=false;
+    if(_UseMateCache&&!IsPartialPass){
+        if(IsResidual){
+            FillMateCache=true;
+        }
+        else if(calctype==FECalcType::ComputeJacobian){
+            ReadMateCache=_IsMateCacheFilled&&_IsMateCacheReusable;
+        }
+        if(!ReadMateCache) _IsMateCacheFilled=false;
+        _IsMateCacheReusable=false;
+    }
+    // the elastic flags are filled by the residual pass, the jacobian pass of the same iterate uses them
+    // for the sub elements without the full material cache
+    bool FillElasticKernel=false,ReadElasticKernel=false;
+    if(!IsPartialPass){
+        if(IsResidual){
+            FillElasticKernel=true;
         }
         else if(calctype==FECalcType::ComputeJacobian){
-            fill(_K.begin(),_K.end(),0.0);
+            ReadElasticKernel=!ReadMateCache&&_IsElasticKernelListFilled&&_IsElasticKernelListReusable;
+        }
+        if(!ReadElasticKernel&&!ReadMateCache) _IsElasticKernelListFilled=false;
+        _IsElasticKernelListReusable=false;
+    }
+
+    _BulkVolumes=0.0;
+    _nElasticQpoints=0;_nInelasticQpoints=0;
+    // the local elements are grouped into the work batches, see InitBulkFESystem
+    for(const BulkElmtWorkBatch &workBatch:_elmtWorkBatchList){
+        if(_IsFDResidualPass&&find(workBatch._IsFDJacobianList.begin(),workBatch._IsFDJacobianList.end(),true)==workBatch._IsFDJacobianList.end()){
+            continue;// nothing to perturb in current batch
         }
-        else if(calctype==FECalcType::Projection){
-            for(auto &it:_gpProj) it.second=0.0;
+        if(_IsExplicitPass&&find(workBatch._IsExplicitList.begin(),workBatch._IsExplicitList.end(),true)==workBatch._IsExplicitList.end()){
+            continue;// no explicit kernel in current batch
         }
+        if(_HasFrozenKernel&&(IsResidual||IsJacobian)&&find(workBatch._IsFrozenList.begin(),workBatch._IsFrozenList.end(),false)==workBatch._IsFrozenList.end()){
+            continue;// all the kernels of current batch only act on the frozen dofs
+        }
+        // the shape functions and qpoint rule of current batch(mesh type),
+        // the history is always stored with the max qpoints number(_nGPoints)
+        ShapeFun &elShp=fe.GetBulkShp(workBatch._MeshTypeIndex);
+        QPoint &qpoint=fe.GetBulkQPoint(workBatch._QPointIndex,workBatch._MeshTypeIndex);
+        nQp=qpoint.GetQpPointsNum();
+        nNodes=workBatch._nNodes;
+        _mateBatch._nQp=nQp;
+
+        // the elements with a single batchable kernel are gathered into the element batch, they are
+        // assembled when the batch is flushed, not at the end of each element. Only the jacobian is
+        // batched, the residual kernel is too cheap to pay for the gather(see asfem-elmtbench), and
+        // the fused pass uses the scalar kernels
+        batchKernel=(_UseElmtBatch&&calctype==FECalcType::ComputeJacobian)?workBatch._BatchKernel:nullptr;
+        if(batchKernel!=nullptr&&(_elmtBatch._nDim!=nDim||_elmtBatch._nNodes!=nNodes)){
+            _elmtBatch.Init(nDim,nNodes,_nGPoints);
+        }
+
+        for(const int &ee:workBatch._ElmtList){
+            e=ee+1;
+            mesh.GetBulkMeshIthBulkElmtNodes(e,_elNodes);
+            mesh.GetBulkMeshIthBulkElmtConn(e,_elConn);
+            dofHandler.GetIthBulkElmtDofIndex0(e,_elDofs,_elDofsActiveFlag);
+            nDofs=dofHandler.GetIthBulkElmtDofsNum(e);
+            nDofsPerNode=nDofs/nNodes;
+
+            // for the disp and velocity in current time step
+            VecGetValues(_Useq,nDofs,_elDofs.data(),_elU.data());
+            VecGetValues(_Vseq,nDofs,_elDofs.data(),_elV.data());
+            // for the disp and velocity in the previous time step
+            VecGetValues(_Uoldseq,nDofs,_elDofs.data(),_elUold.data());
+            VecGetValues(_Voldseq,nDofs,_elDofs.data(),_elVold.data());
         
-        xi=0.0;eta=0.0;zeta=0.0;DetJac=1.0;w=1.0;
-        elVolume=0.0;
-        for(gpInd=1;gpInd<=fe._BulkQPoint.GetQpPointsNum();++gpInd){
-            // init all the local K&R array/matrix
-            // get local history(old) value on each gauss point
-            if(calctype!=FECalcType::InitMaterialAndProjection){
-                mateSystem.GetMaterialsOldPtr().ScalarMaterials=solutionSystem._ScalarMaterialsOld[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1];
-                mateSystem.GetMaterialsOldPtr().VectorMaterials=solutionSystem._VectorMaterialsOld[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1];
-                mateSystem.GetMaterialsOldPtr().Rank2Materials=solutionSystem._Rank2TensorMaterialsOld[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1];
-                mateSystem.GetMaterialsOldPtr().Rank4Materials=solutionSystem._Rank4TensorMaterialsOld[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1];
-            }
-            // calculate the current shape funs on each gauss point
-            if(nDim==1){
-                w =fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,0);
-                xi=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,1);
-                fe._BulkShp.Calc(xi,_elNodes,true);
-                DetJac=fe._BulkShp.GetDetJac();
-            }
-            else if(nDim==2){
-                w  =fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,0);
-                xi =fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,1);
-                eta=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,2);
-                fe._BulkShp.Calc(xi,eta,_elNodes,true);
-                DetJac=fe._BulkShp.GetDetJac();
-            }
-            else if(nDim==3){
-                w   =fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,0);
-                xi  =fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,1);
-                eta =fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,2);
-                zeta=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,3);
-                fe._BulkShp.Calc(xi,eta,zeta,_elNodes,true);
-                DetJac=fe._BulkShp.GetDetJac();
-            }
-            JxW=w*DetJac;
-            elVolume+=1.0*JxW;
-            // calculate the coordinate of current gauss point
-            _gpCoord(1)=0.0;_gpCoord(2)=0.0;_gpCoord(3)=0.0;
-            for(i=1;i<=nNodes;++i){
-                _gpCoord(1)+=_elNodes(i,1)*fe._BulkShp.shape_value(i);
-                _gpCoord(2)+=_elNodes(i,2)*fe._BulkShp.shape_value(i);
-                _gpCoord(3)+=_elNodes(i,3)*fe._BulkShp.shape_value(i);
-            }
-            
-            
-            if(calctype==FECalcType::ComputeResidual){
-                _localR.setZero();
-            }
-            else if(calctype==FECalcType::ComputeJacobian){
-                _localK.setZero();
-            }
-            else if(calctype==FECalcType::Projection){
-                for(auto &it:_gpProj) it.second=0.0;
-            }
-            else if(calctype==FECalcType::InitHistoryVariable||calctype==FECalcType::UpdateHistoryVariable){
-                for(auto &it:solutionSystem._ScalarMaterials[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1]) it.second=0.0;
-                for(auto &it:solutionSystem._VectorMaterials[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1]) it.second=0.0;
-                for(auto &it:solutionSystem._Rank2TensorMaterials[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1]) it.second=0.0;
-                for(auto &it:solutionSystem._Rank4TensorMaterials[(e-1)*fe._BulkQPoint.GetQpPointsNum()+gpInd-1]) it.second=0.0;
-            }
+            // only the active part(nDofs) of the local arrays is used by current element
+            _localK.Resize(nDofs,nDofs);
+            _localR.Resize(nDofs);
+            if(IsResidual) fill(_R.begin(),_R.begin()+nDofs,0.0);
+            if(IsJacobian) fill(_K.begin(),_K.begin()+nDofs*nDofs,0.0);
+
+            //*****************************************************
+            //*** 1) the geometry and the history of all the qpoints
+            //*****************************************************
+            elVolume=0.0;
+            for(gpInd=1;gpInd<=nQp;++gpInd){
+                qp=gpInd-1;
+                // get local history(old) value on each gauss point
+                if(calctype!=FECalcType::InitMaterialAndProjection){
+                    _mateBatch._MatesOld[qp].ScalarMaterials=solutionSystem._ScalarMaterialsOld[(e-1)*_nGPoints+qp];
+                    _mateBatch._MatesOld[qp].VectorMaterials=solutionSystem._VectorMaterialsOld[(e-1)*_nGPoints+qp];
+                    _mateBatch._MatesOld[qp].Rank2Materials=solutionSystem._Rank2TensorMaterialsOld[(e-1)*_nGPoints+qp];
+                    _mateBatch._MatesOld[qp].Rank4Materials=solutionSystem._Rank4TensorMaterialsOld[(e-1)*_nGPoints+qp];
+                }
+                // calculate the current shape funs on each gauss point, they are kept for the sub element loop
+                JxW=CalcBulkShapeFunOnIthQpoint(nDim,gpInd,qpoint,elShp);
+                _gpJxW[qp]=JxW;
+                elVolume+=1.0*JxW;
+                for(i=1;i<=nNodes;++i){
+                    _gpShpVal[qp*_nMaxNodes+i-1]=elShp.shape_value(i);
+                    _gpShpGrad[qp*_nMaxNodes+i-1]=elShp.shape_grad(i);
+                }
+                // calculate the coordinate of current gauss point
+                _mateBatch._gpCoord[qp](1)=0.0;_mateBatch._gpCoord[qp](2)=0.0;_mateBatch._gpCoord[qp](3)=0.0;
+                for(i=1;i<=nNodes;++i){
+                    _mateBatch._gpCoord[qp](1)+=_elNodes(i,1)*elShp.shape_value(i);
+                    _mateBatch._gpCoord[qp](2)+=_elNodes(i,2)*elShp.shape_value(i);
+                    _mateBatch._gpCoord[qp](3)+=_elNodes(i,3)*elShp.shape_value(i);
+                }
+
+                if(calctype==FECalcType::Projection){
+                    for(auto &it:_gpProjList[qp]) it.second=0.0;
+                }
+                else if(calctype==FECalcType::InitHistoryVariable||calctype==FECalcType::UpdateHistoryVariable){
+                    for(auto &it:solutionSystem._ScalarMaterials[(e-1)*_nGPoints+qp]) it.second=0.0;
+                    for(auto &it:solutionSystem._VectorMaterials[(e-1)*_nGPoints+qp]) it.second=0.0;
+                    for(auto &it:solutionSystem._Rank2TensorMaterials[(e-1)*_nGPoints+qp]) it.second=0.0;
+                    for(auto &it:solutionSystem._Rank4TensorMaterials[(e-1)*_nGPoints+qp]) it.second=0.0;
+                }
+            }//----->end of gauss point loop
+            mesh.SetBulkMeshIthBulkElmtVolume(e,elVolume);
+            _BulkVolumes+=elVolume;
+            _mateBatch.ResetQpState();
+
+            //*****************************************************
+            //*** 2) the sub element loop, the materials of all the
+            //***    qpoints are evaluated by one batched call
+            //*****************************************************
             // now we do the loop for local element, *local element could have multiple contributors according
             // to your model, i.e. one element (or one domain) can be assigned by multiple [elmt] sub block in your input file !!!
-            for(int ielmt=1;ielmt<=static_cast<int>(dofHandler.GetIthElmtElmtMateTypePair(e).size());ielmt++){
-                elmttype=dofHandler.GetIthElmtJthKernelElmtType(e,ielmt);
-                matetype=dofHandler.GetIthElmtJthKernelMateType(e,ielmt);
-                localDofIndex=dofHandler.GetIthBulkElmtJthKernelDofIndex(e,ielmt);
-                mateindex=dofHandler.GetIthBulkElmtJthKernelMateIndex(e,ielmt);
+            for(int ielmt=1;ielmt<=workBatch._nKernels;ielmt++){
+                // the jacobian of the 'jacobian=fd' kernels comes from FormFDJacobian, whose residual pass
+                // only contains these kernels
+                const bool IsFDKernel=workBatch._IsFDJacobianList[ielmt-1];
+                if((_IsFDResidualPass&&!IsFDKernel)||(calctype==FECalcType::ComputeJacobian&&IsFDKernel)) continue;
+                // the IMEX time stepping splits the residual(and jacobian) into the implicit and the explicit part
+                if(_UseIMEX&&(IsResidual||IsJacobian)&&workBatch._IsExplicitList[ielmt-1]!=_IsExplicitPass) continue;
+                // the multirate sub step only solves the unfrozen dofs, see SetFrozenDofs
+                if(_HasFrozenKernel&&(IsResidual||IsJacobian)&&workBatch._IsFrozenList[ielmt-1]) continue;
+                const bool IsKernelJacobian=IsJacobian&&!IsFDKernel;
+                const ElmtType &elmttype=workBatch._ElmtTypeList[ielmt-1];
+                const MateType &matetype=workBatch._MateTypeList[ielmt-1];
+                const vector<int> &localDofIndex=workBatch._LocalDofIndexList[ielmt-1];
+                const int &mateindex=workBatch._MateIndexList[ielmt-1];
                 nDofsPerSubElmt=static_cast<int>(localDofIndex.size());
 
                 // now we calculate the local dofs and their derivatives
@@ -181,145 +244,264 @@ void FESystem::FormBulkFE(const FECalcType &calctype,const double &t,const doubl
                 // u v w and their derivatives, and so on!!!
                 // In short, here we dont offer the localK and localR for the whole element, instead, the quantities
                 // of a single gauss point according to each sub [elmt] block
-                for(j=1;j<=nDofsPerSubElmt;j++){
-                    // !!!: the index starts from 1, not 0, please following the same way in your UEL !!!
-                    _gpU[j]=0.0;_gpV[j]=0.0;_gpUOld[j]=0.0;_gpVOld[j]=0.0;
-                    _gpGradU[j](1)=0.0;_gpGradU[j](2)=0.0;_gpGradU[j](3)=0.0;
-                    _gpGradUOld[j](1)=0.0;_gpGradUOld[j](2)=0.0;_gpGradUOld[j](3)=0.0;
-                    _gpGradV[j](1)=0.0;_gpGradV[j](2)=0.0;_gpGradV[j](3)=0.0;
-                    _gpGradVOld[j](1)=0.0;_gpGradVOld[j](2)=0.0;_gpGradVOld[j](3)=0.0;
-                    jj=localDofIndex[j-1];
-                    for(i=1;i<=nNodes;++i){
-                        _gpU[j]+=_elU[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_value(i);
-                        _gpUOld[j]+=_elUold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_value(i);
-
-                        _gpV[j]+=_elV[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_value(i);
-                        _gpVOld[j]+=_elVold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_value(i);
-
-                        _gpGradU[j](1)+=_elU[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(1);
-                        _gpGradU[j](2)+=_elU[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(2);
-                        _gpGradU[j](3)+=_elU[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(3);
-
-                        _gpGradUOld[j](1)+=_elUold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(1);
-                        _gpGradUOld[j](2)+=_elUold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(2);
-                        _gpGradUOld[j](3)+=_elUold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(3);
-
-                        _gpGradV[j](1)+=_elV[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(1);
-                        _gpGradV[j](2)+=_elV[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(2);
-                        _gpGradV[j](3)+=_elV[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(3);
-
-                        _gpGradVOld[j](1)+=_elVold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(1);
-                        _gpGradVOld[j](2)+=_elVold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(2);
-                        _gpGradVOld[j](3)+=_elVold[(i-1)*nDofsPerNode+jj-1]*fe._BulkShp.shape_grad(i)(3);
+                for(qp=0;qp<nQp;qp++){
+                    vector<double> &gpU=_mateBatch._gpU[qp],&gpUOld=_mateBatch._gpUOld[qp];
+                    vector<double> &gpV=_mateBatch._gpUdot[qp],&gpVOld=_mateBatch._gpUdotOld[qp];
+                    vector<Vector3d> &gpGradU=_mateBatch._gpGradU[qp],&gpGradUOld=_mateBatch._gpGradUOld[qp];
+                    vector<Vector3d> &gpGradV=_mateBatch._gpGradUdot[qp],&gpGradVOld=_mateBatch._gpGradUdotOld[qp];
+                    for(j=1;j<=nDofsPerSubElmt;j++){
+                        // !!!: the index starts from 1, not 0, please following the same way in your UEL !!!
+                        gpU[j]=0.0;gpV[j]=0.0;gpUOld[j]=0.0;gpVOld[j]=0.0;
+                        gpGradU[j](1)=0.0;gpGradU[j](2)=0.0;gpGradU[j](3)=0.0;
+                        gpGradUOld[j](1)=0.0;gpGradUOld[j](2)=0.0;gpGradUOld[j](3)=0.0;
+                        gpGradV[j](1)=0.0;gpGradV[j](2)=0.0;gpGradV[j](3)=0.0;
+                        gpGradVOld[j](1)=0.0;gpGradVOld[j](2)=0.0;gpGradVOld[j](3)=0.0;
+                        jj=localDofIndex[j-1];
+                        for(i=1;i<=nNodes;++i){
+                            shp=_gpShpVal[qp*_nMaxNodes+i-1];
+                            const Vector3d &dshp=_gpShpGrad[qp*_nMaxNodes+i-1];
+
+                            gpU[j]+=_elU[(i-1)*nDofsPerNode+jj-1]*shp;
+                            gpUOld[j]+=_elUold[(i-1)*nDofsPerNode+jj-1]*shp;
+
+                            gpV[j]+=_elV[(i-1)*nDofsPerNode+jj-1]*shp;
+                            gpVOld[j]+=_elVold[(i-1)*nDofsPerNode+jj-1]*shp;
+
+                            gpGradU[j](1)+=_elU[(i-1)*nDofsPerNode+jj-1]*dshp(1);
+                            gpGradU[j](2)+=_elU[(i-1)*nDofsPerNode+jj-1]*dshp(2);
+                            gpGradU[j](3)+=_elU[(i-1)*nDofsPerNode+jj-1]*dshp(3);
+
+                            gpGradUOld[j](1)+=_elUold[(i-1)*nDofsPerNode+jj-1]*dshp(1);
+                            gpGradUOld[j](2)+=_elUold[(i-1)*nDofsPerNode+jj-1]*dshp(2);
+                            gpGradUOld[j](3)+=_elUold[(i-1)*nDofsPerNode+jj-1]*dshp(3);
+
+                            gpGradV[j](1)+=_elV[(i-1)*nDofsPerNode+jj-1]*dshp(1);
+                            gpGradV[j](2)+=_elV[(i-1)*nDofsPerNode+jj-1]*dshp(2);
+                            gpGradV[j](3)+=_elV[(i-1)*nDofsPerNode+jj-1]*dshp(3);
+
+                            gpGradVOld[j](1)+=_elVold[(i-1)*nDofsPerNode+jj-1]*dshp(1);
+                            gpGradVOld[j](2)+=_elVold[(i-1)*nDofsPerNode+jj-1]*dshp(2);
+                            gpGradVOld[j](3)+=_elVold[(i-1)*nDofsPerNode+jj-1]*dshp(3);
+                        }
                     }
                 }
 
-                if(calctype==FECalcType::ComputeResidual){
-                    _subR.setZero();
-                }
-                else if(calctype==FECalcType::ComputeJacobian){
-                    _subK.setZero();
-                }
+                // i.e. the B-bar element replaces the volumetric strain before the material calculation
+                elmtSystem.PrepareBulkElmtBatch(elmttype,nDim,_gpJxW,_mateBatch);
+
                 //*****************************************************
-                //*** For user material calculation(UMAT)
+                //*** For user material calculation(UMAT), all the qpoints at once
                 //*****************************************************
-                if(calctype==FECalcType::InitHistoryVariable){
-                    mateSystem.InitBulkMateLibs(matetype,mateindex,nDim,_gpCoord,_gpU,_gpV,_gpGradU,_gpGradV);
+                // the tangent of the ELASTIC qpoints is the constant one of the material block
+                const bool IsElasticTangentKernel=workBatch._IsJacobianTangentOnlyList[ielmt-1]&&matetype!=MateType::NULLMATE
+                                                  &&mateSystem.GetIthMateConstants(mateindex)._IsElasticTangentConst;
+                const int kernelindex=_ElmtKernelOffset[ee-eStart]+ielmt-1;
+                if(ReadMateCache){
+                    // nothing to do, the materials of the same iterate are taken from the cache
+                }
+                else if(ReadElasticKernel&&IsElasticTangentKernel&&_ElasticKernelList[kernelindex]){
+                    // all the qpoints are elastic at the residual pass of the same iterate, and the jacobian
+                    // only reads the tangent, so the material calculation is skipped
+                    const MateConstants &Consts=mateSystem.GetIthMateConstants(mateindex);
+                    for(qp=0;qp<nQp;qp++){
+                        _mateBatch._Mates[qp].Rank4Materials["jacobian"]=Consts._ElasticC;
+                        _mateBatch._Mates[qp].SymTangent=Consts._ElasticSymC;
+                        _mateBatch._Mates[qp].HasSymTangent=true;
+                        _mateBatch.SetIthQpState(qp,MateQpState::ELASTIC);
+                    }
+                }
+                else if(calctype==FECalcType::InitHistoryVariable){
+                    mateSystem.InitBulkMateLibsBatch(matetype,mateindex,nDim,_mateBatch);
                 }
                 else{
-                    mateSystem.RunBulkMateLibs(matetype,mateindex,nDim,t,dt,_gpCoord,_gpU,_gpUOld,_gpV,_gpVOld,
-                                               _gpGradU,_gpGradUOld,_gpGradV,_gpGradVOld);
+                    mateSystem.RunBulkMateLibsBatch(matetype,mateindex,nDim,t,dt,_mateBatch);
+                }
+                if(FillElasticKernel){
+                    // the qpoint state is shared by the sub elements, the inelastic one wins, so the flag is conservative
+                    _ElasticKernelList[kernelindex]=IsElasticTangentKernel?1:0;
+                    if(IsElasticTangentKernel){
+                        _HasElasticTangentKernel=true;
+                        for(qp=0;qp<nQp;qp++){
+                            if(_mateBatch._QpState[qp]!=MateQpState::ELASTIC){
+                                _ElasticKernelList[kernelindex]=0;
+                                break;
+                            }
+                        }
+                    }
                 }
+                if(FillMateCache){
+                    if(_MateCacheOffset.empty()){
+                        FillMateCache=InitMateCache(eStart,eEnd,_nGPoints,dofHandler,_mateBatch._Mates[0]);
+                    }
+                    if(FillMateCache){
+                        for(qp=0;qp<nQp;qp++) _MateCache[_MateCacheOffset[ee-eStart]+(ielmt-1)*_nGPoints+qp]=_mateBatch._Mates[qp];
+                    }
+                }
+
                 //*****************************************************
                 //*** For user element calculation(UEL)
                 //*****************************************************
-                if(calctype==FECalcType::ComputeResidual){
-                    for(i=1;i<=nNodes;i++){
-                        elmtSystem.RunBulkElmtLibs(calctype,elmttype,nDim,nNodes,nDofsPerSubElmt,t,dt,ctan,
-                            _gpCoord,_gpU,_gpUOld,_gpV,_gpVOld,_gpGradU,_gpGradUOld,_gpGradV,_gpGradVOld,
-                            fe._BulkShp.shape_value(i),fe._BulkShp.shape_value(i),// for Residual, we only need test fun
-                            fe._BulkShp.shape_grad(i),fe._BulkShp.shape_grad(i),
-                            mateSystem.GetMaterialsPtr(),mateSystem.GetMaterialsOldPtr(),
-                            _gpProj,_subK,_subR);
-                        AssembleSubResidualToLocalResidual(nDofsPerNode,nDofsPerSubElmt,i,_subR,_localR);
-                    }
+                IsElmtLevelOnly=workBatch._IsElmtLevelOnlyList[ielmt-1]&&(IsResidual||IsJacobian);
+                // gather current element into the element batch, the full batch is assembled at once
+                if(batchKernel!=nullptr){
+                    const Materials *gpMates=ReadMateCache?&_MateCache[_MateCacheOffset[ee-eStart]+(ielmt-1)*_nGPoints]:_mateBatch._Mates.data();
+                    _elmtBatch.AppendLane(calctype,ctan[0],nQp,_nMaxNodes,_gpJxW.data(),_gpShpGrad.data(),gpMates,
+                                          nDofs,nDofsPerNode,localDofIndex,_elDofs,_elDofsActiveFlag,
+                                          &dofHandler.GetIthBulkElmtDofCouplingMask(e));
+                    if(_elmtBatch.IsFull()) FlushBulkElmtBatch(calctype,batchKernel,AMATRIX,RHS);
                 }
-                else if(calctype==FECalcType::ComputeJacobian){
-                    for(i=1;i<=nNodes;i++){
-                        for(j=1;j<=nNodes;j++){
+                // the specialized kernel is selected once for the work batch, it gives all the nodes at once
+                qpKernel=workBatch._QpKernelList[ielmt-1];
+                for(qp=0;qp<nQp&&!IsElmtLevelOnly&&batchKernel==nullptr;qp++){
+                    const Materials &gpMate=ReadMateCache?_MateCache[_MateCacheOffset[ee-eStart]+(ielmt-1)*_nGPoints+qp]:_mateBatch._Mates[qp];
+                    // the residual and the jacobian are independent, the fused pass does both of them
+                    if(IsResidual&&qpKernel!=nullptr){
+                        _localR.setZero();
+                        qpKernel(FECalcType::ComputeResidual,nDofsPerNode,localDofIndex,ctan,&_gpShpVal[qp*_nMaxNodes],&_gpShpGrad[qp*_nMaxNodes],
+                                 _mateBatch._gpU[qp],_mateBatch._gpGradU[qp],gpMate,_localK,_localR);
+                        AccumulateLocalResidual(nDofs,_elDofsActiveFlag,_gpJxW[qp],_localR,_R);
+                    }
+                    else if(IsResidual){
+                        _localR.setZero();
+                        _subR.setZero();
+                        for(i=1;i<=nNodes;i++){
+                            elmtSystem.RunBulkElmtLibs(FECalcType::ComputeResidual,elmttype,nDim,nNodes,nDofsPerSubElmt,t,dt,ctan,
+                                _mateBatch._gpCoord[qp],_mateBatch._gpU[qp],_mateBatch._gpUOld[qp],
+                                _mateBatch._gpUdot[qp],_mateBatch._gpUdotOld[qp],
+                                _mateBatch._gpGradU[qp],_mateBatch._gpGradUOld[qp],
+                                _mateBatch._gpGradUdot[qp],_mateBatch._gpGradUdotOld[qp],
+                                _gpShpVal[qp*_nMaxNodes+i-1],_gpShpVal[qp*_nMaxNodes+i-1],// for Residual, we only need test fun
+                                _gpShpGrad[qp*_nMaxNodes+i-1],_gpShpGrad[qp*_nMaxNodes+i-1],
+                                gpMate,_mateBatch._MatesOld[qp],
+                                _gpProjList[qp],_subK,_subR);
+                            AssembleSubResidualToLocalResidual(nDofsPerNode,localDofIndex,i,_subR,_localR);
+                        }
+                        AccumulateLocalResidual(nDofs,_elDofsActiveFlag,_gpJxW[qp],_localR,_R);
+                    }
+                    if(IsKernelJacobian&&qpKernel!=nullptr){
+                        _localK.setZero();
+                        qpKernel(FECalcType::ComputeJacobian,nDofsPerNode,localDofIndex,ctan,&_gpShpVal[qp*_nMaxNodes],&_gpShpGrad[qp*_nMaxNodes],
+                                 _mateBatch._gpU[qp],_mateBatch._gpGradU[qp],gpMate,_localK,_localR);
+                        AccumulateLocalJacobian(nDofs,_elDofsActiveFlag,_gpJxW[qp],_localK,_K);
+                    }
+                    else if(IsKernelJacobian&&!workBatch._IsJacobianZeroList[ielmt-1]){
+                        // the kernel without any coupled block gives nothing to the jacobian
+                        _localK.setZero();
+                        _subK.setZero();
+                        for(i=1;i<=nNodes;i++){
+                            for(j=1;j<=nNodes;j++){
+                                elmtSystem.RunBulkElmtLibs(FECalcType::ComputeJacobian,elmttype,nDim,nNodes,nDofsPerSubElmt,t,dt,ctan,
+                                    _mateBatch._gpCoord[qp],_mateBatch._gpU[qp],_mateBatch._gpUOld[qp],
+                                    _mateBatch._gpUdot[qp],_mateBatch._gpUdotOld[qp],
+                                    _mateBatch._gpGradU[qp],_mateBatch._gpGradUOld[qp],
+                                    _mateBatch._gpGradUdot[qp],_mateBatch._gpGradUdotOld[qp],
+                                    _gpShpVal[qp*_nMaxNodes+i-1],_gpShpVal[qp*_nMaxNodes+j-1],
+                                    _gpShpGrad[qp*_nMaxNodes+i-1],_gpShpGrad[qp*_nMaxNodes+j-1],
+                                    gpMate,_mateBatch._MatesOld[qp],
+                                    _gpProjList[qp],_subK,_subR);
+                                AssembleSubJacobianToLocalJacobian(nDofsPerNode,localDofIndex,workBatch._CouplingMaskList[ielmt-1],
+                                                                   i,j,_subK,_localK);
+                            }
+                        }
+                        AccumulateLocalJacobian(nDofs,_elDofsActiveFlag,_gpJxW[qp],_localK,_K);
+                    }
+                    if(calctype==FECalcType::Projection){
+                        for(i=1;i<=nNodes;i++){
                             elmtSystem.RunBulkElmtLibs(calctype,elmttype,nDim,nNodes,nDofsPerSubElmt,t,dt,ctan,
-                            _gpCoord,_gpU,_gpUOld,_gpV,_gpVOld,_gpGradU,_gpGradUOld,_gpGradV,_gpGradVOld,
-                            fe._BulkShp.shape_value(i),fe._BulkShp.shape_value(j),
-                            fe._BulkShp.shape_grad(i),fe._BulkShp.shape_grad(j),
-                            mateSystem.GetMaterialsPtr(),mateSystem.GetMaterialsOldPtr(),
-                            _gpProj,_subK,_subR);
-                            AssembleSubJacobianToLocalJacobian(nDofsPerNode,i,j,_subK,_localK);
+                                _mateBatch._gpCoord[qp],_mateBatch._gpU[qp],_mateBatch._gpUOld[qp],
+                                _mateBatch._gpUdot[qp],_mateBatch._gpUdotOld[qp],
+                                _mateBatch._gpGradU[qp],_mateBatch._gpGradUOld[qp],
+                                _mateBatch._gpGradUdot[qp],_mateBatch._gpGradUdotOld[qp],
+                                _gpShpVal[qp*_nMaxNodes+i-1],_gpShpVal[qp*_nMaxNodes+i-1],// for Residual, we only need test fun
+                                _gpShpGrad[qp*_nMaxNodes+i-1],_gpShpGrad[qp*_nMaxNodes+i-1],
+                                gpMate,_mateBatch._MatesOld[qp],
+                                _gpProjList[qp],_subK,_subR);
                         }
+                        // here we should not assemble the local projection, because the JxW should not be accumulated
+                        // inside the element-loop, but the gpProj should be.
+                        // therefore, each sub element should use its own place of gpProj, in short, the gpProj is shared
+                        // between different elements
                     }
                 }
-                else if(calctype==FECalcType::Projection){
-                    for(i=1;i<=nNodes;i++){
-                        elmtSystem.RunBulkElmtLibs(calctype,elmttype,nDim,nNodes,nDofsPerSubElmt,t,dt,ctan,
-                        _gpCoord,_gpU,_gpUOld,_gpV,_gpVOld,_gpGradU,_gpGradUOld,_gpGradV,_gpGradVOld,
-                        fe._BulkShp.shape_value(i),fe._BulkShp.shape_value(i),// for Residual, we only need test fun
-                        fe._BulkShp.shape_grad(i),fe._BulkShp.shape_grad(i),
-                        mateSystem.GetMaterialsPtr(),mateSystem.GetMaterialsOldPtr(),
-                        _gpProj,_subK,_subR);
+                //*****************************************************
+                //*** the element level part(i.e. hourglass control, B-bar)
+                //*****************************************************
+                if(workBatch._HasElmtLevelPartList[ielmt-1]&&(IsResidual||IsJacobian)){
+                    const Materials *gpMates=ReadMateCache?&_MateCache[_MateCacheOffset[ee-eStart]+(ielmt-1)*_nGPoints]:_mateBatch._Mates.data();
+                    const double &hgcoef=workBatch._HourglassCoefList[ielmt-1];
+                    if(IsResidual){
+                        _localR.setZero();
+                        elmtSystem.RunBulkElmtLibsOnElmt(FECalcType::ComputeResidual,elmttype,nDim,nNodes,nDofsPerNode,localDofIndex,ctan,hgcoef,
+                                                         _elNodes,_elU,nQp,_nMaxNodes,_gpJxW,_gpShpGrad,gpMates,_localK,_localR);
+                        AccumulateLocalResidual(nDofs,_elDofsActiveFlag,1.0,_localR,_R);
+                    }
+                    if(IsKernelJacobian){
+                        _localK.setZero();
+                        elmtSystem.RunBulkElmtLibsOnElmt(FECalcType::ComputeJacobian,elmttype,nDim,nNodes,nDofsPerNode,localDofIndex,ctan,hgcoef,
+                                                         _elNodes,_elU,nQp,_nMaxNodes,_gpJxW,_gpShpGrad,gpMates,_localK,_localR);
+                        AccumulateLocalJacobian(nDofs,_elDofsActiveFlag,1.0,_localK,_K);
                     }
-                    // here we should not assemble the local projection, because the JxW should not be accumulated
-                    // inside the element-loop, but the gpProj should be.
-                    // therefore, each sub element should use its own place of gpProj, in short, the gpProj is shared
-                    // between different elements
                 }
             }//=====> end-of-sub-element-loop
+            for(qp=0;qp<nQp;qp++){
+                if(_mateBatch._QpState[qp]==MateQpState::ELASTIC) _nElasticQpoints+=1;
+                else if(_mateBatch._QpState[qp]==MateQpState::INELASTIC) _nInelasticQpoints+=1;
+            }
 
-            //***********************************************
-            //*** accumulate all the local contribution inside gauss loop
-            if(calctype==FECalcType::ComputeResidual){
-                AccumulateLocalResidual(nDofs,_elDofsActiveFlag,JxW,_localR,_R);
+            //*****************************************************
+            //*** 3) the qpoint-wise projection and history
+            //*****************************************************
+            if(calctype==FECalcType::Projection){
+                for(gpInd=1;gpInd<=nQp;++gpInd){
+                    JxW=CalcBulkShapeFunOnIthQpoint(nDim,gpInd,qpoint,elShp);
+                    AssembleLocalProjectionToGlobal(nNodes,JxW,elShp,_gpProjList[gpInd-1],
+                                                    _mateBatch._Mates[gpInd-1].ScalarMaterials,
+                                                    _mateBatch._Mates[gpInd-1].VectorMaterials,
+                                                    _mateBatch._Mates[gpInd-1].Rank2Materials,
+                                                    _mateBatch._Mates[gpInd-1].Rank4Materials,
+                                                    solutionSystem);
+                }
             }
-            else if(calctype==FECalcType::ComputeJacobian){
-                AccumulateLocalJacobian(nDofs,_elDofsActiveFlag,JxW,_localK,_K);
+            else if(calctype==FECalcType::InitHistoryVariable||calctype==FECalcType::UpdateHistoryVariable){
+                for(gpInd=1;gpInd<=nQp;++gpInd){
+                    AssembleSubHistToLocal(e,_nGPoints,gpInd,_mateBatch._Mates[gpInd-1],solutionSystem);
+                }
+            }
+        
+            if(batchKernel!=nullptr){
+                // already in the batch
             }
-            else if(calctype==FECalcType::Projection){
-                AssembleLocalProjectionToGlobal(nNodes,JxW,fe._BulkShp,_gpProj,
-                                                mateSystem.GetScalarMatePtr(),
-                                                mateSystem.GetVectorMatePtr(),
-                                                mateSystem.GetRank2MatePtr(),
-                                                mateSystem.GetRank4MatePtr(),
-                                                solutionSystem);
+            else if(IsResidual||IsJacobian){
+                if(IsResidual) AssembleLocalResidualToGlobalResidual(nDofs,_elDofs,_R,RHS);
+                if(IsJacobian) AssembleLocalJacobianToGlobalJacobian(nDofs,nDofsPerNode,_elDofs,dofHandler.GetIthBulkElmtDofCouplingMask(e),_K,AMATRIX);
             }
             else if(calctype==FECalcType::InitHistoryVariable||calctype==FECalcType::UpdateHistoryVariable){
-                AssembleSubHistToLocal(e,fe._BulkQPoint.GetQpPointsNum(),gpInd,mateSystem.GetMaterialsPtr(),solutionSystem);
+                AssembleLocalHistToGlobal(e,_nGPoints,solutionSystem);
             }
-        }//----->end of gauss point loop
-        mesh.SetBulkMeshIthBulkElmtVolume(e,elVolume);
-        _BulkVolumes+=elVolume;
+        }//------>end of element loop
+        // the partially filled element batch
+        if(batchKernel!=nullptr) FlushBulkElmtBatch(calctype,batchKernel,AMATRIX,RHS);
+    }//------>end of work batch loop
 
-        
-        if(calctype==FECalcType::ComputeResidual){
-            AssembleLocalResidualToGlobalResidual(nDofs,_elDofs,_R,RHS);
-        }
-        else if(calctype==FECalcType::ComputeJacobian){
-            AssembleLocalJacobianToGlobalJacobian(nDofs,_elDofs,_K,AMATRIX);
-        }
-        else if(calctype==FECalcType::InitHistoryVariable||calctype==FECalcType::UpdateHistoryVariable){
-            AssembleLocalHistToGlobal(e,fe._BulkQPoint.GetQpPointsNum(),solutionSystem);
-        }
-    }//------>end of element loop
+    if(FillMateCache) _IsMateCacheFilled=true;
+    if(FillElasticKernel) _IsElasticKernelListFilled=true;
+    if(calctype==FECalcType::ComputeResidualAndJacobian){
+        _IsFusedJacobianFilled=true;
+        _FusedJacobianCtan[0]=ctan[0];_FusedJacobianCtan[1]=ctan[1];
+    }
 
     //********************************************************************
     //*** finish all the final assemble for different matrix and array
     //********************************************************************
-    if(calctype==FECalcType::ComputeResidual){
+    if(IsResidual){
         VecAssemblyBegin(RHS);
         VecAssemblyEnd(RHS);
     }
-    else if(calctype==FECalcType::ComputeJacobian){
+    if(IsJacobian){
         MatAssemblyBegin(AMATRIX,MAT_FINAL_ASSEMBLY);
         MatAssemblyEnd(AMATRIX,MAT_FINAL_ASSEMBLY);
     }
-    else if(calctype==FECalcType::Projection){
+    if(calctype==FECalcType::Projection){
         Projection(mesh.GetBulkMeshNodesNum(),solutionSystem);
     }
 
@@ -338,4 +520,147 @@ void FESystem::FormBulkFE(const FECalcType &calctype,const double &t,const doubl
     VecDestroy(&_Vseq);
     VecDestroy(&_Voldseq);
 
-}
\ No newline at end of file
+}
+//****************************************************************
+void FESystem::FormExplicitResidual(const double &t,const double &dt,const double (&ctan)[2],
+                Mesh &mesh,const DofHandler &dofHandler,FE &fe,
+                ElmtSystem &elmtSystem,MateSystem &mateSystem,
+                SolutionSystem &solutionSystem,
+                Mat &AMATRIX,Vec &RHS){
+    // F(U,Udot)+R_explicit(U)=0 is integrated as F(U,Udot)=G(U), so G is the negative one
+    _IsExplicitPass=true;
+    FormBulkFE(FECalcType::ComputeResidual,t,dt,ctan,mesh,dofHandler,fe,elmtSystem,mateSystem,solutionSystem,AMATRIX,RHS);
+    _IsExplicitPass=false;
+    VecScale(RHS,-1.0);
+}
+//****************************************************************
+double FESystem::CalcBulkShapeFunOnIthQpoint(const int &nDim,const int &gpInd,const QPoint &qpoint,ShapeFun &shp){
+    // calculate the bulk shape functions on the gpInd-th qpoint of current element(_elNodes), return JxW
+    double w=1.0,xi,eta,zeta;
+    if(nDim==1){
+        w =qpoint.GetIthQpPointJthCoord(gpInd,0);
+        xi=qpoint.GetIthQpPointJthCoord(gpInd,1);
+        shp.Calc(xi,_elNodes,true);
+    }
+    else if(nDim==2){
+        w  =qpoint.GetIthQpPointJthCoord(gpInd,0);
+        xi =qpoint.GetIthQpPointJthCoord(gpInd,1);
+        eta=qpoint.GetIthQpPointJthCoord(gpInd,2);
+        shp.Calc(xi,eta,_elNodes,true);
+    }
+    else if(nDim==3){
+        w   =qpoint.GetIthQpPointJthCoord(gpInd,0);
+        xi  =qpoint.GetIthQpPointJthCoord(gpInd,1);
+        eta =qpoint.GetIthQpPointJthCoord(gpInd,2);
+        zeta=qpoint.GetIthQpPointJthCoord(gpInd,3);
+        shp.Calc(xi,eta,zeta,_elNodes,true);
+    }
+    return w*shp.GetDetJac();
+}
+//****************************************************************
+bool FESystem::InitMateCache(const int &eStart,const int &eEnd,const int &nQp,const DofHandler &dofHandler,const Materials &mate){
+    // one Materials for each sub element and qpoint of the local elements,
+    // the memory is estimated from the first evaluated qpoint
+    int e,n=0;
+    _MateCacheOffset.resize(eEnd-eStart,0);
+    for(e=eStart+1;e<=eEnd;e++){
+        _MateCacheOffset[e-1-eStart]=n;
+        n+=static_cast<int>(dofHandler.GetIthElmtElmtMateTypePair(e).size())*nQp;
+    }
+    const double NodeBytes=64.0;// map node plus its key
+    double bytes=0.0;
+    bytes+=mate.ScalarMaterials.size()*(NodeBytes+sizeof(double));
+    bytes+=mate.VectorMaterials.size()*(NodeBytes+sizeof(Vector3d));
+    bytes+=mate.Rank2Materials.size()*(NodeBytes+sizeof(RankTwoTensor));
+    bytes+=mate.Rank4Materials.size()*(NodeBytes+sizeof(RankFourTensor));
+    bytes=(bytes+sizeof(Materials))*n/(1024.0*1024.0);
+    if(bytes>_MateCacheMaxMemMB){
+        char buff[70];
+        snprintf(buff,70,"material cache needs %12.4e MB, larger than %12.4e MB",bytes,_MateCacheMaxMemMB);
+        MessagePrinter::PrintWarningTxt(string(buff));
+        MessagePrinter::PrintWarningTxt("material cache is disabled, increase matecachemem in [job] block to use it");
+        _UseMateCache=false;
+        _MateCacheOffset.clear();
+        return false;
+    }
+    _MateCache.resize(n);
+    return true;
+}
+//****************************************************************
+void FESystem::StampResidualIterate(const Vec &U,const Vec &V,const double &t,const double &dt,const SolutionSystem &solutionSystem){
+    // called after the residual evaluation, U and V are the ones passed in by SNES/TS
+    if(!_UseMateCache&&!_UseFusedAssembly&&!_HasElasticTangentKernel) return;
+    if(!_IsMateCacheVecCreated){
+        VecDuplicate(U,&_MateCacheU);
+        VecDuplicate(V,&_MateCacheV);
+        _IsMateCacheVecCreated=true;
+    }
+    VecCopy(U,_MateCacheU);
+    VecCopy(V,_MateCacheV);
+    _MateCacheVec[0]=U;_MateCacheVec[1]=V;
+    PetscObjectStateGet((PetscObject)U,&_MateCacheState[0]);
+    PetscObjectStateGet((PetscObject)V,&_MateCacheState[1]);
+    PetscObjectStateGet((PetscObject)solutionSystem._Uold,&_MateCacheState[2]);
+    PetscObjectStateGet((PetscObject)solutionSystem._Vold,&_MateCacheState[3]);
+    _MateCacheTime[0]=t;_MateCacheTime[1]=dt;
+}
+//****************************************************************
+void FESystem::CheckResidualIterate(const Vec &U,const Vec &V,const double &t,const double &dt,const double (&ctan)[2],
+                                    const SolutionSystem &solutionSystem){
+    // called before the jacobian evaluation modifies anything. If U(V) is the same vector with the same
+    // state counter, it is untouched since the last residual, otherwise(i.e. the line search copies its
+    // trial vector back to the solution) the values are compared
+    if(!_UseMateCache&&!_UseFusedAssembly&&!_HasElasticTangentKernel) return;
+    _IsMateCacheReusable=false;
+    _IsFusedJacobianReusable=false;
+    _IsElasticKernelListReusable=false;
+    if(!_IsMateCacheFilled&&!_IsFusedJacobianFilled&&!_IsElasticKernelListFilled) return;
+    if(t!=_MateCacheTime[0]||dt!=_MateCacheTime[1]) return;
+
+    PetscObjectState state;
+    PetscBool IsSame;
+    PetscObjectStateGet((PetscObject)solutionSystem._Uold,&state);
+    if(state!=_MateCacheState[2]) return;
+    PetscObjectStateGet((PetscObject)solutionSystem._Vold,&state);
+    if(state!=_MateCacheState[3]) return;
+
+    PetscObjectStateGet((PetscObject)U,&state);
+    if(U!=_MateCacheVec[0]||state!=_MateCacheState[0]){
+        VecEqual(U,_MateCacheU,&IsSame);
+        if(!IsSame) return;
+    }
+    PetscObjectStateGet((PetscObject)V,&state);
+    if(V!=_MateCacheVec[1]||state!=_MateCacheState[1]){
+        VecEqual(V,_MateCacheV,&IsSame);
+        if(!IsSame) return;
+    }
+    _IsMateCacheReusable=_IsMateCacheFilled;
+    _IsElasticKernelListReusable=_IsElasticKernelListFilled;
+    // the shift of the time derivative(ctan[1]) is only known by the jacobian, the fused one
+    // may be assembled with the one of the previous step
+    _IsFusedJacobianReusable=_IsFusedJacobianFilled&&ctan[0]==_FusedJacobianCtan[0]&&ctan[1]==_FusedJacobianCtan[1];
+    // the boundary conditions are added to it by the jacobian evaluation, so it is only used once
+    if(_IsFusedJacobianReusable) _IsFusedJacobianFilled=false;
+}
+//****************************************************************
+void FESystem::ReleaseMem(){
+    if(_IsMateCacheVecCreated){
+        VecDestroy(&_MateCacheU);
+        VecDestroy(&_MateCacheV);
+        _IsMateCacheVecCreated=false;
+    }
+    _MateCache.clear();
+    _MateCacheOffset.clear();
+    if(_IsFDColoringCreated){
+        MatFDColoringDestroy(&_FDColoring);
+        ISColoringDestroy(&_FDISColoring);
+        MatDestroy(&_AFD);
+        VecDestroy(&_FDU0);
+        VecDestroy(&_FDV0);
+        _IsFDColoringCreated=false;
+    }
+    if(_IsMassMatrixCreated){
+        MatDestroy(&_MMATRIX);
+        _IsMassMatrixCreated=false;
+    }
+}
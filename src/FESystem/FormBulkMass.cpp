@@ -0,0 +1,99 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the mass matrix of the second order time stepping,
+//+++          M*Uddot+R(U,Udot)=0. The [elmts] blocks with
+//+++          'density=' give rho*N_a*N_b to each of their dofs,
+//+++          it only depends on the mesh, so it is assembled once
+//+++          and reused by the residual and jacobian of all steps
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "FESystem/FESystem.h"
+
+void FESystem::FormBulkMass(Mesh &mesh,const DofHandler &dofHandler,FE &fe,Mat &AMATRIX){
+    if(_IsMassMatrixCreated) return;
+
+    MatDuplicate(AMATRIX,MAT_DO_NOT_COPY_VALUES,&_MMATRIX);
+    MatZeroEntries(_MMATRIX);
+
+    PetscInt nDofs,nNodes,nDofsPerNode,nDim,nQp,e;
+    PetscInt gpInd,i,j,k,jj;
+    PetscReal JxW,rhoJxW,val;
+    nDim=mesh.GetDim();
+
+    for(const BulkElmtWorkBatch &workBatch:_elmtWorkBatchList){
+        if(find_if(workBatch._DensityList.begin(),workBatch._DensityList.end(),
+                   [](const double &rho){return rho>0.0;})==workBatch._DensityList.end()){
+            continue;// no mass in current batch
+        }
+        ShapeFun &elShp=fe.GetBulkShp(workBatch._MeshTypeIndex);
+        QPoint &qpoint=fe.GetBulkQPoint(workBatch._QPointIndex,workBatch._MeshTypeIndex);
+        nQp=qpoint.GetQpPointsNum();
+        nNodes=workBatch._nNodes;
+
+        for(const int &ee:workBatch._ElmtList){
+            e=ee+1;
+            mesh.GetBulkMeshIthBulkElmtNodes(e,_elNodes);
+            dofHandler.GetIthBulkElmtDofIndex0(e,_elDofs,_elDofsActiveFlag);
+            nDofs=dofHandler.GetIthBulkElmtDofsNum(e);
+            nDofsPerNode=nDofs/nNodes;
+            fill(_K.begin(),_K.begin()+nDofs*nDofs,0.0);
+
+            for(gpInd=1;gpInd<=nQp;++gpInd){
+                JxW=CalcBulkShapeFunOnIthQpoint(nDim,gpInd,qpoint,elShp);
+                for(int ielmt=1;ielmt<=workBatch._nKernels;ielmt++){
+                    if(workBatch._DensityList[ielmt-1]<=0.0) continue;
+                    rhoJxW=workBatch._DensityList[ielmt-1]*JxW;
+                    const vector<int> &localDofIndex=workBatch._LocalDofIndexList[ielmt-1];
+                    // the mass only couples the same dof of different nodes
+                    for(i=1;i<=nNodes;i++){
+                        for(j=1;j<=nNodes;j++){
+                            val=elShp.shape_value(i)*elShp.shape_value(j)*rhoJxW;
+                            for(jj=0;jj<static_cast<int>(localDofIndex.size());jj++){
+                                k=localDofIndex[jj]-1;
+                                if(_elDofsActiveFlag[(i-1)*nDofsPerNode+k]>0.0){
+                                    _K[((i-1)*nDofsPerNode+k)*nDofs+(j-1)*nDofsPerNode+k]+=val;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            AssembleLocalJacobianToGlobalJacobian(nDofs,nDofsPerNode,_elDofs,dofHandler.GetIthBulkElmtDofCouplingMask(e),_K,_MMATRIX);
+        }
+    }
+    MatAssemblyBegin(_MMATRIX,MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(_MMATRIX,MAT_FINAL_ASSEMBLY);
+    _IsMassMatrixCreated=true;
+
+    PetscReal mass;
+    Vec ones,Mones;
+    MatCreateVecs(_MMATRIX,&ones,&Mones);
+    VecSet(ones,1.0);
+    MatMult(_MMATRIX,ones,Mones);
+    VecSum(Mones,&mass);
+    VecDestroy(&ones);
+    VecDestroy(&Mones);
+    char buff[70];
+    snprintf(buff,70,"mass matrix is assembled, total mass(all dofs)=%12.5e",mass);
+    MessagePrinter::PrintNormalTxt(string(buff));
+}
+//****************************************************************
+void FESystem::AddMassResidual(const Vec &Uddot,Vec &RHS){
+    if(!_IsMassMatrixCreated) return;
+    MatMultAdd(_MMATRIX,Uddot,RHS,RHS);
+}
+//****************************************************************
+void FESystem::AddMassJacobian(const double &shiftA,Mat &AMATRIX){
+    if(!_IsMassMatrixCreated) return;
+    MatAXPY(AMATRIX,shiftA,_MMATRIX,SUBSET_NONZERO_PATTERN);
+    UpdateMaxAMatrixValue(AMATRIX);
+}
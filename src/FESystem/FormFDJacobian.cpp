@@ -0,0 +1,108 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the colored finite difference jacobian of the [elmts]
+//+++          blocks with 'jacobian=fd', the columns of the same
+//+++          color are not coupled by any element, so they are
+//+++          perturbed together and one residual evaluation gives
+//+++          all of them. The number of the residual evaluations is
+//+++          the number of the colors, not the number of the dofs
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "FESystem/FESystem.h"
+
+PetscErrorCode FESystem::ComputeFDResidual(void */*dummy*/,Vec U,Vec F,void *ctx){
+    FESystem *feSystem=(FESystem*)ctx;
+    SolutionSystem &solutionSystem=*feSystem->_FDContext.solutionSystem;
+    // U is the perturbed one, V follows it in the same way as the time derivative: V=V0+ctan[1]*(U-U0)
+    VecCopy(U,solutionSystem._Unew);
+    VecWAXPY(solutionSystem._V,-1.0,feSystem->_FDU0,U);
+    VecAYPX(solutionSystem._V,feSystem->_FDContext.ctan[1],feSystem->_FDV0);
+    feSystem->FormBulkFE(FECalcType::ComputeResidual,feSystem->_FDContext.t,feSystem->_FDContext.dt,feSystem->_FDContext.ctan,
+                         *feSystem->_FDContext.mesh,*feSystem->_FDContext.dofHandler,*feSystem->_FDContext.fe,
+                         *feSystem->_FDContext.elmtSystem,*feSystem->_FDContext.mateSystem,solutionSystem,
+                         feSystem->_AFD,F);
+    return 0;
+}
+//****************************************************************
+void FESystem::FormFDJacobian(const double &t,const double &dt,const double (&ctan)[2],
+                Mesh &mesh,const DofHandler &dofHandler,FE &fe,
+                ElmtSystem &elmtSystem,MateSystem &mateSystem,
+                SolutionSystem &solutionSystem,
+                Mat &AMATRIX){
+    if(!_HasFDJacobian) return;
+
+    if(!_IsFDColoringCreated){
+        // the nonzero pattern of AMATRIX is the one of CreateSparsityPattern, which already
+        // contains all the couplings of the elements, so it is used for the coloring
+        MatColoring matColoring;
+        MatColoringCreate(AMATRIX,&matColoring);
+        MatColoringSetDistance(matColoring,2);// the columns of one color must not share any row
+        MatColoringSetType(matColoring,MATCOLORINGSL);
+        MatColoringSetFromOptions(matColoring);
+        MatColoringApply(matColoring,&_FDISColoring);
+        MatColoringDestroy(&matColoring);
+
+        MatDuplicate(AMATRIX,MAT_DO_NOT_COPY_VALUES,&_AFD);
+        MatFDColoringCreate(_AFD,_FDISColoring,&_FDColoring);
+        // the cast goes through void(*)(void), which is the generic function pointer for -Wcast-function-type
+        MatFDColoringSetFunction(_FDColoring,(PetscErrorCode(*)(void))(void(*)(void))ComputeFDResidual,this);
+        MatFDColoringSetFromOptions(_FDColoring);
+        MatFDColoringSetUp(_AFD,_FDISColoring,_FDColoring);
+
+        VecDuplicate(solutionSystem._Unew,&_FDU0);
+        VecDuplicate(solutionSystem._V,&_FDV0);
+        _IsFDColoringCreated=true;
+
+        PetscInt nColors;
+        ISColoringGetColors(_FDISColoring,NULL,&nColors,NULL);
+        char buff[70];
+        snprintf(buff,70,"finite difference jacobian uses %d colors",static_cast<int>(nColors));
+        MessagePrinter::PrintNormalTxt(string(buff));
+    }
+
+    _FDContext.t=t;_FDContext.dt=dt;
+    _FDContext.ctan[0]=ctan[0];_FDContext.ctan[1]=ctan[1];
+    _FDContext.mesh=&mesh;_FDContext.dofHandler=&dofHandler;_FDContext.fe=&fe;
+    _FDContext.elmtSystem=&elmtSystem;_FDContext.mateSystem=&mateSystem;
+    _FDContext.solutionSystem=&solutionSystem;
+
+    // the perturbed residuals overwrite Unew, V and the qpoint summary, they are restored at the end
+    const double BulkVolumes=_BulkVolumes;
+    const int nElasticQpoints=_nElasticQpoints,nInelasticQpoints=_nInelasticQpoints;
+    VecCopy(solutionSystem._Unew,_FDU0);
+    VecCopy(solutionSystem._V,_FDV0);
+
+    // the difference of the residual gives dR/dU+ctan[1]*dR/dV, which is the analytic jacobian for ctan[0]=1(SNES and TS)
+    _IsFDResidualPass=true;
+    MatFDColoringApply(_AFD,_FDColoring,_FDU0,NULL);
+    _IsFDResidualPass=false;
+
+    VecCopy(_FDU0,solutionSystem._Unew);
+    VecCopy(_FDV0,solutionSystem._V);
+    _BulkVolumes=BulkVolumes;
+    _nElasticQpoints=nElasticQpoints;_nInelasticQpoints=nInelasticQpoints;
+
+    MatAXPY(AMATRIX,1.0,_AFD,SUBSET_NONZERO_PATTERN);
+
+    UpdateMaxAMatrixValue(AMATRIX);
+}
+//****************************************************************
+void FESystem::UpdateMaxAMatrixValue(Mat &AMATRIX){
+    // the penalty of the dirichlet bc is based on the max value of the whole jacobian, see AccumulateLocalJacobian
+    Vec rowmax;
+    PetscReal maxval;
+    MatCreateVecs(AMATRIX,NULL,&rowmax);
+    MatGetRowMax(AMATRIX,rowmax,NULL);
+    VecMax(rowmax,NULL,&maxval);
+    VecDestroy(&rowmax);
+    if(maxval>_MaxKMatrixValue) _MaxKMatrixValue=maxval;
+}
@@ -14,8 +14,40 @@
 
 #include "FESystem/FESystem.h"
 
+//*** true if the kernel of the block is linear in U and V, it is used to check 'imex=linear'
+static bool IsLinearElmtBlock(const ElmtBlock &elmtBlock){
+    bool IsLinearElmt=false,IsLinearMate=false;
+    switch(elmtBlock._ElmtType){
+        case ElmtType::TIMEDERIVELMT:
+        case ElmtType::LAPLACEELMT:
+        case ElmtType::POISSONELMT:
+        case ElmtType::DIFFUSIONELMT:
+        case ElmtType::WAVEELMT:
+        case ElmtType::MECHANICSELMT:
+        case ElmtType::MECHANICSRIELMT:
+        case ElmtType::MECHANICSBBARELMT:
+            IsLinearElmt=true;
+            break;
+        default:
+            IsLinearElmt=false;
+    }
+    switch(elmtBlock._MateType){
+        case MateType::NULLMATE:
+        case MateType::LINEARELASTICMATE:
+        case MateType::CONSTPOISSONMATE:
+        case MateType::CONSTDIFFUSIONMATE:
+        case MateType::CONSTWAVEMATE:
+            IsLinearMate=true;
+            break;
+        default:
+            IsLinearMate=false;
+    }
+    return IsLinearElmt&&IsLinearMate;
+}
+//****************************************************************
 void FESystem::InitBulkFESystem(const Mesh &mesh,
                             const DofHandler &dofHandler,
+                            const ElmtSystem &elmtSystem,
                             FE &fe,
                             SolutionSystem &solution){
 
@@ -72,9 +104,61 @@ void FESystem::InitBulkFESystem(const Mesh &mesh,
     _gpProj.clear();
     
 
-    _nGPoints=fe._BulkQPoint.GetQpPointsNum();
+    // each [elmts] block can use its own qpoint rule, for the element shared by several blocks,
+    // the rule with the most qpoints is used. _nGPoints is the max one, which is used as the
+    // stride of the history and the capacity of the batch
+    _nGPoints=fe.GetMaxBulkQpPointsNum();
+    _elQPointIndex.assign(mesh.GetBulkMeshBulkElmtsNum(),1);
+    _elMeshTypeIndex.assign(mesh.GetBulkMeshBulkElmtsNum(),1);
+    for(int e=1;e<=mesh.GetBulkMeshBulkElmtsNum();e++){
+        int nQpMax=0,iRule,iType;
+        iType=fe.GetBulkMeshTypeIndex(mesh.GetBulkMeshIthBulkElmtMeshType(e));
+        _elMeshTypeIndex[e-1]=iType;
+        for(int ielmt=1;ielmt<=static_cast<int>(dofHandler.GetIthElmtElmtMateTypePair(e).size());ielmt++){
+            iRule=dofHandler.GetIthBulkElmtJthKernelQPointIndex(e,ielmt);
+            if(fe.GetBulkQpPointsNum(iRule,iType)>nQpMax){
+                nQpMax=fe.GetBulkQpPointsNum(iRule,iType);
+                _elQPointIndex[e-1]=iRule;
+            }
+        }
+    }
+
+    // the local elements are grouped into the work batches, so the shape functions, qpoints and
+    // kernels of the same batch are reused by the consecutive elements
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    int rankne=mesh.GetBulkMeshBulkElmtsNum()/size;
+    int eStart=rank*rankne;
+    int eEnd=(rank+1)*rankne;
+    if(rank==size-1) eEnd=mesh.GetBulkMeshBulkElmtsNum();
+    CreateBulkElmtWorkBatches(eStart,eEnd,mesh,dofHandler,elmtSystem);
+
+    // the finite difference jacobian is collective, so it is decided by the [elmts] blocks, not the local elements
+    _HasFDJacobian=false;_HasMassMatrix=false;
+    _HasExplicitPart=false;_IsImplicitPartLinear=true;
+    for(int iblock=1;iblock<=elmtSystem.GetBulkElmtBlockNums();iblock++){
+        if(elmtSystem.GetIthBulkElmtBlock(iblock)._UseFDJacobian) _HasFDJacobian=true;
+        if(elmtSystem.GetIthBulkElmtBlock(iblock)._Density>0.0) _HasMassMatrix=true;
+        if(elmtSystem.GetIthBulkElmtBlock(iblock)._IMEXType==ElmtIMEXType::EXPLICIT) _HasExplicitPart=true;
+        if(elmtSystem.GetIthBulkElmtBlock(iblock)._IMEXType==ElmtIMEXType::IMPLICIT) _IsImplicitPartLinear=false;
+        if(elmtSystem.GetIthBulkElmtBlock(iblock)._IMEXType==ElmtIMEXType::IMPLICITLINEAR&&
+           !IsLinearElmtBlock(elmtSystem.GetIthBulkElmtBlock(iblock))){
+            MessagePrinter::PrintWarningTxt("["+elmtSystem.GetIthBulkElmtBlock(iblock)._ElmtBlockName+"] is 'imex=linear', but its element or material may be nonlinear, it is solved by one linear solve per stage");
+        }
+    }
+
+    // all the qpoints of one element are kept for the batched material calculation
+    _nMaxNodes=mesh.GetBulkMeshNodesNumPerBulkElmt();
+    _mateBatch.Init(_nGPoints,dofHandler.GetDofsNumPerNode()+1);
+    _gpJxW.assign(_nGPoints,0.0);
+    _gpShpVal.assign(_nGPoints*_nMaxNodes,0.0);
+    _gpShpGrad.assign(_nGPoints*_nMaxNodes,Vector3d(0.0));
+    _gpProjList.assign(_nGPoints,map<string,double>());
     
     
+    // the local arrays are allocated once here, to the largest element of the mesh,
+    // FormBulkFE only resizes them to the dofs of each element(no allocation there)
     _localK.Resize(dofHandler.GetMaxDofsNumPerBulkElmt(),dofHandler.GetMaxDofsNumPerBulkElmt());
     _localR.Resize(dofHandler.GetMaxDofsNumPerBulkElmt());
 
@@ -83,6 +167,8 @@ void FESystem::InitBulkFESystem(const Mesh &mesh,
 
     _K.resize(dofHandler.GetMaxDofsNumPerBulkElmt()*dofHandler.GetMaxDofsNumPerBulkElmt(),0.0);
     _R.resize(dofHandler.GetMaxDofsNumPerBulkElmt(),0.0);
+    _maskedCols.resize(dofHandler.GetMaxDofsNumPerBulkElmt(),0);
+    _maskedVals.resize(dofHandler.GetMaxDofsNumPerBulkElmt(),0.0);
 
     _localK.setZero();_localR.setZero();
     _subK.setZero();_subR.setZero();
@@ -99,22 +185,24 @@ void FESystem::InitBulkFESystem(const Mesh &mesh,
     for(e=1;e<=mesh.GetBulkMeshBulkElmtsNum();e+=einc){
         mesh.GetBulkMeshIthBulkElmtNodes(e,_elNodes);
         mesh.GetBulkMeshIthBulkElmtConn(e,_elConn);
-        for(gpInd=1;gpInd<=fe._BulkQPoint.GetQpPointsNum();++gpInd){
-            w=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,0);
-            xi=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,1);
+        ShapeFun &shp=fe.GetBulkShp(_elMeshTypeIndex[e-1]);
+        QPoint &qpoint=fe.GetBulkQPoint(1,_elMeshTypeIndex[e-1]);
+        for(gpInd=1;gpInd<=qpoint.GetQpPointsNum();++gpInd){
+            w=qpoint.GetIthQpPointJthCoord(gpInd,0);
+            xi=qpoint.GetIthQpPointJthCoord(gpInd,1);
             if(nDim==1){
-                fe._BulkShp.Calc(xi,_elNodes,true);
+                shp.Calc(xi,_elNodes,true);
             }
             else if(nDim==2){
-                eta=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,2);
-                fe._BulkShp.Calc(xi,eta,_elNodes,true);
+                eta=qpoint.GetIthQpPointJthCoord(gpInd,2);
+                shp.Calc(xi,eta,_elNodes,true);
             }
             else if(nDim==3){
-                eta=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,2);
-                zeta=fe._BulkQPoint.GetIthQpPointJthCoord(gpInd,3);
-                fe._BulkShp.Calc(xi,eta,zeta,_elNodes,true);
+                eta=qpoint.GetIthQpPointJthCoord(gpInd,2);
+                zeta=qpoint.GetIthQpPointJthCoord(gpInd,3);
+                shp.Calc(xi,eta,zeta,_elNodes,true);
             }
-            DetJac=fe._BulkShp.GetDetJac();
+            DetJac=shp.GetDetJac();
             // JxW=1.0e3*DetJac*w; // it seems this is too small, it may lead the SNES solver failed
             //JxW=1.0e6*DetJac*w;
             JxW=DetJac*w;
@@ -123,4 +211,104 @@ void FESystem::InitBulkFESystem(const Mesh &mesh,
         }
     }
     
-}
\ No newline at end of file
+}//****************************************************************
+void FESystem::CreateBulkElmtWorkBatches(const int &eStart,const int &eEnd,const Mesh &mesh,
+                                         const DofHandler &dofHandler,const ElmtSystem &elmtSystem){
+    // the key of each element is: mesh type, qpoint rule, then the [elmts] sub blocks. The
+    // sub block gives the element, the material and the dofs, so the elements with the same
+    // key share everything except the geometry and the solution. The map keeps the keys
+    // sorted, so the batches of the same mesh type are next to each other
+    map<vector<int>,int> keyToBatch;
+    vector<int> key;
+    int e,ielmt,nKernels,iBatch;
+    const int nDim=mesh.GetDim();
+
+    _elmtWorkBatchList.clear();
+    for(e=eStart+1;e<=eEnd;e++){
+        nKernels=static_cast<int>(dofHandler.GetIthElmtElmtMateTypePair(e).size());
+        key.resize(2+nKernels);
+        key[0]=_elMeshTypeIndex[e-1];
+        key[1]=_elQPointIndex[e-1];
+        for(ielmt=1;ielmt<=nKernels;ielmt++) key[1+ielmt]=dofHandler.GetIthBulkElmtJthKernelBlockIndex(e,ielmt);
+        keyToBatch[key]=0;
+    }
+    // the batch index follows the order of the keys
+    iBatch=0;
+    for(auto &it:keyToBatch) it.second=iBatch++;
+    _elmtWorkBatchList.resize(keyToBatch.size());
+
+    // one elastic flag for each sub element of the local elements, see FormBulkFE
+    int nElmtKernels=0;
+    _ElmtKernelOffset.resize(eEnd-eStart,0);
+    for(e=eStart+1;e<=eEnd;e++){
+        nKernels=static_cast<int>(dofHandler.GetIthElmtElmtMateTypePair(e).size());
+        _ElmtKernelOffset[e-1-eStart]=nElmtKernels;
+        nElmtKernels+=nKernels;
+        key.resize(2+nKernels);
+        key[0]=_elMeshTypeIndex[e-1];
+        key[1]=_elQPointIndex[e-1];
+        for(ielmt=1;ielmt<=nKernels;ielmt++) key[1+ielmt]=dofHandler.GetIthBulkElmtJthKernelBlockIndex(e,ielmt);
+        BulkElmtWorkBatch &workBatch=_elmtWorkBatchList[keyToBatch[key]];
+        if(workBatch._ElmtList.empty()){
+            // the first element sets up the kernels of the batch
+            workBatch._MeshTypeIndex=_elMeshTypeIndex[e-1];
+            workBatch._QPointIndex=_elQPointIndex[e-1];
+            workBatch._nNodes=mesh.GetBulkMeshIthBulkElmtNodesNum(e);
+            workBatch._nKernels=nKernels;
+            for(ielmt=1;ielmt<=nKernels;ielmt++){
+                const ElmtType elmttype=dofHandler.GetIthElmtJthKernelElmtType(e,ielmt);
+                const int blockindex=dofHandler.GetIthBulkElmtJthKernelBlockIndex(e,ielmt);
+                workBatch._BlockIndexList.push_back(blockindex);
+                workBatch._ElmtTypeList.push_back(elmttype);
+                workBatch._MateTypeList.push_back(dofHandler.GetIthElmtJthKernelMateType(e,ielmt));
+                workBatch._MateIndexList.push_back(dofHandler.GetIthBulkElmtJthKernelMateIndex(e,ielmt));
+                workBatch._LocalDofIndexList.push_back(dofHandler.GetIthBulkElmtJthKernelDofIndex(e,ielmt));
+                workBatch._QpKernelList.push_back(elmtSystem.GetBulkElmtQpKernel(elmttype,nDim,workBatch._nNodes));
+                workBatch._HasElmtLevelPartList.push_back(elmtSystem.HasBulkElmtElmtLevelPart(elmttype));
+                workBatch._IsElmtLevelOnlyList.push_back(elmtSystem.IsBulkElmtElmtLevelOnly(elmttype));
+                workBatch._IsJacobianTangentOnlyList.push_back(elmtSystem.IsBulkElmtJacobianTangentOnly(elmttype));
+                workBatch._HourglassCoefList.push_back(elmtSystem.GetIthBulkElmtBlock(blockindex)._HourglassCoef);
+                const vector<int> mask=elmtSystem.GetBulkElmtCouplingMask(elmttype,elmtSystem.GetIthBulkElmtBlock(blockindex)._nDofs);
+                workBatch._CouplingMaskList.push_back(mask);
+                workBatch._IsJacobianZeroList.push_back(find(mask.begin(),mask.end(),1)==mask.end());
+                workBatch._IsFDJacobianList.push_back(elmtSystem.GetIthBulkElmtBlock(blockindex)._UseFDJacobian);
+                workBatch._DensityList.push_back(elmtSystem.GetIthBulkElmtBlock(blockindex)._Density);
+                workBatch._IsExplicitList.push_back(elmtSystem.GetIthBulkElmtBlock(blockindex)._IMEXType==ElmtIMEXType::EXPLICIT);
+                workBatch._IsFrozenList.push_back(false);
+            }
+            // the batch kernel only gives the analytic jacobian
+            if(nKernels==1&&!workBatch._IsFDJacobianList[0]){
+                workBatch._BatchKernel=elmtSystem.GetBulkElmtBatchKernel(workBatch._ElmtTypeList[0],nDim,workBatch._nNodes);
+            }
+        }
+        workBatch._ElmtList.push_back(e-1);
+    }
+    _ElasticKernelList.assign(nElmtKernels,0);
+    _IsElasticKernelListFilled=false;_IsElasticKernelListReusable=false;
+}
+//*******************************************************
+//*** the kernels which only act on the frozen dofs
+//*******************************************************
+void FESystem::SetFrozenDofs(const vector<bool> &isFrozenDof){
+    _HasFrozenKernel=false;
+    for(BulkElmtWorkBatch &workBatch:_elmtWorkBatchList){
+        for(int ielmt=1;ielmt<=workBatch._nKernels;ielmt++){
+            bool IsFrozen=true;
+            for(const int &dofid:workBatch._LocalDofIndexList[ielmt-1]){
+                if(!isFrozenDof[dofid-1]){
+                    IsFrozen=false;
+                    break;
+                }
+            }
+            workBatch._IsFrozenList[ielmt-1]=IsFrozen;
+            if(IsFrozen) _HasFrozenKernel=true;
+        }
+    }
+}
+//*******************************************************
+void FESystem::ClearFrozenDofs(){
+    for(BulkElmtWorkBatch &workBatch:_elmtWorkBatchList){
+        fill(workBatch._IsFrozenList.begin(),workBatch._IsFrozenList.end(),false);
+    }
+    _HasFrozenKernel=false;
+}
@@ -23,6 +23,15 @@ bool InputSystem::ReadElmtBlock(ifstream &in,string str,const int &lastendlinenu
     //    dofs=u1 u2
     //    mate=mate1 [can be ignored]
     //    block=all  [can be ignored]
+    //    qptype=gauss[gausslobatto] [can be ignored, the type of [qpoint] is used]
+    //    qporder=2  [can be ignored, the order of [qpoint] is used]
+    //    hourglass=0.05 [can be ignored, only for mechanicsri]
+    //    jacobian=analytic[fd] [can be ignored, fd uses the colored finite difference]
+    //    density=1.0 [can be ignored, only for the second order time stepping(alpha2, newmark)]
+    //    imex=implicit[linear,explicit] [can be ignored, only for the arkimex time stepping]
+    //                   'linear' is taken on trust, the implicit part is solved by one linear
+    //                   solve per stage, a warning is given if the element or material is
+    //                   not a known linear one
     //  [end]
     // [end]
     bool HasElmtBlock=false;
@@ -67,6 +76,14 @@ bool InputSystem::ReadElmtBlock(ifstream &in,string str,const int &lastendlinenu
             else{
                 elmtBlock._ElmtBlockName=tempstr.substr(tempstr.find_first_of('[')+1,tempstr.find_first_of(']')-1);
                 HasElmtBlock=true;
+                // the qpoint options are optional, they should not be inherited from the previous sub block
+                elmtBlock._QpOrder=-1;
+                elmtBlock._HasQpType=false;
+                elmtBlock._QpType=QPointType::GAUSSLEGENDRE;
+                elmtBlock._HourglassCoef=0.05;
+                elmtBlock._UseFDJacobian=false;
+                elmtBlock._Density=0.0;
+                elmtBlock._IMEXType=ElmtIMEXType::IMPLICIT;
             }
             while(str.find("[end]")==string::npos&&str.find("[END]")==string::npos){
                 getline(in,str);linenum+=1;
@@ -79,7 +96,108 @@ bool InputSystem::ReadElmtBlock(ifstream &in,string str,const int &lastendlinenu
                     continue;
                 }
 
-                if(str.find("type=")!=string::npos){
+                if(str.find("qptype=")!=string::npos){
+                    // the qpoint type of current block, it overrides the one of [qpoint]
+                    substr=str.substr(str.find_first_of('=')+1);
+                    if(substr=="gauss"){
+                        elmtBlock._QpType=QPointType::GAUSSLEGENDRE;
+                        elmtBlock._HasQpType=true;
+                    }
+                    else if(substr=="gausslobatto"){
+                        elmtBlock._QpType=QPointType::GAUSSLOBATTO;
+                        elmtBlock._HasQpType=true;
+                    }
+                    else{
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::PrintErrorInLineNumber(linenum);
+                        MessagePrinter::PrintErrorTxt("unsupported qpoint type in [elmts] sub block, 'qptype=gauss[gausslobatto]' is expected",false);
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::AsFem_Exit();
+                        return false;
+                    }
+                }
+                else if(str.find("qporder=")!=string::npos){
+                    // the qpoint order of current block, it overrides the one of [qpoint]
+                    substr=str.substr(str.find_first_of('=')+1);
+                    number=StringUtils::SplitStrNum(substr);
+                    if(number.size()<1||int(number[0])<0||int(number[0])>7){
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::PrintErrorInLineNumber(linenum);
+                        MessagePrinter::PrintErrorTxt("invalid qpoint order in [elmts] sub block, 'qporder=integer(0~7)' is expected",false);
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::AsFem_Exit();
+                        return false;
+                    }
+                    elmtBlock._QpOrder=int(number[0]);
+                }
+                else if(str.find("hourglass=")!=string::npos){
+                    // the hourglass stiffness coefficient of the mechanicsri element
+                    substr=str.substr(str.find_first_of('=')+1);
+                    number=StringUtils::SplitStrNum(substr);
+                    if(number.size()<1||number[0]<0.0){
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::PrintErrorInLineNumber(linenum);
+                        MessagePrinter::PrintErrorTxt("invalid hourglass coefficient in [elmts] sub block, 'hourglass=real(>=0)' is expected",false);
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::AsFem_Exit();
+                        return false;
+                    }
+                    elmtBlock._HourglassCoef=number[0];
+                }
+                else if(str.find("density=")!=string::npos){
+                    // the mass matrix of current block, it is assembled once, see FESystem::FormBulkMass
+                    substr=str.substr(str.find_first_of('=')+1);
+                    number=StringUtils::SplitStrNum(substr);
+                    if(number.size()<1||number[0]<0.0){
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::PrintErrorInLineNumber(linenum);
+                        MessagePrinter::PrintErrorTxt("invalid density in [elmts] sub block, 'density=real(>=0)' is expected",false);
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::AsFem_Exit();
+                        return false;
+                    }
+                    elmtBlock._Density=number[0];
+                }
+                else if(str.find("imex=")!=string::npos){
+                    // the stiff linear terms can be implicit, while the nonlinear ones are explicit
+                    substr=str.substr(str.find_first_of('=')+1);
+                    if(substr=="implicit"){
+                        elmtBlock._IMEXType=ElmtIMEXType::IMPLICIT;
+                    }
+                    else if(substr=="linear"){
+                        elmtBlock._IMEXType=ElmtIMEXType::IMPLICITLINEAR;
+                    }
+                    else if(substr=="explicit"){
+                        elmtBlock._IMEXType=ElmtIMEXType::EXPLICIT;
+                    }
+                    else{
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::PrintErrorInLineNumber(linenum);
+                        MessagePrinter::PrintErrorTxt("invalid imex option in [elmts] sub block, 'imex=implicit[linear,explicit]' is expected",false);
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::AsFem_Exit();
+                        return false;
+                    }
+                }
+                else if(str.find("jacobian=")!=string::npos){
+                    // the elements without the analytic tangent can use the finite difference one
+                    substr=str.substr(str.find_first_of('=')+1);
+                    if(substr.find("analytic")!=string::npos && substr.length()==8){
+                        elmtBlock._UseFDJacobian=false;
+                    }
+                    else if(substr.find("fd")!=string::npos && substr.length()==2){
+                        elmtBlock._UseFDJacobian=true;
+                    }
+                    else{
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::PrintErrorInLineNumber(linenum);
+                        MessagePrinter::PrintErrorTxt("invalid jacobian option in [elmts] sub block, 'jacobian=analytic[fd]' is expected",false);
+                        MessagePrinter::PrintStars();
+                        MessagePrinter::AsFem_Exit();
+                        return false;
+                    }
+                }
+                else if(str.find("type=")!=string::npos){
                     substr=str.substr(str.find_first_of('=')+1);
                     if(substr.find("poisson")!=string::npos && substr.length()==7){
                         elmtBlock._ElmtTypeName="poisson";
@@ -106,6 +224,18 @@ bool InputSystem::ReadElmtBlock(ifstream &in,string str,const int &lastendlinenu
                         elmtBlock._ElmtType=ElmtType::MECHANICSELMT;
                         HasElmtType=true;
                     }
+                    else if(substr.find("mechanicsri")!=string::npos && substr.length()==11){
+                        // one-point(reduced) integration with the hourglass control
+                        elmtBlock._ElmtTypeName="mechanicsri";
+                        elmtBlock._ElmtType=ElmtType::MECHANICSRIELMT;
+                        HasElmtType=true;
+                    }
+                    else if(substr.find("mechanicsbbar")!=string::npos && substr.length()==13){
+                        // selective-reduced(B-bar) integration for the nearly incompressible case
+                        elmtBlock._ElmtTypeName="mechanicsbbar";
+                        elmtBlock._ElmtType=ElmtType::MECHANICSBBARELMT;
+                        HasElmtType=true;
+                    }
                     else if(substr.find("cahnhilliard")!=string::npos && substr.length()==12){
                         elmtBlock._ElmtTypeName="cahnhilliard";
                         elmtBlock._ElmtType=ElmtType::CAHNHILLIARDELMT;
@@ -20,6 +20,13 @@ bool InputSystem::ReadFEJobBlock(ifstream &in,string str,int &linenum,FEJobBlock
     // [job]
     //   type=static[transient]
     //   debug=true[false,dep]
+    //   matecache=false[true]
+    //   matecachemem=512.0
+    //   elmtbatch=false[true]
+    //   fusedassembly=false[true]
+    //   loadsteps=1        [only for static, the load is ramped in loadsteps increments]
+    //   arclength=false[true] [only for static, the arc-length continuation]
+    //   maxcutbacks=5      [only for static, the max successive cutbacks of one increment]
     // [end]
     char buff[55];
     bool HasType=false;
@@ -85,6 +92,108 @@ bool InputSystem::ReadFEJobBlock(ifstream &in,string str,int &linenum,FEJobBlock
                 MessagePrinter::AsFem_Exit();
             }
         }
+        else if(str.find("elmtbatch=")!=string::npos){
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            if(substr.find("true")!=string::npos||
+               substr.find("TRUE")!=string::npos){
+                feJobBlock._UseElmtBatch=true;
+            }
+            else if(substr.find("false")!=string::npos||
+                substr.find("FALSE")!=string::npos){
+                feJobBlock._UseElmtBatch=false;
+            }
+            else{
+                snprintf(buff,55,"line-%d has some errors",linenum);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                MessagePrinter::PrintErrorTxt(" unknown option for elmtbatch= in [job] block, true[false] is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+        }
+        else if(str.find("fusedassembly=")!=string::npos){
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            if(substr.find("true")!=string::npos||
+               substr.find("TRUE")!=string::npos){
+                feJobBlock._UseFusedAssembly=true;
+            }
+            else if(substr.find("false")!=string::npos||
+                substr.find("FALSE")!=string::npos){
+                feJobBlock._UseFusedAssembly=false;
+            }
+            else{
+                snprintf(buff,55,"line-%d has some errors",linenum);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                MessagePrinter::PrintErrorTxt(" unknown option for fusedassembly= in [job] block, true[false] is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+        }
+        else if(str.find("loadsteps=")!=string::npos){
+            vector<double> numbers=StringUtils::SplitStrNum(str);
+            if(numbers.size()<1||static_cast<int>(numbers[0])<1){
+                snprintf(buff,55,"line-%d has some errors",linenum);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                MessagePrinter::PrintErrorTxt(" loadsteps= in [job] block needs a positive integer");
+                MessagePrinter::AsFem_Exit();
+            }
+            feJobBlock._nLoadSteps=static_cast<int>(numbers[0]);
+        }
+        else if(str.find("maxcutbacks=")!=string::npos){
+            vector<double> numbers=StringUtils::SplitStrNum(str);
+            if(numbers.size()<1||static_cast<int>(numbers[0])<0){
+                snprintf(buff,55,"line-%d has some errors",linenum);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                MessagePrinter::PrintErrorTxt(" maxcutbacks= in [job] block needs a non-negative integer");
+                MessagePrinter::AsFem_Exit();
+            }
+            feJobBlock._MaxCutbacks=static_cast<int>(numbers[0]);
+        }
+        else if(str.find("arclength=")!=string::npos){
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            if(substr.find("true")!=string::npos||
+               substr.find("TRUE")!=string::npos){
+                feJobBlock._UseArcLength=true;
+            }
+            else if(substr.find("false")!=string::npos||
+                substr.find("FALSE")!=string::npos){
+                feJobBlock._UseArcLength=false;
+            }
+            else{
+                snprintf(buff,55,"line-%d has some errors",linenum);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                MessagePrinter::PrintErrorTxt(" unknown option for arclength= in [job] block, true[false] is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+        }
+        else if(str.find("matecachemem=")!=string::npos){
+            vector<double> numbers=StringUtils::SplitStrNum(str);
+            if(numbers.size()<1||numbers[0]<=0.0){
+                snprintf(buff,55,"line-%d has some errors",linenum);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                MessagePrinter::PrintErrorTxt(" matecachemem= in [job] block needs a positive memory size(MB)");
+                MessagePrinter::AsFem_Exit();
+            }
+            feJobBlock._MateCacheMemMB=numbers[0];
+        }
+        else if(str.find("matecache=")!=string::npos){
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            if(substr.find("true")!=string::npos||
+               substr.find("TRUE")!=string::npos){
+                feJobBlock._UseMateCache=true;
+            }
+            else if(substr.find("false")!=string::npos||
+                substr.find("FALSE")!=string::npos){
+                feJobBlock._UseMateCache=false;
+            }
+            else{
+                snprintf(buff,55,"line-%d has some errors",linenum);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                MessagePrinter::PrintErrorTxt(" unknown option for matecache= in [job] block, true[false] is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+        }
         else if(str.find("[]")!=string::npos){
             snprintf(buff,55,"line-%d has some errors",linenum);
             MessagePrinter::PrintErrorTxt(string(buff));
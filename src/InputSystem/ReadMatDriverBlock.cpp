@@ -0,0 +1,177 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Read the [matdriver] block for the material point
+//+++          driver
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "InputSystem/InputSystem.h"
+
+bool InputSystem::ReadMatDriverBlock(ifstream &in,string str,int &linenum,MatDriverBlock &matDriverBlock){
+    // matdriver block format:
+    // [matdriver]
+    //   mate=mate1                     // optional, the first [mates] sub block by default
+    //   dim=3
+    //   type=strain[gradu,deformgrad]
+    //   target=0.01 0.0 0.0 0.0 0.0 0.0// 6 values(11,22,33,23,13,12) for strain, 9 values(row by row) for others
+    //   steps=100
+    //   unload=false[true]
+    //   dt=1.0
+    //   repeats=100000
+    //   batch=8
+    //   fdcheck=true[false]
+    //   fdeps=1.0e-7
+    //   output=matdriver.csv
+    // [end]
+    vector<double> numbers;
+    string substr,name;
+    bool HasTarget=false;
+    // now str already contains [matdriver]
+    getline(in,str);linenum+=1;
+    str=StringUtils::StrToLower(str);
+
+    while(str.find("[end]")==string::npos&&
+          str.find("[END]")==string::npos){
+        if(StringUtils::IsCommentLine(str)||str.length()<1){
+            getline(in,str);linenum+=1;
+            str=StringUtils::StrToLower(str);
+            continue;
+        }
+        substr=str.substr(str.find_first_of('=')+1);
+        name=StringUtils::RemoveStrSpace(substr);
+        if(str.find("mate=")!=string::npos){
+            if(name.size()<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("no material block name is found after 'mate=' in the [matdriver] block");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._MateBlockName=name;
+        }
+        else if(str.find("dim=")!=string::npos){
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||int(numbers[0])<1||int(numbers[0])>3){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid dim= in the [matdriver] block, dim=1,2 or 3 is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._nDim=int(numbers[0]);
+        }
+        else if(str.find("type=")!=string::npos){
+            if(name=="strain"){
+                matDriverBlock._PathType=MatDriverPathType::STRAIN;
+            }
+            else if(name=="gradu"){
+                matDriverBlock._PathType=MatDriverPathType::GRADU;
+            }
+            else if(name=="deformgrad"){
+                matDriverBlock._PathType=MatDriverPathType::DEFORMGRAD;
+            }
+            else{
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("unsupported type in the [matdriver] block, type=strain[gradu,deformgrad] is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._PathTypeName=name;
+        }
+        else if(str.find("target=")!=string::npos){
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()!=6&&numbers.size()!=9){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid target= in the [matdriver] block, 6 values(strain) or 9 values(gradu,deformgrad) are expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._Target=numbers;
+            HasTarget=true;
+        }
+        else if(str.find("steps=")!=string::npos){
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||int(numbers[0])<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid steps= in the [matdriver] block, steps=positive integer is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._nSteps=int(numbers[0]);
+        }
+        else if(str.find("unload=")!=string::npos){
+            matDriverBlock._IsUnload=(name.find("true")!=string::npos);
+        }
+        else if(str.find("fdcheck=")!=string::npos){
+            matDriverBlock._IsFDCheck=(name.find("true")!=string::npos);
+        }
+        else if(str.find("fdeps=")!=string::npos){
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||numbers[0]<=0.0){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid fdeps= in the [matdriver] block, fdeps=positive real number is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._FDEps=numbers[0];
+        }
+        else if(str.find("dt=")!=string::npos){
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||numbers[0]<=0.0){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid dt= in the [matdriver] block, dt=positive real number is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._dt=numbers[0];
+        }
+        else if(str.find("repeats=")!=string::npos){
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||int(numbers[0])<0){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid repeats= in the [matdriver] block, repeats=integer(0 to skip) is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._nRepeats=int(numbers[0]);
+        }
+        else if(str.find("batch=")!=string::npos){
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||int(numbers[0])<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid batch= in the [matdriver] block, batch=positive integer is expected");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._BatchSize=int(numbers[0]);
+        }
+        else if(str.find("output=")!=string::npos){
+            if(name.size()<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("no file name is found after 'output=' in the [matdriver] block");
+                MessagePrinter::AsFem_Exit();
+            }
+            matDriverBlock._OutputFileName=name;
+        }
+        else{
+            MessagePrinter::PrintErrorInLineNumber(linenum);
+            MessagePrinter::PrintErrorTxt("unknown option in the [matdriver] block");
+            MessagePrinter::AsFem_Exit();
+        }
+        getline(in,str);linenum+=1;
+        str=StringUtils::StrToLower(str);
+    }
+    if(!HasTarget){
+        MessagePrinter::PrintErrorTxt("no target= is found in the [matdriver] block");
+        MessagePrinter::AsFem_Exit();
+        return false;
+    }
+    if(matDriverBlock._PathType==MatDriverPathType::STRAIN&&matDriverBlock._Target.size()!=6){
+        MessagePrinter::PrintErrorTxt("type=strain in the [matdriver] block needs 6 target values(11,22,33,23,13,12)");
+        MessagePrinter::AsFem_Exit();
+        return false;
+    }
+    if(matDriverBlock._PathType!=MatDriverPathType::STRAIN&&matDriverBlock._Target.size()!=9){
+        MessagePrinter::PrintErrorTxt("type=gradu[deformgrad] in the [matdriver] block needs 9 target values(row by row)");
+        MessagePrinter::AsFem_Exit();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Function for reading the input file of the material
+//+++          point driver, only [mates] and [matdriver] are used
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "InputSystem/InputSystem.h"
+
+bool InputSystem::ReadMatDriverInputFile(MateSystem &mateSystem,MatDriverBlock &matDriverBlock){
+    ifstream in;
+    string str;
+    int linenum=0;
+
+    bool HasMateBlock=false;
+    bool HasMatDriverBlock=false;
+
+    if(!_HasInputFileName){
+        PetscPrintf(PETSC_COMM_WORLD,"*** Please enter the input file name:");
+        cin>>_InputFileName;
+        _HasInputFileName=true;
+    }
+    in.open(_InputFileName.c_str(),ios::in);
+    while(!in.is_open()){
+        MessagePrinter::PrintErrorTxt("can\'t open the input file");
+        PetscPrintf(PETSC_COMM_WORLD,"*** Please enter the correct input file name:");
+        cin>>_InputFileName;
+        in.open(_InputFileName.c_str(),ios::in);
+    }
+
+    matDriverBlock.Init();
+    while(!in.eof()){
+        getline(in,str);linenum+=1;
+        str=StringUtils::RemoveStrSpace(str);
+        str=StringUtils::StrToLower(str);
+        if(StringUtils::IsCommentLine(str)||str.size()<1) continue;
+
+        if(str.find("[mates]")!=string::npos){
+            int lastendlinenum;
+            if(StringUtils::IsBracketMatch(in,linenum,lastendlinenum)){
+                if(ReadMateBlock(in,str,lastendlinenum,linenum,mateSystem)){
+                    HasMateBlock=true;
+                }
+                else{
+                    MessagePrinter::PrintErrorTxt("some errors detected in the [mates] block, please check your input file");
+                    MessagePrinter::AsFem_Exit();
+                }
+            }
+            else{
+                MessagePrinter::PrintErrorTxt("[mates]/[end] bracket pair is not match, please check your input file");
+                MessagePrinter::AsFem_Exit();
+                return false;
+            }
+        }
+        else if(str.find("[matdriver]")!=string::npos){
+            if(ReadMatDriverBlock(in,str,linenum,matDriverBlock)){
+                HasMatDriverBlock=true;
+            }
+            else{
+                MessagePrinter::PrintErrorTxt("some errors detected in the [matdriver] block, please check your input file");
+                MessagePrinter::AsFem_Exit();
+            }
+        }
+    }
+    in.close();
+
+    if(!HasMateBlock){
+        MessagePrinter::PrintErrorTxt("no [mates] block is found, the material point driver needs at least one material");
+        MessagePrinter::AsFem_Exit();
+        return false;
+    }
+    if(!HasMatDriverBlock){
+        MessagePrinter::PrintErrorTxt("no [matdriver] block is found, the strain path of the material point driver is required");
+        MessagePrinter::AsFem_Exit();
+        return false;
+    }
+    return true;
+}
@@ -21,6 +21,10 @@ bool InputSystem::ReadNonlinearSolverBlock(ifstream &in,string str,int &linenum,
     //   type=lu [gmres]
     //   maxiters=10000
     //   tol=1.0e-9
+    //   npc=none [newton, only for anderson and ngmres]
+    //   depth=10 [can be ignored, the mixing depth of anderson and ngmres]
+    //   damping=0.5 [can be ignored, the mixing damping(beta) of anderson, for
+    //                ngmres it switches to the line search selection and damps it]
     // [end]
     
 
@@ -88,6 +92,12 @@ bool InputSystem::ReadNonlinearSolverBlock(ifstream &in,string str,int &linenum,
                 _nonlinearSolverBlock._SolverTypeName="ncg";
                 _nonlinearSolverBlock._SolverType=NonlinearSolverType::NEWTONCG;
             }
+            else if((substr.find("anderson")!=string::npos||substr.find("ANDERSON")!=string::npos)&&
+               substr.length()==8){
+                HasType=true;
+                _nonlinearSolverBlock._SolverTypeName="anderson";
+                _nonlinearSolverBlock._SolverType=NonlinearSolverType::ANDERSON;
+            }
             else{
                 MessagePrinter::PrintErrorInLineNumber(linenum);
                 MessagePrinter::PrintErrorTxt("unsupported solver type in the [nonlinearsolver] block");
@@ -215,6 +225,50 @@ bool InputSystem::ReadNonlinearSolverBlock(ifstream &in,string str,int &linenum,
                 MessagePrinter::AsFem_Exit();
             }
         }
+        else if(str.find("npc=")!=string::npos||
+                 str.find("NPC=")!=string::npos){
+            // the nonlinear preconditioner of anderson and ngmres
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            substr=StringUtils::RemoveStrSpace(substr);
+            if(substr=="newton"||substr=="NEWTON"){
+                _nonlinearSolverBlock._UseNewtonNPC=true;
+            }
+            else if(substr=="none"||substr=="NONE"){
+                _nonlinearSolverBlock._UseNewtonNPC=false;
+            }
+            else{
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid npc= option in [nonlinearsolver] block, please use newton or none",false);
+                MessagePrinter::AsFem_Exit();
+            }
+        }
+        else if(str.find("depth=")!=string::npos||
+                 str.find("Depth=")!=string::npos||
+                 str.find("DEPTH=")!=string::npos){
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||int(numbers[0])<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid depth= number in [nonlinearsolver] block, depth=integer(>=1) should be given",false);
+                MessagePrinter::AsFem_Exit();
+            }
+            _nonlinearSolverBlock._Depth=int(numbers[0]);
+        }
+        else if(str.find("damping=")!=string::npos||
+                 str.find("Damping=")!=string::npos||
+                 str.find("DAMPING=")!=string::npos){
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||numbers[0]<=0.0||numbers[0]>1.0){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid damping= number in [nonlinearsolver] block, damping=real(0<damping<=1) should be given",false);
+                MessagePrinter::AsFem_Exit();
+            }
+            _nonlinearSolverBlock._Damping=numbers[0];
+        }
         else if(str.find("[]")!=string::npos){
             MessagePrinter::PrintErrorInLineNumber(linenum);
             MessagePrinter::PrintErrorTxt("the bracket pair is not complete in the [nonlinearsolver] block",false);
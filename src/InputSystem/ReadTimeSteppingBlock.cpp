@@ -19,13 +19,16 @@
 bool InputSystem::ReadTimeSteppingBlock(ifstream &in,string str,int &linenum,TimeStepping &timestepping){
     // dof block format:
     // [timestepping]
-    //   type=be[cn,alpha,...]
+    //   type=be[cn,alpha,alpha2,newmark,arkimex...]
     //   dt=1.0e-5
     //   time=1.0e-3
     //   optiters=3
     //   adaptive=true[false]
     //   growthfactor=1.1
     //   cutfactor=0.85
+    //   rhoinf=0.5 [can be ignored, only for alpha2]
+    //   slowdofs=ux uy [can be ignored, for the multirate stepping]
+    //   subcycles=100 [can be ignored, the dt of slowdofs is dt*subcycles]
     // [end]
     
 
@@ -75,6 +78,24 @@ bool InputSystem::ReadTimeSteppingBlock(ifstream &in,string str,int &linenum,Tim
                 timesteppingBlock._TimeSteppingType=TimeSteppingType::ROSW;
                 timesteppingBlock._TimeSteppingTypeName="rosenbrock-w";
             }
+            else if((substr.find("alpha2")!=string::npos||substr.find("ALPHA2")!=string::npos)&&
+               substr.length()==6){
+                HasType=true;
+                timesteppingBlock._TimeSteppingType=TimeSteppingType::ALPHA2;
+                timesteppingBlock._TimeSteppingTypeName="generalized-alpha(2nd order)";
+            }
+            else if((substr.find("newmark")!=string::npos||substr.find("NEWMARK")!=string::npos)&&
+               substr.length()==7){
+                HasType=true;
+                timesteppingBlock._TimeSteppingType=TimeSteppingType::NEWMARK;
+                timesteppingBlock._TimeSteppingTypeName="newmark(2nd order)";
+            }
+            else if((substr.find("arkimex")!=string::npos||substr.find("ARKIMEX")!=string::npos)&&
+               substr.length()==7){
+                HasType=true;
+                timesteppingBlock._TimeSteppingType=TimeSteppingType::ARKIMEX;
+                timesteppingBlock._TimeSteppingTypeName="imex runge-kutta";
+            }
             else{
                 MessagePrinter::PrintErrorInLineNumber(linenum);
                 MessagePrinter::PrintErrorTxt("unsupported type in the [timestepping] block");
@@ -250,6 +271,30 @@ bool InputSystem::ReadTimeSteppingBlock(ifstream &in,string str,int &linenum,Tim
                 timesteppingBlock._CutBackFactor=numbers[0];
             }
         }
+        else if(str.find("rhoinf=")!=string::npos||
+                 str.find("RhoInf=")!=string::npos||
+                 str.find("RHOINF=")!=string::npos){
+            if(!HasType){
+                MessagePrinter::PrintErrorTxt("no 'type=' found in the [timestepping] block, rhoinf= should be given after 'type='");
+                MessagePrinter::AsFem_Exit();
+            }
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("no rhoinf found in the [timestepping] block, rhoinf=real(0~1) should be given");
+                MessagePrinter::AsFem_Exit();
+            }
+            else{
+                if(numbers[0]<0.0||numbers[0]>1.0){
+                    MessagePrinter::PrintErrorInLineNumber(linenum);
+                    MessagePrinter::PrintErrorTxt("invalid rhoinf found in [timestepping] block, rhoinf=real(0~1) should be given");
+                    MessagePrinter::AsFem_Exit();
+                }
+                timesteppingBlock._RhoInf=numbers[0];
+            }
+        }
         else if(str.find("adaptive=")!=string::npos||
                 str.find("Adaptive=")!=string::npos||
                 str.find("ADAPTIVE=")!=string::npos){
@@ -275,6 +320,32 @@ bool InputSystem::ReadTimeSteppingBlock(ifstream &in,string str,int &linenum,Tim
                 MessagePrinter::AsFem_Exit();
             }
         }
+        else if(str.find("slowdofs=")!=string::npos||
+                 str.find("SlowDofs=")!=string::npos||
+                 str.find("SLOWDOFS=")!=string::npos){
+            // the dof names are checked by TimeStepping, where the dofs are known
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            timesteppingBlock._SlowDofNameList=StringUtils::SplitStr(substr,' ');
+            if(timesteppingBlock._SlowDofNameList.size()<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("no dof name found for slowdofs= in the [timestepping] block, slowdofs=dof1 dof2 ... should be given");
+                MessagePrinter::AsFem_Exit();
+            }
+        }
+        else if(str.find("subcycles=")!=string::npos||
+                 str.find("SubCycles=")!=string::npos||
+                 str.find("SUBCYCLES=")!=string::npos){
+            int i=str.find_first_of('=');
+            string substr=str.substr(i+1,str.length());
+            numbers=StringUtils::SplitStrNum(substr);
+            if(numbers.size()<1||int(numbers[0])<1){
+                MessagePrinter::PrintErrorInLineNumber(linenum);
+                MessagePrinter::PrintErrorTxt("invalid subcycles in the [timestepping] block, subcycles=integer(>=1) should be given");
+                MessagePrinter::AsFem_Exit();
+            }
+            timesteppingBlock._nSubcycles=int(numbers[0]);
+        }
         else if(str.find("[]")!=string::npos){
             MessagePrinter::PrintErrorInLineNumber(linenum);
             MessagePrinter::PrintErrorTxt("the bracket pair is not complete in the [timestepping] block",false);
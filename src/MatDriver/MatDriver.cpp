@@ -0,0 +1,297 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Implement the material point driver
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "MatDriver/MatDriver.h"
+
+MatDriver::MatDriver(){
+    _MateType=MateType::NULLMATE;
+    _MateIndex=0;
+    _nDim=3;
+    _dt=1.0;
+    _gpCoord=0.0;
+}
+//*********************************************************
+void MatDriver::FindMateBlock(const MateSystem &mateSystem,const MatDriverBlock &matDriverBlock){
+    vector<MateBlock> mateBlockList=mateSystem.GetMateBlockVec();
+    _MateIndex=0;
+    if(matDriverBlock._MateBlockName.size()<1){
+        _MateIndex=1;
+    }
+    else{
+        for(int i=1;i<=static_cast<int>(mateBlockList.size());i++){
+            if(mateBlockList[i-1]._MateBlockName==matDriverBlock._MateBlockName){
+                _MateIndex=i;
+                break;
+            }
+        }
+    }
+    if(_MateIndex<1||_MateIndex>static_cast<int>(mateBlockList.size())){
+        MessagePrinter::PrintErrorTxt("can\'t find the material block ["+matDriverBlock._MateBlockName+"] given in the [matdriver] block");
+        MessagePrinter::AsFem_Exit();
+    }
+    _MateType=mateBlockList[_MateIndex-1]._MateType;
+}
+//*********************************************************
+void MatDriver::Init(MateSystem &mateSystem,const MatDriverBlock &matDriverBlock){
+    FindMateBlock(mateSystem,matDriverBlock);
+    _nDim=matDriverBlock._nDim;
+    _dt=matDriverBlock._dt;
+
+    _gpU.assign(_nMaxDofs,0.0);_gpUOld.assign(_nMaxDofs,0.0);
+    _gpUdot.assign(_nMaxDofs,0.0);_gpUdotOld.assign(_nMaxDofs,0.0);
+    _gpGradU.assign(_nMaxDofs,Vector3d(0.0));_gpGradUOld.assign(_nMaxDofs,Vector3d(0.0));
+    _gpGradUdot.assign(_nMaxDofs,Vector3d(0.0));_gpGradUdotOld.assign(_nMaxDofs,Vector3d(0.0));
+
+    // the state at zero load is the initial history, the same as the FE system does
+    mateSystem.InitBulkMateLibs(_MateType,_MateIndex,_nDim,_gpCoord,_gpU,_gpUdot,_gpGradU,_gpGradUdot);
+    mateSystem.GetMaterialsOldPtr()=mateSystem.GetMaterialsPtr();
+}
+//*********************************************************
+void MatDriver::SetGradU(const MatDriverBlock &matDriverBlock,const double &factor){
+    // the i-th displacement(dof i) gives the i-th row of grad(u)
+    double H[3][3];
+    const vector<double> &a=matDriverBlock._Target;
+    if(matDriverBlock._PathType==MatDriverPathType::STRAIN){
+        H[0][0]=a[0];H[1][1]=a[1];H[2][2]=a[2];
+        H[1][2]=H[2][1]=a[3];
+        H[0][2]=H[2][0]=a[4];
+        H[0][1]=H[1][0]=a[5];
+    }
+    else{
+        for(int i=0;i<3;i++){
+            for(int j=0;j<3;j++){
+                H[i][j]=a[3*i+j];
+                if(matDriverBlock._PathType==MatDriverPathType::DEFORMGRAD&&i==j) H[i][j]-=1.0;
+            }
+        }
+    }
+    for(int i=1;i<=_nDim;i++){
+        _gpGradU[i]=0.0;
+        for(int j=1;j<=_nDim;j++){
+            _gpGradU[i](j)=factor*H[i-1][j-1];
+        }
+    }
+}
+//*********************************************************
+void MatDriver::RunMate(MateSystem &mateSystem,const double &t){
+    for(int i=1;i<=_nDim;i++){
+        _gpGradUdot[i]=(_gpGradU[i]-_gpGradUOld[i])/_dt;
+    }
+    mateSystem.RunBulkMateLibs(_MateType,_MateIndex,_nDim,t,_dt,_gpCoord,
+                               _gpU,_gpUOld,_gpUdot,_gpUdotOld,
+                               _gpGradU,_gpGradUOld,_gpGradUdot,_gpGradUdotOld);
+}
+//*********************************************************
+double MatDriver::CheckJacobian(MateSystem &mateSystem,const double &t,const double &eps){
+    // the material reports d(stress)/d(strain), so the finite difference of the stress
+    // w.r.t. grad(u) is compared with jacobian:d(strain)/d(grad(u))
+    if(mateSystem.GetRank2MatePtr().count("stress")<1||
+       mateSystem.GetRank4MatePtr().count("jacobian")<1){
+        return -1.0;
+    }
+    const RankFourTensor Jac=mateSystem.GetRank4MatePtr().at("jacobian");
+    const bool HasStrain=mateSystem.GetRank2MatePtr().count("strain")>0;
+
+    RankTwoTensor StressP(0.0),StressM(0.0),StrainP(0.0),StrainM(0.0);
+    RankTwoTensor dStress(0.0),dStrain(0.0);
+    double MaxErr=0.0,MaxVal=0.0,sum;
+    Vector3d GradUBase;
+
+    for(int k=1;k<=_nDim;k++){
+        GradUBase=_gpGradU[k];
+        for(int l=1;l<=_nDim;l++){
+            _gpGradU[k](l)=GradUBase(l)+eps;
+            RunMate(mateSystem,t);
+            StressP=mateSystem.GetRank2MatePtr().at("stress");
+            if(HasStrain) StrainP=mateSystem.GetRank2MatePtr().at("strain");
+
+            _gpGradU[k](l)=GradUBase(l)-eps;
+            RunMate(mateSystem,t);
+            StressM=mateSystem.GetRank2MatePtr().at("stress");
+            if(HasStrain) StrainM=mateSystem.GetRank2MatePtr().at("strain");
+
+            _gpGradU[k](l)=GradUBase(l);
+
+            dStress=(StressP-StressM)/(2.0*eps);
+            if(HasStrain){
+                dStrain=(StrainP-StrainM)/(2.0*eps);
+            }
+            else{
+                // small strain without the reported strain, d(strain)/d(H_kl)=sym(e_k x e_l)
+                dStrain=0.0;
+                dStrain(k,l)+=0.5;dStrain(l,k)+=0.5;
+            }
+            for(int i=1;i<=3;i++){
+                for(int j=1;j<=3;j++){
+                    sum=0.0;
+                    for(int m=1;m<=3;m++){
+                        for(int n=1;n<=3;n++){
+                            sum+=Jac(i,j,m,n)*dStrain(m,n);
+                        }
+                    }
+                    if(abs(dStress(i,j)-sum)>MaxErr) MaxErr=abs(dStress(i,j)-sum);
+                    if(abs(dStress(i,j))>MaxVal) MaxVal=abs(dStress(i,j));
+                }
+            }
+        }
+    }
+    // recover the materials of the unperturbed state
+    RunMate(mateSystem,t);
+    if(MaxVal<1.0e-12) return MaxErr;
+    return MaxErr/MaxVal;
+}
+//*********************************************************
+void MatDriver::RunBenchmark(MateSystem &mateSystem,const MatDriverBlock &matDriverBlock,const double &t){
+    char buff[70];
+    chrono::high_resolution_clock::time_point TimerStart,TimerEnd;
+    double SingleTime,BatchTime;
+    const int nRepeats=matDriverBlock._nRepeats;
+    const int nBatch=matDriverBlock._BatchSize;
+
+    if(nRepeats<1) return;
+
+    // one qpoint per call, the same as the element loop without batching
+    TimerStart=chrono::high_resolution_clock::now();
+    for(int i=0;i<nRepeats;i++){
+        mateSystem.RunBulkMateLibs(_MateType,_MateIndex,_nDim,t,_dt,_gpCoord,
+                                   _gpU,_gpUOld,_gpUdot,_gpUdotOld,
+                                   _gpGradU,_gpGradUOld,_gpGradUdot,_gpGradUdotOld);
+    }
+    TimerEnd=chrono::high_resolution_clock::now();
+    SingleTime=Duration(TimerStart,TimerEnd);
+
+    // nBatch qpoints per call, every qpoint carries the same state
+    _Batch.Init(nBatch,_nMaxDofs);
+    for(int qp=0;qp<nBatch;qp++){
+        _Batch._gpCoord[qp]=_gpCoord;
+        _Batch._gpU[qp]=_gpU;_Batch._gpUOld[qp]=_gpUOld;
+        _Batch._gpUdot[qp]=_gpUdot;_Batch._gpUdotOld[qp]=_gpUdotOld;
+        _Batch._gpGradU[qp]=_gpGradU;_Batch._gpGradUOld[qp]=_gpGradUOld;
+        _Batch._gpGradUdot[qp]=_gpGradUdot;_Batch._gpGradUdotOld[qp]=_gpGradUdotOld;
+        _Batch._MatesOld[qp]=mateSystem.GetMaterialsOldPtr();
+    }
+    const int nCalls=(nRepeats+nBatch-1)/nBatch;
+    TimerStart=chrono::high_resolution_clock::now();
+    for(int i=0;i<nCalls;i++){
+        mateSystem.RunBulkMateLibsBatch(_MateType,_MateIndex,_nDim,t,_dt,_Batch);
+    }
+    TimerEnd=chrono::high_resolution_clock::now();
+    BatchTime=Duration(TimerStart,TimerEnd);
+
+    MessagePrinter::PrintNormalTxt("Material point driver throughput(at the peak load):");
+    snprintf(buff,70,"  single qpoint: %10d qpoints in %12.5e s",nRepeats,SingleTime);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    snprintf(buff,70,"  single qpoint: %14.6e qpoints/s",SingleTime>0.0?nRepeats/SingleTime:0.0);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    snprintf(buff,70,"  batch(%3d)   : %10d qpoints in %12.5e s",nBatch,nCalls*nBatch,BatchTime);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    snprintf(buff,70,"  batch(%3d)   : %14.6e qpoints/s",nBatch,BatchTime>0.0?nCalls*nBatch/BatchTime:0.0);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    MessagePrinter::PrintDashLine();
+}
+//*********************************************************
+void MatDriver::WriteHeader(ofstream &out,const Materials &mate)const{
+    const char comps[6][3]={"11","22","33","23","13","12"};
+    out<<"step,time,factor";
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++) out<<",gradu"<<i<<j;
+    }
+    if(mate.Rank2Materials.count("stress")){
+        for(int c=0;c<6;c++) out<<",stress"<<comps[c];
+    }
+    if(mate.Rank2Materials.count("strain")){
+        for(int c=0;c<6;c++) out<<",strain"<<comps[c];
+    }
+    for(const auto &it:mate.ScalarMaterials) out<<","<<it.first;
+    out<<"\n";
+}
+//*********************************************************
+void MatDriver::WriteStep(ofstream &out,const int &step,const double &t,const double &factor,const Materials &mate)const{
+    const int comps[6][2]={{1,1},{2,2},{3,3},{2,3},{1,3},{1,2}};
+    out<<step<<","<<t<<","<<factor;
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++) out<<","<<_gpGradU[i](j);
+    }
+    if(mate.Rank2Materials.count("stress")){
+        const RankTwoTensor &stress=mate.Rank2Materials.at("stress");
+        for(int c=0;c<6;c++) out<<","<<stress(comps[c][0],comps[c][1]);
+    }
+    if(mate.Rank2Materials.count("strain")){
+        const RankTwoTensor &strain=mate.Rank2Materials.at("strain");
+        for(int c=0;c<6;c++) out<<","<<strain(comps[c][0],comps[c][1]);
+    }
+    for(const auto &it:mate.ScalarMaterials) out<<","<<it.second;
+    out<<"\n";
+}
+//*********************************************************
+void MatDriver::Run(MateSystem &mateSystem,const MatDriverBlock &matDriverBlock){
+    char buff[70];
+    double t=0.0,factor,err,MaxErr=-1.0;
+    const int nSteps=matDriverBlock._nSteps;
+    const int nTotal=matDriverBlock._IsUnload?2*nSteps:nSteps;
+    ofstream out;
+
+    Init(mateSystem,matDriverBlock);
+
+    out.open(matDriverBlock._OutputFileName.c_str(),ios::out);
+    if(!out.is_open()){
+        MessagePrinter::PrintErrorTxt("can\'t create the output file("+matDriverBlock._OutputFileName+") of the material point driver");
+        MessagePrinter::AsFem_Exit();
+    }
+    out<<scientific<<setprecision(10);
+
+    MessagePrinter::PrintNormalTxt("Start the material point driver ...");
+    for(int step=1;step<=nTotal;step++){
+        t+=_dt;
+        factor=(step<=nSteps)?step/(1.0*nSteps):(2*nSteps-step)/(1.0*nSteps);
+        SetGradU(matDriverBlock,factor);
+        RunMate(mateSystem,t);
+
+        err=-1.0;
+        if(matDriverBlock._IsFDCheck){
+            err=CheckJacobian(mateSystem,t,matDriverBlock._FDEps);
+            if(err>MaxErr) MaxErr=err;
+        }
+        if(step==1) WriteHeader(out,mateSystem.GetMaterialsPtr());
+        WriteStep(out,step,t,factor,mateSystem.GetMaterialsPtr());
+
+        if(err>=0.0){
+            snprintf(buff,70,"  step=%6d, factor=%9.5f, fd error=%12.5e",step,factor,err);
+        }
+        else{
+            snprintf(buff,70,"  step=%6d, factor=%9.5f",step,factor);
+        }
+        MessagePrinter::PrintNormalTxt(string(buff));
+
+        if(step==nSteps) RunBenchmark(mateSystem,matDriverBlock,t);
+
+        // accept the current step as the history of the next one
+        mateSystem.GetMaterialsOldPtr()=mateSystem.GetMaterialsPtr();
+        _gpGradUOld=_gpGradU;
+        _gpGradUdotOld=_gpGradUdot;
+    }
+    out.close();
+
+    if(matDriverBlock._IsFDCheck){
+        if(MaxErr>=0.0){
+            snprintf(buff,70,"Max relative error of the jacobian=%12.5e",MaxErr);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
+        else{
+            MessagePrinter::PrintWarningTxt("no stress or jacobian is found in the material, the finite difference check is skipped");
+        }
+    }
+    MessagePrinter::PrintNormalTxt("The stress path is written to "+matDriverBlock._OutputFileName);
+    MessagePrinter::PrintDashLine();
+}
@@ -0,0 +1,52 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the main program of the material point driver
+//+++          (asfem-matdriver), usage: asfem-matdriver -i input.i
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <iostream>
+#include "petsc.h"
+
+#include "Welcome.h"
+
+#include "InputSystem/InputSystem.h"
+#include "MateSystem/MateSystem.h"
+#include "MatDriver/MatDriverBlock.h"
+#include "MatDriver/MatDriver.h"
+
+
+int main(int args,char *argv[]){
+    PetscErrorCode ierr;
+    ierr=PetscInitialize(&args,&argv,NULL,NULL);if (ierr) return ierr;
+
+    const PetscInt Year=2021;
+    const PetscInt Month=3;
+    const PetscInt Day=28;
+    const PetscReal Version=0.5;
+
+    Welcome(Year,Month,Day,Version);
+
+    InputSystem inputSystem(args,argv);
+    MateSystem mateSystem;
+    MatDriverBlock matDriverBlock;
+    MatDriver matDriver;
+
+    inputSystem.ReadMatDriverInputFile(mateSystem,matDriverBlock);
+    mateSystem.InitBulkMateSystem();
+    mateSystem.PrintMateSystemInfo();
+    matDriverBlock.PrintMatDriverInfo();
+
+    matDriver.Run(mateSystem,matDriverBlock);
+
+    ierr=PetscFinalize();CHKERRQ(ierr);
+    return ierr;
+}
@@ -70,6 +70,12 @@ void BulkMateSystem::InitBulkMateSystem(){
     _MaterialsOld.VectorMaterials.clear();
     _MaterialsOld.Rank2Materials.clear();
     _MaterialsOld.Rank4Materials.clear();
+
+    // setup the constants of each material block, only once
+    for(int i=1;i<=_nBulkMateBlocks;i++){
+        _BulkMateBlockList[i-1]._Constants.Init();
+        SetupBulkMateLibs(_BulkMateBlockList[i-1]._MateType,i);
+    }
 }
 //***********************************************************
 void BulkMateSystem::PrintBulkMateSystemInfo()const{
@@ -17,6 +17,14 @@
 
 #include "MateSystem/ConstDiffusionMaterial.h"
 
+void ConstDiffusionMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<1){
+        MessagePrinter::PrintErrorTxt("for constant diffusion material, one parameter, namely the diffusivity, is required");
+        MessagePrinter::AsFem_Exit();
+    }
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void ConstDiffusionMaterial::InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                                     const vector<double> &InputParams, const vector<double> &gpU,
                                                     const vector<double> &gpUdot, const vector<Vector3d> &gpGradU,
@@ -30,7 +38,7 @@ void ConstDiffusionMaterial::InitMaterialProperties(const int &nDim, const Vecto
 //****************************************************************************
 void ConstDiffusionMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                        const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                       const vector<double> &gpU, const vector<double> &gpUOld,
+                                                       const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                        const vector<double> &gpUdot, const vector<double> &gpUdotOld,
                                                        const vector<Vector3d> &gpGradU,
                                                        const vector<Vector3d> &gpGradUOld,
@@ -42,12 +50,8 @@ void ConstDiffusionMaterial::ComputeMaterialProperties(const double &t, const do
     //**************************************************************
     if(t||dt||nDim||gpCoord(1)||InputParams.size()||gpU[0]||gpUOld[0]||gpUdot[0]||gpUdotOld[0]||
        gpGradU[0](1)||gpGradUOld[0](1)||gpGradUdot[0](1)||gpGradUdotOld[0](1)||
-       MateOld.ScalarMaterials.size()||Mate.ScalarMaterials.size()){}
+       MateOld.ScalarMaterials.size()||Mate.ScalarMaterials.size()||Consts._IsSetup){}
 
-    if(InputParams.size()<1){
-        MessagePrinter::PrintErrorTxt("for constant diffusion material, one parameter, namely the diffusivity, is required");
-        MessagePrinter::AsFem_Exit();
-    }
 
     Mate.ScalarMaterials["D"]=InputParams[0];// D
     Mate.ScalarMaterials["dDdc"]=0.0;        // dD/dc
@@ -19,6 +19,14 @@
 
 #include "MateSystem/ConstPoissonMaterial.h"
 
+void ConstPoissonMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<2){
+        MessagePrinter::PrintErrorTxt("for const poisson material, two parameters are required. sigma*div(grad(phi))=F, so sigma and F are required");
+        MessagePrinter::AsFem_Exit();
+    }
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void ConstPoissonMaterial::InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                                   const vector<double> &InputParams, const vector<double> &gpU,
                                                   const vector<double> &gpUdot, const vector<Vector3d> &gpGradU,
@@ -32,7 +40,7 @@ void ConstPoissonMaterial::InitMaterialProperties(const int &nDim, const Vector3
 
 void ConstPoissonMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                      const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                     const vector<double> &gpU, const vector<double> &gpUOld,
+                                                     const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                      const vector<double> &gpUdot, const vector<double> &gpUdotOld,
                                                      const vector<Vector3d> &gpGradU,
                                                      const vector<Vector3d> &gpGradUOld,
@@ -44,12 +52,8 @@ void ConstPoissonMaterial::ComputeMaterialProperties(const double &t, const doub
     //**************************************************************
     if(t||dt||nDim||gpCoord(1)||InputParams.size()||gpU[0]||gpUOld[0]||gpUdot[0]||gpUdotOld[0]||
        gpGradU[0](1)||gpGradUOld[0](1)||gpGradUdot[0](1)||gpGradUdotOld[0](1)||
-       MateOld.ScalarMaterials.size()||Mate.ScalarMaterials.size()){}
+       MateOld.ScalarMaterials.size()||Mate.ScalarMaterials.size()||Consts._IsSetup){}
 
-    if(InputParams.size()<2){
-        MessagePrinter::PrintErrorTxt("for const poisson material, two parameters are required. sigma*div(grad(phi))=F, so sigma and F are required");
-        MessagePrinter::AsFem_Exit();
-    }
 
     //************************
     //*** here the poisson equation is:
@@ -21,6 +21,24 @@ DoubleWellFreeEnergyMaterial::DoubleWellFreeEnergyMaterial() {
     _d2Fdc2.resize(1,0.0);
 }
 
+void DoubleWellFreeEnergyMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<3){
+        MessagePrinter::PrintErrorTxt("for double well free energy material, three parameters are required, you need to give: D, Chi, and Kappa");
+        MessagePrinter::AsFem_Exit();
+    }
+    // optional: the number of table intervals(0 for the analytic form), cmin and cmax of the table
+    if(InputParams.size()>=4&&static_cast<int>(InputParams[3])>0){
+        const double cmin=(InputParams.size()>=5)?InputParams[4]:1.0e-2;
+        const double cmax=(InputParams.size()>=6)?InputParams[5]:1.0-1.0e-2;
+        if(cmin<=0.0||cmax>=1.0||cmax<=cmin){
+            MessagePrinter::PrintErrorTxt("for double well free energy material, the table range should be 0<cmin<cmax<1");
+            MessagePrinter::AsFem_Exit();
+        }
+        SetupFreeEnergyTable(InputParams,1,static_cast<int>(InputParams[3]),cmin,cmax,Consts);
+    }
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void DoubleWellFreeEnergyMaterial::InitMaterialProperties(const int &nDim,const Vector3d &gpCoord, const vector<double> &InputParams,
                                                           const vector<double> &gpU, const vector<double> &gpUdot,
                                                           const vector<Vector3d> &gpGradU,
@@ -53,7 +71,7 @@ void DoubleWellFreeEnergyMaterial::Computed2FdU2(const vector<double> &InputPara
 
 void DoubleWellFreeEnergyMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                              const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                             const vector<double> &gpU, const vector<double> &gpUOld,
+                                                             const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                              const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                                              const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                                              const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
@@ -62,15 +80,13 @@ void DoubleWellFreeEnergyMaterial::ComputeMaterialProperties(const double &t, co
        gpUdot[0]||gpUdotOld[0]||gpGradU[0](1)||gpGradUOld[0](1)||
        gpGradUdot[0](1)||gpGradUdotOld[0](1)||MateOld.ScalarMaterials.size()){}// get rid of unused warning
 
-    if(InputParams.size()<3){
-        MessagePrinter::PrintErrorTxt("for double well free energy material, three parameters are required, you need to give: D, Chi, and Kappa");
-        MessagePrinter::AsFem_Exit();
+    // the table is used if it is built and c is in its range
+    if(!ComputeFreeEnergyFromTable(Consts,gpU,_F,_dFdc,_d2Fdc2)){
+        ComputeF(InputParams,gpU,gpUdot,_F);
+        ComputedFdU(InputParams,gpU,gpUdot,_dFdc);
+        Computed2FdU2(InputParams,gpU,gpUdot,_d2Fdc2);
     }
 
-    ComputeF(InputParams,gpU,gpUdot,_F);
-    ComputedFdU(InputParams,gpU,gpUdot,_dFdc);
-    Computed2FdU2(InputParams,gpU,gpUdot,_d2Fdc2);
-
     c=gpU[1];
     Mate.ScalarMaterials["M"]=InputParams[0]*c*(1-c);   // M
     Mate.ScalarMaterials["dMdc"]=InputParams[0]*(1-2*c);// dM/dc
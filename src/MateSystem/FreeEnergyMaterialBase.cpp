@@ -0,0 +1,137 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Build and evaluate the tabulated free energy for
+//+++          the free energy materials
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "MateSystem/FreeEnergyMaterialBase.h"
+
+void FreeEnergyMaterialBase::SetupFreeEnergyTable(const vector<double> &InputParams,const int &nVars,const int &n,
+                                                  const double &umin,const double &umax,MateConstants &Consts){
+    if(nVars<1||nVars>2){
+        MessagePrinter::PrintErrorTxt("only the free energy of one or two variables can be tabulated, please check your code");
+        MessagePrinter::AsFem_Exit();
+    }
+    if(n<2||umax<=umin){
+        MessagePrinter::PrintErrorTxt("invalid free energy table, at least 2 intervals and umax>umin are required");
+        MessagePrinter::AsFem_Exit();
+    }
+    vector<double> U(nVars+1,0.0),dUdt(nVars+1,0.0);
+    vector<double> F(1,0.0),dF(nVars,0.0),d2F(nVars*nVars,0.0);
+    const double h=(umax-umin)/n;
+
+    Consts._Tables1D.clear();
+    Consts._Tables2D.clear();
+    if(nVars==1){
+        // tables: F, dF/du, the end slopes are given by the analytic derivatives
+        vector<double> FVals(n+1,0.0),dFVals(n+1,0.0);
+        double dFLeft=0.0,dFRight=0.0,d2FLeft=0.0,d2FRight=0.0;
+        for(int i=0;i<=n;i++){
+            U[1]=umin+i*h;
+            ComputeF(InputParams,U,dUdt,F);
+            ComputedFdU(InputParams,U,dUdt,dF);
+            FVals[i]=F[0];dFVals[i]=dF[0];
+            if(i==0||i==n){
+                Computed2FdU2(InputParams,U,dUdt,d2F);
+                if(i==0){dFLeft=dF[0];d2FLeft=d2F[0];}
+                else{dFRight=dF[0];d2FRight=d2F[0];}
+            }
+        }
+        Consts._Tables1D.resize(2);
+        Consts._Tables1D[0].Build(n,umin,umax,FVals,true,dFLeft,dFRight);
+        Consts._Tables1D[1].Build(n,umin,umax,dFVals,true,d2FLeft,d2FRight);
+    }
+    else{
+        // tables: F, dF/du1, dF/du2, the node derivatives are given by the analytic form
+        // except the mixed one of the dF tables
+        const int nn=(n+1)*(n+1);
+        vector<double> FVals(nn,0.0),dF1Vals(nn,0.0),dF2Vals(nn,0.0);
+        vector<double> d2F11Vals(nn,0.0),d2F12Vals(nn,0.0),d2F22Vals(nn,0.0);
+        int k;
+        for(int j=0;j<=n;j++){
+            U[2]=umin+j*h;
+            for(int i=0;i<=n;i++){
+                U[1]=umin+i*h;
+                ComputeF(InputParams,U,dUdt,F);
+                ComputedFdU(InputParams,U,dUdt,dF);
+                Computed2FdU2(InputParams,U,dUdt,d2F);
+                k=i+j*(n+1);
+                FVals[k]=F[0];
+                dF1Vals[k]=dF[0];dF2Vals[k]=dF[1];
+                d2F11Vals[k]=d2F[0];d2F12Vals[k]=0.5*(d2F[1]+d2F[2]);d2F22Vals[k]=d2F[3];
+            }
+        }
+        Consts._Tables2D.resize(3);
+        Consts._Tables2D[0].Build(n,n,umin,umax,umin,umax,FVals,dF1Vals,dF2Vals,d2F12Vals);
+        Consts._Tables2D[1].Build(n,n,umin,umax,umin,umax,dF1Vals,d2F11Vals,d2F12Vals);
+        Consts._Tables2D[2].Build(n,n,umin,umax,umin,umax,dF2Vals,d2F12Vals,d2F22Vals);
+    }
+
+    //*******************************************************
+    //*** check the table against the analytic form at the
+    //*** center of each interval(cell), where the error is
+    //*** the largest
+    //*******************************************************
+    vector<double> FT(1,0.0),dFT(nVars,0.0),d2FT(nVars*nVars,0.0);
+    double ErrF=0.0,ErrdF=0.0,Errd2F=0.0;
+    const int nj=(nVars==1)?1:n;
+    for(int j=0;j<nj;j++){
+        if(nVars==2) U[2]=umin+(j+0.5)*h;
+        for(int i=0;i<n;i++){
+            U[1]=umin+(i+0.5)*h;
+            ComputeF(InputParams,U,dUdt,F);
+            ComputedFdU(InputParams,U,dUdt,dF);
+            Computed2FdU2(InputParams,U,dUdt,d2F);
+            ComputeFreeEnergyFromTable(Consts,U,FT,dFT,d2FT);
+            ErrF=max(ErrF,abs(FT[0]-F[0])/max(abs(F[0]),1.0));
+            for(int k=0;k<nVars;k++){
+                ErrdF=max(ErrdF,abs(dFT[k]-dF[k])/max(abs(dF[k]),1.0));
+            }
+            for(int k=0;k<nVars*nVars;k++){
+                Errd2F=max(Errd2F,abs(d2FT[k]-d2F[k])/max(abs(d2F[k]),1.0));
+            }
+        }
+    }
+    char buff[70];
+    snprintf(buff,70,"free energy table: %d variable(s), %d intervals",nVars,n);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    snprintf(buff,70,"  range=[%12.5e,%12.5e]",umin,umax);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    snprintf(buff,70,"  max error: F=%9.2e, dF=%9.2e, d2F=%9.2e",ErrF,ErrdF,Errd2F);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    if(max(ErrF,max(ErrdF,Errd2F))>1.0e-3){
+        MessagePrinter::PrintWarningTxt("the free energy table is not accurate enough, please use more intervals");
+    }
+}
+//***********************************************************************
+bool FreeEnergyMaterialBase::ComputeFreeEnergyFromTable(const MateConstants &Consts,const vector<double> &U,
+                                                        vector<double> &F,vector<double> &dF,vector<double> &d2F)const{
+    if(Consts._Tables1D.size()==2){
+        if(!Consts._Tables1D[0].IsInRange(U[1])) return false;
+        double dummy;
+        Consts._Tables1D[0].Eval(U[1],F[0],dummy);
+        // d2F comes from the same spline as dF, so the jacobian is consistent with the residual
+        Consts._Tables1D[1].Eval(U[1],dF[0],d2F[0]);
+        return true;
+    }
+    else if(Consts._Tables2D.size()==3){
+        if(!Consts._Tables2D[0].IsInRange(U[1],U[2])) return false;
+        double dummy1,dummy2,d2F12,d2F21;
+        Consts._Tables2D[0].Eval(U[1],U[2],F[0],dummy1,dummy2);
+        Consts._Tables2D[1].Eval(U[1],U[2],dF[0],d2F[0],d2F12);
+        Consts._Tables2D[2].Eval(U[1],U[2],dF[1],d2F21,d2F[3]);
+        d2F[1]=0.5*(d2F12+d2F21);
+        d2F[2]=d2F[1];
+        return true;
+    }
+    return false;
+}
@@ -15,6 +15,16 @@
 
 #include "MateSystem/IncrementSmallStrainMaterial.h"
 
+void IncrementSmallStrainMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<2){
+        MessagePrinter::PrintErrorTxt("for increment small strain material, two parameters are required, you need to give: E and nu");
+        MessagePrinter::AsFem_Exit();
+    }
+    // E and nu --> the constant elastic tensor
+    Consts._ElasticC.SetFromEandNu(InputParams[0],InputParams[1]);
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void IncrementSmallStrainMaterial::InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                                           const vector<double> &InputParams, const vector<double> &gpU,
                                                           const vector<double> &gpUdot, const vector<Vector3d> &gpGradU,
@@ -44,19 +54,16 @@ void IncrementSmallStrainMaterial::ComputeStrain(const int &nDim, const vector<V
 }
 //***********************************************************************************
 void IncrementSmallStrainMaterial::ComputeStressAndJacobian(const vector<double> &InputParams,
-                                                            const RankTwoTensor &Strain, RankTwoTensor &Stress,
+                                                            const MateConstants &Consts,const RankTwoTensor &Strain, RankTwoTensor &Stress,
                                                             RankFourTensor &Jacobian) {
-    const double E=InputParams[0];
-    const double nu=InputParams[1];
-
-    Jacobian.SetToZeros();
-    Jacobian.SetFromEandNu(E,nu);
+    if(InputParams.size()){}
+    Jacobian=Consts._ElasticC;
     Stress=Jacobian.DoubleDot(Strain);
 }
 //*********************************************************************
 void IncrementSmallStrainMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                              const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                             const vector<double> &gpU, const vector<double> &gpUOld,
+                                                             const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                              const vector<double> &gpUdot,
                                                              const vector<double> &gpUdotOld,
                                                              const vector<Vector3d> &gpGradU,
@@ -75,12 +82,11 @@ void IncrementSmallStrainMaterial::ComputeMaterialProperties(const double &t, co
     _StressOld=MateOld.Rank2Materials.at("stress");
     ComputeStrain(nDim,gpGradU,_Strain);
     _DeltaStrain=_Strain-_StrainOld;
-    ComputeStressAndJacobian(InputParams,_DeltaStrain,_DeltaStress,_Jac);
+    ComputeStressAndJacobian(InputParams,Consts,_DeltaStrain,_DeltaStress,_Jac);
 
     _Stress=_StressOld+_DeltaStress;
 
-    _I.SetToZeros();
-    _devStress=_Stress-_I*(_Stress.Trace()/3.0);
+    _devStress=_Stress-Consts._I*(_Stress.Trace()/3.0);
 
     Mate.ScalarMaterials["vonMises"]=sqrt(1.5*_devStress.DoubleDot(_devStress));
     Mate.Rank2Materials["stress"]=_Stress;
@@ -57,9 +57,54 @@ void BulkMateSystem::InitBulkMateLibs(const MateType &imate,const int &mateindex
             MieheFractureMaterial::InitMaterialProperties(nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
                                                           gpU,gpUdot,gpGradU,gpGradUdot,_Materials);
             break;
+        case MateType::USER1MATE:
+            User1Material::InitMaterialProperties(nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+                                                  gpU,gpUdot,gpGradU,gpGradUdot,_Materials);
+            break;
         default:
             MessagePrinter::PrintErrorTxt("unsupported material type in RunBulkMateLibs of MateSystem, please check either your code or your input file");
             MessagePrinter::AsFem_Exit();
             break;
     }
-}
\ No newline at end of file
+}
+//****************************************************************
+void BulkMateSystem::InitBulkMateLibsBatch(const MateType &imate,const int &mateindex,const int &nDim,BulkMateBatch &Batch){
+    switch (imate){
+        case MateType::NULLMATE:
+            break;
+        case MateType::CONSTPOISSONMATE:
+            ConstPoissonMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::CONSTDIFFUSIONMATE:
+            ConstDiffusionMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::DOUBLEWELLFREENERGYMATE:
+            DoubleWellFreeEnergyMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::LINEARELASTICMATE:
+            LinearElasticMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::INCREMENTSMALLSTRAINMATE:
+            IncrementSmallStrainMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::NEOHOOKEANMATE:
+            NeoHookeanMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::PLASTIC1DMATE:
+            Plastic1DMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::J2PLASTICITYMATE:
+            J2PlasticityMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::MIEHEFRACTUREMATE:
+            MieheFractureMaterial::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        case MateType::USER1MATE:
+            User1Material::InitMaterialPropertiesBatch(nDim,_BulkMateBlockList[mateindex-1]._Parameters,Batch);
+            break;
+        default:
+            MessagePrinter::PrintErrorTxt("unsupported material type in InitBulkMateLibsBatch of MateSystem, please check either your code or your input file");
+            MessagePrinter::AsFem_Exit();
+            break;
+    }
+}
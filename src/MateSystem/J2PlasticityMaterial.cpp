@@ -14,6 +14,23 @@
 
 #include "MateSystem/J2PlasticityMaterial.h"
 
+void J2PlasticityMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<4){
+        MessagePrinter::PrintErrorTxt("for J2-Plasticity material, four parameters are required, you need to give: E, nu, yield stress, and hardening modulus");
+        MessagePrinter::AsFem_Exit();
+    }
+    const double E=InputParams[1-1];
+    const double nu=InputParams[2-1];
+    Consts._Scalars.resize(3);
+    Consts._Scalars[0]=E/(3*(1-2*nu)); // bulk modulus, not the first lame constant!!!
+    Consts._Scalars[1]=E/(2*(1+nu));   // shear modulus
+    Consts._Scalars[2]=InputParams[4-1];// hardening modulus
+    Consts._ElasticC.SetFromEandNu(E,nu);
+    Consts._ElasticSymC.SetFromEandNu(E,nu);
+    Consts._IsElasticTangentConst=true;
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void J2PlasticityMaterial::InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                                   const vector<double> &InputParams, const vector<double> &gpU,
                                                   const vector<double> &gpUdot, const vector<Vector3d> &gpGradU,
@@ -51,7 +68,7 @@ double J2PlasticityMaterial::ComputeYieldFunction(const vector<double> &InputPar
 //****************************************************************
 void J2PlasticityMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                      const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                     const vector<double> &gpU, const vector<double> &gpUOld,
+                                                     const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                      const vector<double> &gpUdot, const vector<double> &gpUdotOld,
                                                      const vector<Vector3d> &gpGradU,
                                                      const vector<Vector3d> &gpGradUOld,
@@ -65,59 +82,141 @@ void J2PlasticityMaterial::ComputeMaterialProperties(const double &t, const doub
        gpUdot[0]||gpUdotOld[0]||gpGradU[0](1)||gpGradUOld[0](1)||
        gpGradUdot[0](1)||gpGradUdotOld[0](1)||MateOld.ScalarMaterials.size()){}
 
-    if(InputParams.size()<4){
-        MessagePrinter::PrintErrorTxt("for J2-Plasticity material, four parameters are required, you need to give: E, nu, yield stress, and hardening modulus");
-        MessagePrinter::AsFem_Exit();
-    }
-
-    _E=InputParams[1-1];
-    _nu=InputParams[2-1];
-    _hardening_modulus=InputParams[4-1];
-
-    // for bulk modulus and shear modulus
-    _Lambda=_E/(3*(1-2*_nu)); // bulk modulus, not the first lame constant!!!
-    _Mu=_E/(2*(1+_nu));       // shear modulus
-
     // for the variables in previous step
     _plastic_strain_old=MateOld.Rank2Materials.at("plastic_strain");
     _Effect_Plastic_Strain_Old=MateOld.ScalarMaterials.at("effective_plastic_strain");
 
-    _I.SetToIdentity();
-    _I4Sym.SetToIdentitySymmetric4();
-
     ComputeStrain(nDim,gpGradU,_Strain);
 
-    _devStrain=_Strain-_I*(_Strain.Trace()/3.0);
-    _STrial=(_devStrain-_plastic_strain_old)*2.0*_Mu;
+    _devStrain=_Strain-Consts._I*(_Strain.Trace()/3.0);
+    _STrial=(_devStrain-_plastic_strain_old)*2.0*Consts._Scalars[1];
 
     _F= ComputeYieldFunction(InputParams,_STrial.Norm(),_Effect_Plastic_Strain_Old);
 
+    ComputeReturnMapping(Consts,Mate);
+}
+//****************************************************************
+void J2PlasticityMaterial::ComputeReturnMapping(const MateConstants &Consts,Materials &Mate){
+    // _Strain, _STrial, _F and the old plastic variables must be ready here
+    // bulk modulus, shear modulus and hardening modulus from the setup stage
+    const double K=Consts._Scalars[0];
+    const double Mu=Consts._Scalars[1];
+    const double H=Consts._Scalars[2];
     if(_F<=0.0){
         // for elastic case
         _N.SetToZeros();
         _DeltaGamma=0.0;
-        _Jac.SetFromEandNu(_E,_nu);
+        _Jac=Consts._ElasticC;
+        _SymJac=Consts._ElasticSymC;
     }
     else{
         // for plastic case
-        _DeltaGamma=_F/(2*_Mu+2*_hardening_modulus/3.0);
+        _DeltaGamma=_F/(2*Mu+2*H/3.0);
         _N=_STrial/_STrial.Norm();
-        _theta=1.0-2.0*_Mu*_DeltaGamma/_STrial.Norm();
-        _thetabar=1.0/(1.0+_hardening_modulus/(3*_Mu))-(1-_theta);
-        _Jac=_I.CrossDot(_I)*_Lambda
-                +(_I4Sym-_I.CrossDot(_I)*(1.0/3.0))*2*_Mu*_theta
-                -_N.CrossDot(_N)*2*_Mu*_thetabar;
+        _theta=1.0-2.0*Mu*_DeltaGamma/_STrial.Norm();
+        _thetabar=1.0/(1.0+H/(3*Mu))-(1-_theta);
+        // Jac=K*IxI+2*Mu*theta*(I4Sym-IxI/3)-2*Mu*thetabar*NxN, built in place
+        _Jac.SetToZeros();
+        _Jac.AddScaledIdentitySymmetric4(2*Mu*_theta);
+        _Jac.AddScaledCrossDot(K-2*Mu*_theta/3.0,Consts._I,Consts._I);
+        _Jac.AddScaledCrossDot(-2*Mu*_thetabar,_N,_N);
+        // the same one in the Mandel storage
+        _SymJac.SetToZeros();
+        _SymJac.AddScaledIdentitySymmetric4(2*Mu*_theta);
+        _SymJac.AddScaledCrossDot(K-2*Mu*_theta/3.0,Consts._I,Consts._I);
+        _SymJac.AddScaledCrossDot(-2*Mu*_thetabar,_N,_N);
     }
     // update all the variables
     Mate.ScalarMaterials["effective_plastic_strain"]=_Effect_Plastic_Strain_Old+sqrt(2.0/3.0)*_DeltaGamma;
-    Mate.Rank2Materials["plastic_strain"]=_plastic_strain_old+_N*_DeltaGamma;
-    Mate.Rank2Materials["stress"]=_I*_Lambda*_Strain.Trace()
-            +_STrial-_N*2*_Mu*_DeltaGamma;
-    _Stress=_I*_Lambda*_Strain.Trace()+_STrial-_N*2*_Mu*_DeltaGamma;
+    Mate.Rank2Materials["plastic_strain"]=_plastic_strain_old;
+    Mate.Rank2Materials["plastic_strain"].AddScaled(_DeltaGamma,_N);
+    _Stress=_STrial;
+    _Stress.AddScaled(-2*Mu*_DeltaGamma,_N);
+    _Stress.AddScaledIdentity(K*_Strain.Trace());
+    Mate.Rank2Materials["stress"]=_Stress;
     Mate.Rank2Materials["strain"]=_Strain;
     Mate.Rank4Materials["jacobian"]=_Jac;
+    Mate.SymTangent=_SymJac;
+    Mate.HasSymTangent=true;
 
-    _devStress=_Stress-_I*(_Stress.Trace()/3.0);
+    _devStress=_Stress;
+    _devStress.AddScaledIdentity(-_Stress.Trace()/3.0);
     Mate.ScalarMaterials["vonMises"]=sqrt(1.5*_devStress.DoubleDot(_devStress));
+}
+//****************************************************************
+void J2PlasticityMaterial::ComputeMaterialPropertiesBatch(const double &/*t*/,const double &/*dt*/,const int &nDim,
+                                                          const vector<double> &InputParams,const MateConstants &Consts,
+                                                          BulkMateBatch &Batch){
+    const int nqp=Batch._nQp;
+    const double K=Consts._Scalars[0];
+    const double H=Consts._Scalars[2];
+    const double YieldStress=InputParams[3-1];
+
+    Batch.ComputeSmallStrainSoA(nDim);
+    // the variables in previous step, in the same SoA layout as the strain
+    if(static_cast<int>(_BatchEffectPlasticStrainOld.size())<nqp){
+        _BatchPlasticStrainOld.resize(6*nqp,0.0);
+        _BatchEffectPlasticStrainOld.resize(nqp,0.0);
+    }
+    double *ep=_BatchPlasticStrainOld.data();
+    double *epeff=_BatchEffectPlasticStrainOld.data();
+    for(int qp=0;qp<nqp;qp++){
+        const RankTwoTensor &a=Batch._MatesOld[qp].Rank2Materials.at("plastic_strain");
+        ep[      qp]=a(1,1);ep[  nqp+qp]=a(2,2);ep[2*nqp+qp]=a(3,3);
+        ep[3*nqp+qp]=a(2,3);ep[4*nqp+qp]=a(1,3);ep[5*nqp+qp]=a(1,2);
+        epeff[qp]=Batch._MatesOld[qp].ScalarMaterials.at("effective_plastic_strain");
+    }
+
+    // elastic predictor for all the qpoints: trial deviatoric stress, yield function,
+    // and the vonMises stress of the elastic state
+    const double *e=Batch._Strain.data();
+    double *st=Batch._Stress.data();
+    double *f=Batch._Scalar.data();
+    if(static_cast<int>(_BatchVonMises.size())<nqp) _BatchVonMises.resize(nqp,0.0);
+    double *vm=_BatchVonMises.data();
+    const double c=sqrt(2.0/3.0);
+    const double mu2=2.0*Consts._Scalars[1];
+    #pragma omp simd
+    for(int qp=0;qp<nqp;qp++){
+        const double tr3=(e[qp]+e[nqp+qp]+e[2*nqp+qp])/3.0;
+        st[      qp]=mu2*(e[      qp]-tr3-ep[      qp]);
+        st[  nqp+qp]=mu2*(e[  nqp+qp]-tr3-ep[  nqp+qp]);
+        st[2*nqp+qp]=mu2*(e[2*nqp+qp]-tr3-ep[2*nqp+qp]);
+        st[3*nqp+qp]=mu2*(e[3*nqp+qp]-ep[3*nqp+qp]);
+        st[4*nqp+qp]=mu2*(e[4*nqp+qp]-ep[4*nqp+qp]);
+        st[5*nqp+qp]=mu2*(e[5*nqp+qp]-ep[5*nqp+qp]);
+        const double norm=sqrt(st[qp]*st[qp]+st[nqp+qp]*st[nqp+qp]+st[2*nqp+qp]*st[2*nqp+qp]
+                               +2.0*(st[3*nqp+qp]*st[3*nqp+qp]+st[4*nqp+qp]*st[4*nqp+qp]+st[5*nqp+qp]*st[5*nqp+qp]));
+        f[qp]=norm-c*(YieldStress+epeff[qp]*H);
+        vm[qp]=sqrt(1.5)*norm;// the trial stress is deviatoric
+    }
 
-}
\ No newline at end of file
+    for(int qp=0;qp<nqp;qp++){
+        Materials &Mate=Batch._Mates[qp];
+        Batch.GetIthSoATensor(Batch._Strain,qp,_Strain);
+        if(f[qp]<=0.0){
+            // elastic short-circuit: the plastic variables are unchanged and the tangent is the
+            // constant elastic one, so the return mapping is skipped
+            Mate.ScalarMaterials["effective_plastic_strain"]=epeff[qp];
+            Mate.Rank2Materials["plastic_strain"]=Batch._MatesOld[qp].Rank2Materials.at("plastic_strain");
+            Batch.GetIthSoATensor(Batch._Stress,qp,_Stress);
+            _Stress.AddScaledIdentity(K*_Strain.Trace());
+            Mate.Rank2Materials["stress"]=_Stress;
+            Mate.Rank2Materials["strain"]=_Strain;
+            Mate.Rank4Materials["jacobian"]=Consts._ElasticC;
+            Mate.SymTangent=Consts._ElasticSymC;
+            Mate.HasSymTangent=true;
+            Mate.ScalarMaterials["vonMises"]=vm[qp];
+            Batch.SetIthQpState(qp,MateQpState::ELASTIC);
+        }
+        else{
+            // the return mapping is done qpoint by qpoint
+            Batch.GetIthSoATensor(Batch._Stress,qp,_STrial);
+            Batch.GetIthSoATensor(_BatchPlasticStrainOld,qp,_plastic_strain_old);
+            _Effect_Plastic_Strain_Old=epeff[qp];
+            _F=f[qp];
+            ComputeReturnMapping(Consts,Mate);
+            Batch.SetIthQpState(qp,MateQpState::INELASTIC);
+        }
+    }
+}
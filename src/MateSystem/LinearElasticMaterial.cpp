@@ -14,6 +14,23 @@
 
 #include "MateSystem/LinearElasticMaterial.h"
 
+void LinearElasticMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<2){
+        MessagePrinter::PrintErrorTxt("for linear elastic material, two parameters are required, you need to give: E and nu");
+        MessagePrinter::AsFem_Exit();
+    }
+    // E and nu --> lame constants and the constant elastic tensor
+    const double E=InputParams[0];
+    const double nu=InputParams[1];
+    Consts._Scalars.resize(2);
+    Consts._Scalars[0]=E*nu/((1.0+nu)*(1.0-2.0*nu));// first lame constant
+    Consts._Scalars[1]=E/(2.0*(1.0+nu));           // shear modulus
+    Consts._ElasticC.SetFromEandNu(E,nu);
+    Consts._ElasticSymC.SetFromEandNu(E,nu);
+    Consts._IsElasticTangentConst=true;
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void LinearElasticMaterial::InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
                                                    const vector<double> &gpU,const vector<double> &gpUdot,
                                                    const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
@@ -39,20 +56,17 @@ void LinearElasticMaterial::ComputeStrain(const int &nDim,const vector<Vector3d>
     Strain=(_GradU+_GradU.Transpose())*0.5;
 }
 
-void LinearElasticMaterial::ComputeStressAndJacobian(const vector<double> &InputParams,const RankTwoTensor &Strain,
+void LinearElasticMaterial::ComputeStressAndJacobian(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &Strain,
                                                      RankTwoTensor &Stress,RankFourTensor &Jacobian) {
 
-    const double E=InputParams[0];
-    const double nu=InputParams[1];
-
-    Jacobian.SetToZeros();
-    Jacobian.SetFromEandNu(E,nu);
+    if(InputParams.size()){}
+    Jacobian=Consts._ElasticC;
     Stress=Jacobian.DoubleDot(Strain);
 }
 
 void LinearElasticMaterial::ComputeMaterialProperties(const double &t, const double &dt,const int &nDim,
                                                       const Vector3d &gpCoord,const vector<double> &InputParams,
-                                                      const vector<double> &gpU,const vector<double> &gpUOld,
+                                                      const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
                                                       const vector<double> &gpUdot,const vector<double> &gpUdotOld,
                                                       const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
                                                       const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
@@ -62,19 +76,56 @@ void LinearElasticMaterial::ComputeMaterialProperties(const double &t, const dou
     gpUdot[0]||gpUdotOld[0]||gpGradU[0](1)||gpGradUOld[0](1)||
     gpGradUdot[0](1)||gpGradUdotOld[0](1)||MateOld.ScalarMaterials.size()){}// get rid of unused warning
 
-    if(InputParams.size()<2){
-        MessagePrinter::PrintErrorTxt("for linear elastic material, two parameters are required, you need to give: E and nu");
-        MessagePrinter::AsFem_Exit();
-    }
-
     ComputeStrain(nDim,gpGradU,_Strain);
-    ComputeStressAndJacobian(InputParams,_Strain,_Stress,_Jac);
+    ComputeStressAndJacobian(InputParams,Consts,_Strain,_Stress,_Jac);
 
-    _I.SetToIdentity();
-    _devStress=_Stress-_I*(_Stress.Trace()/3.0);
+    _devStress=_Stress-Consts._I*(_Stress.Trace()/3.0);
     Mate.ScalarMaterials["vonMises"]=sqrt(1.5*_devStress.DoubleDot(_devStress));
     Mate.Rank2Materials["strain"]=_Strain;
     Mate.Rank2Materials["stress"]=_Stress;
     Mate.Rank4Materials["jacobian"]=_Jac;
+    Mate.SymTangent=Consts._ElasticSymC;
+    Mate.HasSymTangent=true;
 
 }
+//****************************************************************************
+void LinearElasticMaterial::ComputeMaterialPropertiesBatch(const double &t,const double &dt,const int &nDim,
+                                                           const vector<double> &InputParams,const MateConstants &Consts,
+                                                           BulkMateBatch &Batch){
+    if(t||dt||InputParams.size()){}// get rid of unused warning
+
+    const int nqp=Batch._nQp;
+    const double lambda=Consts._Scalars[0];
+    const double mu=Consts._Scalars[1];
+
+    Batch.ComputeSmallStrainSoA(nDim);
+    const double *e=Batch._Strain.data();
+    double *s=Batch._Stress.data();
+    double *vm=Batch._Scalar.data();
+    // stress=lambda*tr(strain)*I+2*mu*strain, for all the qpoints at once
+    #pragma omp simd
+    for(int qp=0;qp<nqp;qp++){
+        const double tr=e[qp]+e[nqp+qp]+e[2*nqp+qp];
+        s[      qp]=lambda*tr+2.0*mu*e[      qp];
+        s[  nqp+qp]=lambda*tr+2.0*mu*e[  nqp+qp];
+        s[2*nqp+qp]=lambda*tr+2.0*mu*e[2*nqp+qp];
+        s[3*nqp+qp]=2.0*mu*e[3*nqp+qp];
+        s[4*nqp+qp]=2.0*mu*e[4*nqp+qp];
+        s[5*nqp+qp]=2.0*mu*e[5*nqp+qp];
+        const double p=(s[qp]+s[nqp+qp]+s[2*nqp+qp])/3.0;
+        const double d1=s[qp]-p,d2=s[nqp+qp]-p,d3=s[2*nqp+qp]-p;
+        vm[qp]=sqrt(1.5*(d1*d1+d2*d2+d3*d3
+                         +2.0*(s[3*nqp+qp]*s[3*nqp+qp]+s[4*nqp+qp]*s[4*nqp+qp]+s[5*nqp+qp]*s[5*nqp+qp])));
+    }
+    for(int qp=0;qp<nqp;qp++){
+        Batch.GetIthSoATensor(Batch._Strain,qp,_Strain);
+        Batch.GetIthSoATensor(Batch._Stress,qp,_Stress);
+        Batch._Mates[qp].ScalarMaterials["vonMises"]=vm[qp];
+        Batch._Mates[qp].Rank2Materials["strain"]=_Strain;
+        Batch._Mates[qp].Rank2Materials["stress"]=_Stress;
+        Batch._Mates[qp].Rank4Materials["jacobian"]=Consts._ElasticC;
+        Batch._Mates[qp].SymTangent=Consts._ElasticSymC;
+        Batch._Mates[qp].HasSymTangent=true;
+        Batch.SetIthQpState(qp,MateQpState::ELASTIC);
+    }
+}
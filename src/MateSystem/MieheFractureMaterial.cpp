@@ -21,6 +21,23 @@
 #include "MateSystem/MieheFractureMaterial.h"
 
 
+void MieheFractureMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<5){
+        MessagePrinter::PrintErrorTxt("for Miehe's phase field fracture materials, at least 5 parameters are required, you need to give: lambda, mu, Gc, L, viscosity");
+        MessagePrinter::AsFem_Exit();
+    }
+    // lambda, mu, Gc, L, viscosity, UseHist(optional)
+    int UseHist=0;
+    if(InputParams.size()>=6){
+        UseHist=static_cast<int>(InputParams[6-1]);
+        if(UseHist<0) UseHist=0;
+    }
+    Consts._Scalars.resize(6);
+    for(int i=0;i<5;i++) Consts._Scalars[i]=InputParams[i];
+    Consts._Scalars[5]=1.0*UseHist;
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void MieheFractureMaterial::InitMaterialProperties(const int &nDim,const Vector3d &gpCoord, const vector<double> &InputParams,
                                                    const vector<double> &gpU, const vector<double> &gpUdot,
                                                    const vector<Vector3d> &gpGradU, const vector<Vector3d> &gpGradUdot,
@@ -57,42 +74,40 @@ void MieheFractureMaterial::ComputeStrain(const int &nDim, const vector<Vector3d
     strain=(GradU+GradU.Transpose())*0.5;
 }
 //************************************************************
-void MieheFractureMaterial::ComputeConstitutiveLaws(const vector<double> &InputParams,const RankTwoTensor &strain,const double &damage,
+void MieheFractureMaterial::ComputeConstitutiveLaws(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &strain,const double &damage,
                                                     const Materials &MateOld, Materials &Mate) {
     double d;
     double g,dg;// for the degradation function
     const double k=1.0e-5; // for stabilizer
 
-    const double lambda=InputParams[0];
-    const double mu=InputParams[1];
-    const double Gc=InputParams[2];
-    const double L=InputParams[3];
-    const double viscosity=InputParams[4];
+    if(InputParams.size()){}
+    const double lambda=Consts._Scalars[0];
+    const double mu=Consts._Scalars[1];
+    const double Gc=Consts._Scalars[2];
+    const double L=Consts._Scalars[3];
+    const double viscosity=Consts._Scalars[4];
+    const int UseHist=static_cast<int>(Consts._Scalars[5]);
 
     Mate.ScalarMaterials["viscosity"]=viscosity;
     Mate.ScalarMaterials["Gc"]=Gc;
     Mate.ScalarMaterials["L"]=L;
 
-    int UseHist=0;
-    if(InputParams.size()>=6){
-        UseHist=static_cast<int>(InputParams[6-1]);
-        if(UseHist<0) UseHist=0;
-    }
-
     d=damage;
     g= DegradationFun(d);
     dg= DegradationFunDeriv(d);   // derivative of g
 
-    I4Sym.SetToIdentitySymmetric4();
-
     Mate.Rank2Materials["strain"]=strain;
 
-    ProjPos=strain.GetPostiveProjTensor();
-    I4Sym.SetToIdentitySymmetric4();
-    ProjNeg=I4Sym-ProjPos;
+    strain.CalcPosAndNegProjTensor(EigVal,EigVec,ProjPos,ProjNeg);
 
-    // for the positive and negative strain
-    EpsPos=ProjPos.DoubleDot(strain);
+    // for the positive and negative strain, EpsPos=ProjPos:strain=sum(<e_a>_{+}*n_a x n_a)
+    EpsPos.SetToZeros();
+    for(int a=1;a<=3;++a){
+        if(EigVal[a-1]>0.0){
+            Ma.VectorCrossDot(EigVec.IthCol(a),EigVec.IthCol(a));
+            EpsPos+=Ma*EigVal[a-1];
+        }
+    }
     EpsNeg=strain-EpsPos;
 
     double trEps,signpos,signneg;
@@ -108,18 +123,16 @@ void MieheFractureMaterial::ComputeConstitutiveLaws(const vector<double> &InputP
     Mate.ScalarMaterials["PsiNeg"]=psineg;
 
 
-    I.SetToIdentity();
-    StressPos=I*lambda*BracketPos(trEps)+EpsPos*2*mu;
-    StressNeg=I*lambda*BracketNeg(trEps)+EpsNeg*2*mu;
+    StressPos=Consts._I*lambda*BracketPos(trEps)+EpsPos*2*mu;
+    StressNeg=Consts._I*lambda*BracketNeg(trEps)+EpsNeg*2*mu;
 
     Mate.Rank2Materials["stress"]=StressPos*(g+k)+StressNeg;
     Mate.Rank2Materials["dstressdD"]=StressPos*dg;
 
     // for vonMises stress
     double trace;
-    I.SetToIdentity();
     trace=Mate.Rank2Materials["stress"].Trace();
-    DevStress=Mate.Rank2Materials["stress"]-I*(trace/3.0);
+    DevStress=Mate.Rank2Materials["stress"]-Consts._I*(trace/3.0);
     // vonMises stress, taken from:
     // https://en.wikipedia.org/wiki/Von_Mises_yield_criterion
     // vonMises=sqrt(1.5*sij*sij)
@@ -145,14 +158,16 @@ void MieheFractureMaterial::ComputeConstitutiveLaws(const vector<double> &InputP
     signneg=0.0;
     if(BracketNeg(trEps)<0) signneg=1.0;
 
+    // jacobian=(IxI*lambda*signpos+ProjPos*2*mu)*(g+k)+IxI*lambda*signneg+ProjNeg*2*mu
     Mate.Rank4Materials["jacobian"].SetToZeros();
-    Mate.Rank4Materials["jacobian"]=(I.CrossDot(I)*lambda*signpos+ProjPos*2*mu)*(g+k)
-            +I.CrossDot(I)*lambda*signneg+ProjNeg*2*mu;
+    Mate.Rank4Materials["jacobian"].AddScaled(2*mu*(g+k),ProjPos);
+    Mate.Rank4Materials["jacobian"].AddScaled(2*mu,ProjNeg);
+    Mate.Rank4Materials["jacobian"].AddScaledCrossDot(lambda*(signpos*(g+k)+signneg),Consts._I,Consts._I);
 }
 //************************************************************
 void MieheFractureMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                       const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                      const vector<double> &gpU, const vector<double> &gpUOld,
+                                                      const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                       const vector<double> &gpUdot, const vector<double> &gpUdotOld,
                                                       const vector<Vector3d> &gpGradU,
                                                       const vector<Vector3d> &gpGradUOld,
@@ -164,10 +179,6 @@ void MieheFractureMaterial::ComputeMaterialProperties(const double &t, const dou
        gpGradU[0](1)||gpGradUOld[0](1)||gpGradUdot[0](1)||gpGradUdotOld[0](1)||
        Mate.ScalarMaterials.size()||MateOld.ScalarMaterials.size()){}
 
-    if(InputParams.size()<5){
-        MessagePrinter::PrintErrorTxt("for Miehe's phase field fracture materials, at least 5 parameters are required, you need to give: lambda, mu, Gc, L, viscosity");
-        MessagePrinter::AsFem_Exit();
-    }
 
     // 1st dof: damage
     // 2nd dof: ux
@@ -175,5 +186,28 @@ void MieheFractureMaterial::ComputeMaterialProperties(const double &t, const dou
     // 4th dof: uz
 
     ComputeStrain(nDim,gpGradU,Strain);
-    ComputeConstitutiveLaws(InputParams,Strain,gpU[1],MateOld,Mate);
-}
\ No newline at end of file
+    ComputeConstitutiveLaws(InputParams,Consts,Strain,gpU[1],MateOld,Mate);
+}
+//************************************************************
+void MieheFractureMaterial::ComputeMaterialPropertiesBatch(const double &t,const double &dt,const int &nDim,
+                                                           const vector<double> &InputParams,const MateConstants &Consts,
+                                                           BulkMateBatch &Batch){
+    // the spectral split is done qpoint by qpoint, the batch only reports the state:
+    // a qpoint is inelastic if it is damaged or its crack driving force(Hist) grows
+    const double DamageTol=1.0e-3;
+    for(int qp=0;qp<Batch._nQp;qp++){
+        ComputeMaterialProperties(t,dt,nDim,Batch._gpCoord[qp],InputParams,Consts,
+                                  Batch._gpU[qp],Batch._gpUOld[qp],
+                                  Batch._gpUdot[qp],Batch._gpUdotOld[qp],
+                                  Batch._gpGradU[qp],Batch._gpGradUOld[qp],
+                                  Batch._gpGradUdot[qp],Batch._gpGradUdotOld[qp],
+                                  Batch._MatesOld[qp],Batch._Mates[qp]);
+        if(Batch._gpU[qp][1]>DamageTol||
+           Batch._Mates[qp].ScalarMaterials.at("Hist")>Batch._MatesOld[qp].ScalarMaterials.at("Hist")){
+            Batch.SetIthQpState(qp,MateQpState::INELASTIC);
+        }
+        else{
+            Batch.SetIthQpState(qp,MateQpState::ELASTIC);
+        }
+    }
+}
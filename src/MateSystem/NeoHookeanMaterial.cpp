@@ -15,6 +15,20 @@
 
 #include "MateSystem/NeoHookeanMaterial.h"
 
+void NeoHookeanMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<2){
+        MessagePrinter::PrintErrorTxt("for neo-hookean material, two parameters are required, you need to give: E and nu");
+        MessagePrinter::AsFem_Exit();
+    }
+    // E and nu --> lambda and mu
+    const double EE=InputParams[0];
+    const double nu=InputParams[1];
+    Consts._Scalars.resize(2);
+    Consts._Scalars[0]=EE*nu/((1+nu)*(1-2*nu));// lambda
+    Consts._Scalars[1]=EE/(2*(1+nu));          // mu
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void NeoHookeanMaterial::InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                                 const vector<double> &InputParams, const vector<double> &gpU,
                                                 const vector<double> &gpUdot, const vector<Vector3d> &gpGradU,
@@ -39,27 +53,28 @@ void NeoHookeanMaterial::ComputeStrain(const int &nDim, const vector<Vector3d> &
     Strain=(_C-_I)*0.5;
 }
 //*****************************************************
-void NeoHookeanMaterial::ComputeStressAndJacobian(const vector<double> &InputParams, const RankTwoTensor &Strain,
+void NeoHookeanMaterial::ComputeStressAndJacobian(const vector<double> &InputParams, const MateConstants &Consts,const RankTwoTensor &Strain,
                                                   RankTwoTensor &Stress, RankFourTensor &Jacobian) {
     // here Strain is E
     if(Strain(1,1)){}// get rid of unused warning
 
     
-    double EE=InputParams[0];
-    double nu=InputParams[1];
-
-    double lambda=EE*nu/((1+nu)*(1-2*nu));
-    double mu=EE/(2*(1+nu));
+    if(InputParams.size()){}
+    const double lambda=Consts._Scalars[0];
+    const double mu=Consts._Scalars[1];
     double J=_F.Det();
 
     Stress=(_I-_Cinv)*mu+_Cinv*lambda*log(J);
-    Jacobian=_Cinv.ODot(_Cinv)*(mu-lambda*log(J))*2
-            +_Cinv.CrossDot(_Cinv)*lambda;
+    // Cinv.ODot(Cinv)*2*(mu-lambda*log(J))+Cinv.CrossDot(Cinv)*lambda, without the temporaries
+    Jacobian.SetToZeros();
+    Jacobian.AddScaledIkJlDot(mu-lambda*log(J),_Cinv,_Cinv);
+    Jacobian.AddScaledIlJkDot(mu-lambda*log(J),_Cinv,_Cinv);
+    Jacobian.AddScaledCrossDot(lambda,_Cinv,_Cinv);
 }
 //*****************************************************
 void NeoHookeanMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                    const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                   const vector<double> &gpU, const vector<double> &gpUOld,
+                                                   const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                    const vector<double> &gpUdot, const vector<double> &gpUdotOld,
                                                    const vector<Vector3d> &gpGradU, const vector<Vector3d> &gpGradUOld,
                                                    const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
@@ -72,7 +87,7 @@ void NeoHookeanMaterial::ComputeMaterialProperties(const double &t, const double
        gpGradUdot[0](1)||gpGradUdotOld[0](1)||MateOld.ScalarMaterials.size()){}// get rid of unused warning
 
     ComputeStrain(nDim,gpGradU,_Strain);
-    ComputeStressAndJacobian(InputParams,_Strain,_Stress,_Jac);
+    ComputeStressAndJacobian(InputParams,Consts,_Strain,_Stress,_Jac);
 
     _devStress=_Stress-_I*(_Stress.Trace()/3.0);
 
@@ -14,6 +14,14 @@
 
 #include "MateSystem/Plastic1DMaterial.h"
 
+void Plastic1DMaterial::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<3){
+        MessagePrinter::PrintErrorTxt("for 1d plastic material, three parameters are required, you need to give: E, yield stress, and hardening modulus");
+        MessagePrinter::AsFem_Exit();
+    }
+    Consts._IsSetup=true;
+}
+//****************************************************************************
 void Plastic1DMaterial::InitMaterialProperties(const int &nDim, const Vector3d &gpCoord,
                                                const vector<double> &InputParams, const vector<double> &gpU,
                                                const vector<double> &gpUdot, const vector<Vector3d> &gpGradU,
@@ -49,7 +57,7 @@ double Plastic1DMaterial::ComputeYieldFunction(const vector<double> &InputParams
 //****************************************************************************
 void Plastic1DMaterial::ComputeMaterialProperties(const double &t, const double &dt, const int &nDim,
                                                   const Vector3d &gpCoord, const vector<double> &InputParams,
-                                                  const vector<double> &gpU, const vector<double> &gpUOld,
+                                                  const MateConstants &Consts,const vector<double> &gpU, const vector<double> &gpUOld,
                                                   const vector<double> &gpUdot, const vector<double> &gpUdotOld,
                                                   const vector<Vector3d> &gpGradU, const vector<Vector3d> &gpGradUOld,
                                                   const vector<Vector3d> &gpGradUdot,
@@ -62,10 +70,6 @@ void Plastic1DMaterial::ComputeMaterialProperties(const double &t, const double
        gpUdot[0]||gpUdotOld[0]||gpGradU[0](1)||gpGradUOld[0](1)||
        gpGradUdot[0](1)||gpGradUdotOld[0](1)||MateOld.ScalarMaterials.size()){}
 
-    if(InputParams.size()<3){
-        MessagePrinter::PrintErrorTxt("for 1d plastic material, three parameters are required, you need to give: E, yield stress, and hardening modulus");
-        MessagePrinter::AsFem_Exit();
-    }
 
     _E=InputParams[1-1];
     _hardening_modulus=InputParams[3-1];
@@ -98,8 +102,7 @@ void Plastic1DMaterial::ComputeMaterialProperties(const double &t, const double
 
     Mate.ScalarMaterials["effective_plastic_strain"]=MateOld.ScalarMaterials.at("effective_plastic_strain")+_DeltaGamma;
 
-    _I.SetToIdentity();
-    _devStress=_Stress-_I*(_Stress.Trace()/3.0);
+    _devStress=_Stress-Consts._I*(_Stress.Trace()/3.0);
     Mate.ScalarMaterials["vonMises"]=sqrt(1.5*_devStress.DoubleDot(_devStress));
 
     Mate.Rank2Materials["stress"]=_Stress;
@@ -25,62 +25,111 @@ void BulkMateSystem::RunBulkMateLibs(const MateType &imate,const int &mateindex,
         case MateType::NULLMATE:
             break;
         case MateType::CONSTPOISSONMATE:
-            ConstPoissonMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            ConstPoissonMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                         gpU,gpUOld,gpUdot,gpUdotOld,
                                                         gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                         _MaterialsOld,_Materials);
             break;
         case MateType::CONSTDIFFUSIONMATE:
-            ConstDiffusionMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            ConstDiffusionMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                           gpU,gpUOld,gpUdot,gpUdotOld,
                                                           gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                           _MaterialsOld,_Materials);
             break;
         case MateType::DOUBLEWELLFREENERGYMATE:
-            DoubleWellFreeEnergyMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            DoubleWellFreeEnergyMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                                 gpU,gpUOld,gpUdot,gpUdotOld,
                                                                 gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                                 _MaterialsOld,_Materials);
             break;
         case MateType::LINEARELASTICMATE:
-            LinearElasticMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            LinearElasticMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                          gpU,gpUOld,gpUdot,gpUdotOld,
                                                          gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                          _MaterialsOld,_Materials);
             break;
         case MateType::INCREMENTSMALLSTRAINMATE:
-            IncrementSmallStrainMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            IncrementSmallStrainMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                                 gpU,gpUOld,gpUdot,gpUdotOld,
                                                                 gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                                 _MaterialsOld,_Materials);
             break;
         case MateType::NEOHOOKEANMATE:
-            NeoHookeanMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            NeoHookeanMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                       gpU,gpUOld,gpUdot,gpUdotOld,
                                                       gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                       _MaterialsOld,_Materials);
             break;
         case MateType::PLASTIC1DMATE:
-            Plastic1DMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            Plastic1DMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                          gpU,gpUOld,gpUdot,gpUdotOld,
                                                          gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                          _MaterialsOld,_Materials);
             break;
         case MateType::J2PLASTICITYMATE:
-            J2PlasticityMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            J2PlasticityMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                             gpU,gpUOld,gpUdot,gpUdotOld,
                                                             gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                             _MaterialsOld,_Materials);
             break;
         case MateType::MIEHEFRACTUREMATE:
-            MieheFractureMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,
+            MieheFractureMaterial::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
                                                          gpU,gpUOld,gpUdot,gpUdotOld,
                                                          gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
                                                          _MaterialsOld,_Materials);
             break;
+        case MateType::USER1MATE:
+            User1Material::ComputeMaterialProperties(t,dt,nDim,gpCoord,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,
+                                                     gpU,gpUOld,gpUdot,gpUdotOld,
+                                                     gpGradU,gpGradUOld,gpGradUdot,gpGradUdotOld,
+                                                     _MaterialsOld,_Materials);
+            break;
         default:
             MessagePrinter::PrintErrorTxt("unsupported material type in RunBulkMateLibs of MateSystem, please check either your code or your input file");
             MessagePrinter::AsFem_Exit();
             break;
     }
-}
\ No newline at end of file
+}
+//****************************************************************
+void BulkMateSystem::RunBulkMateLibsBatch(const MateType &imate,const int &mateindex,const int &nDim,
+                                          const double &t,const double &dt,BulkMateBatch &Batch){
+    Batch.ResetSymTangent();
+    switch (imate){
+        case MateType::NULLMATE:
+            break;
+        case MateType::CONSTPOISSONMATE:
+            ConstPoissonMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::CONSTDIFFUSIONMATE:
+            ConstDiffusionMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::DOUBLEWELLFREENERGYMATE:
+            DoubleWellFreeEnergyMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::LINEARELASTICMATE:
+            LinearElasticMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::INCREMENTSMALLSTRAINMATE:
+            IncrementSmallStrainMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::NEOHOOKEANMATE:
+            NeoHookeanMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::PLASTIC1DMATE:
+            Plastic1DMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::J2PLASTICITYMATE:
+            J2PlasticityMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::MIEHEFRACTUREMATE:
+            MieheFractureMaterial::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        case MateType::USER1MATE:
+            User1Material::ComputeMaterialPropertiesBatch(t,dt,nDim,_BulkMateBlockList[mateindex-1]._Parameters,_BulkMateBlockList[mateindex-1]._Constants,Batch);
+            break;
+        default:
+            MessagePrinter::PrintErrorTxt("unsupported material type in RunBulkMateLibsBatch of MateSystem, please check either your code or your input file");
+            MessagePrinter::AsFem_Exit();
+            break;
+    }
+}
@@ -0,0 +1,69 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: call the setup stage of each material block, the
+//+++          parameters are checked and the derived constants are
+//+++          cached in the block, only once before the analysis
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "MateSystem/BulkMateSystem.h"
+
+void BulkMateSystem::SetupBulkMateLibs(const MateType &imate,const int &mateindex){
+    switch (imate){
+        case MateType::NULLMATE:
+            _BulkMateBlockList[mateindex-1]._Constants._IsSetup=true;
+            break;
+        case MateType::CONSTPOISSONMATE:
+            ConstPoissonMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::CONSTDIFFUSIONMATE:
+            ConstDiffusionMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::DOUBLEWELLFREENERGYMATE:
+            DoubleWellFreeEnergyMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::LINEARELASTICMATE:
+            LinearElasticMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::INCREMENTSMALLSTRAINMATE:
+            IncrementSmallStrainMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::NEOHOOKEANMATE:
+            NeoHookeanMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::PLASTIC1DMATE:
+            Plastic1DMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::J2PLASTICITYMATE:
+            J2PlasticityMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::MIEHEFRACTUREMATE:
+            MieheFractureMaterial::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        case MateType::USER1MATE:
+            User1Material::SetupMaterialConstants(_BulkMateBlockList[mateindex-1]._Parameters,
+                                        _BulkMateBlockList[mateindex-1]._Constants);
+            break;
+        default:
+            MessagePrinter::PrintErrorTxt("unsupported material type in SetupBulkMateLibs of MateSystem, please check either your code or your input file");
+            MessagePrinter::AsFem_Exit();
+            break;
+    }
+}
@@ -9,67 +9,77 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 //+++ Author : Yang Bai
 //+++ Date   : 2021.01.18
-//+++ Purpose: Calculate the User-Defined-Material
+//+++ Purpose: Calculate the User-Defined-Material, the jacobian
+//+++          is derived from the stress by the forward mode
+//+++          automatic differentiation
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-#include "MateSystem/BulkMateSystem.h"
+#include "MateSystem/User1Material.h"
 
-void BulkMateSystem::User1Material(const int &nDim, const double &t, const double &dt,
-                                   const vector<double> &InputParams, const Vector3d &gpCoord,
-                                   const vector<double> &gpU, const vector<double> &gpV,
-                                   const vector<Vector3d> &gpGradU, const vector<Vector3d> &gpGradV,
-                                   vector<double> &gpHist, const vector<double> &gpHistOld) {
-
-    //*****************************************************************************
-    //*** just to get rid of warnings, normal users dont need to do this
-    //*****************************************************************************
-    if(nDim||t||dt||InputParams.size()||
-       gpCoord(1)||gpU.size()||gpV.size()||gpGradU.size()||gpGradV.size()||
-       gpHist.size()||gpHistOld.size()){}
-
-    if(InputParams.size()<3){
-        MessagePrinter::PrintErrorTxt("for linear elastic material, two parameters are required, you need to give: E, nu, and D");
+void User1Material::SetupMaterialConstants(const vector<double> &InputParams,MateConstants &Consts){
+    if(InputParams.size()<2){
+        MessagePrinter::PrintErrorTxt("for user1 material, at least two parameters are required, you need to give: E, nu and alpha(optional)");
         MessagePrinter::AsFem_Exit();
     }
+    const double E=InputParams[0];
+    const double nu=InputParams[1];
+    Consts._Scalars.resize(3);
+    Consts._Scalars[0]=E/(3.0*(1.0-2.0*nu));// bulk modulus
+    Consts._Scalars[1]=E/(2.0*(1.0+nu));    // shear modulus
+    Consts._Scalars[2]=(InputParams.size()>=3)?InputParams[2]:0.0;// shear stiffening
+    Consts._IsSetup=true;
+}
+//****************************************************************************
+void User1Material::InitMaterialProperties(const int &nDim,const Vector3d &gpCoord,const vector<double> &InputParams,
+                                           const vector<double> &gpU,const vector<double> &gpUdot,
+                                           const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUdot,
+                                           Materials &Mate) {
+    // Here we do not consider any initial internal strains, stress
+    if(nDim||gpCoord(1)||InputParams.size()||gpU[0]||gpUdot[0]||
+       gpGradU[0](1)||gpGradUdot[0](1)||Mate.ScalarMaterials.size()){}
+}
+//****************************************************************************
+void User1Material::ComputeStrain(const int &nDim,const vector<Vector3d> &GradDisp, RankTwoTensor &Strain) {
+    if(nDim==1){
+        _GradU.SetFromGradU(GradDisp[1]);
+    }
+    else if(nDim==2){
+        _GradU.SetFromGradU(GradDisp[1],GradDisp[2]);
+    }
+    else if(nDim==3){
+        _GradU.SetFromGradU(GradDisp[1],GradDisp[2],GradDisp[3]);
+    }
+    Strain=(_GradU+_GradU.Transpose())*0.5;
+}
+//****************************************************************************
+void User1Material::ComputeStressAndJacobian(const vector<double> &InputParams,const MateConstants &Consts,const RankTwoTensor &Strain,
+                                             RankTwoTensor &Stress,RankFourTensor &Jacobian) {
+    if(InputParams.size()){}
+    // the strain components are the independent variables, d(stress)/d(strain) comes with the stress
+    ADComputeSymStressAndJacobian(Strain,
+                                  [&](const RankTwoTensorT<ADSymReal> &strain){return ComputeUserStress(Consts,strain);},
+                                  Stress,Jacobian);
+}
+//****************************************************************************
+void User1Material::ComputeMaterialProperties(const double &t, const double &dt,const int &nDim,
+                                              const Vector3d &gpCoord,const vector<double> &InputParams,
+                                              const MateConstants &Consts,const vector<double> &gpU,const vector<double> &gpUOld,
+                                              const vector<double> &gpUdot,const vector<double> &gpUdotOld,
+                                              const vector<Vector3d> &gpGradU,const vector<Vector3d> &gpGradUOld,
+                                              const vector<Vector3d> &gpGradUdot,const vector<Vector3d> &gpGradUdotOld,
+                                              const Materials &MateOld, Materials &Mate) {
 
-    //const double E=InputParams[0];
-    //const double nu=InputParams[1];
-    //const double D=InputParams[2];
+    if(t||dt||gpCoord(1)||gpU[0]||gpUOld[0]||
+    gpUdot[0]||gpUdotOld[0]||gpGradU[0](1)||gpGradUOld[0](1)||
+    gpGradUdot[0](1)||gpGradUdotOld[0](1)||MateOld.ScalarMaterials.size()){}// get rid of unused warning
 
-    // for our elasticity tensor
-//    _Rank4Materials["elasticity_tensor"].SetToZeros();
-//    _Rank4Materials["elasticity_tensor"].SetFromEandNu(E,nu);
-//
-//    // for our small strain
-//    _Rank2Materials["strain"].SetToZeros();
-//    RankTwoTensor GradU;
-//    GradU.SetToZeros();
-//    if(nDim==1){
-//        GradU.SetFromGradU(gpGradU[2]);
-//    }
-//    else if(nDim==2){
-//        GradU.SetFromGradU(gpGradU[2],gpGradU[3]);
-//    }
-//    else if(nDim==3){
-//        GradU.SetFromGradU(gpGradU[2],gpGradU[3],gpGradU[4]);
-//    }
-//    // epsilon_ij=0.5*(Ui,j+Uj,i)
-//    _Rank2Materials["strain"]=(GradU+GradU.Transpose())*0.5;
-//
-//    // our stress
-//    _Rank2Materials["stress"]=_Rank4Materials["elasticity_tensor"].DoubleDot(_Rank2Materials["strain"]);
-//
-//    // for vonMises stress
-//    RankTwoTensor I,devStress;
-//    double trace;
-//    I.SetToIdentity();
-//    trace=_Rank2Materials["stress"].Trace();
-//
-//    devStress=_Rank2Materials["stress"]-I*(trace/3.0);
-//    // vonMises stress, taken from:
-//    // https://en.wikipedia.org/wiki/Von_Mises_yield_criterion
-//    // vonMises=sqrt(1.5*sij*sij)
-//    _ScalarMaterials["vonMises"]=sqrt(1.5*devStress.DoubleDot(devStress));
-//    _ScalarMaterials["D"]=D;
-}
+    ComputeStrain(nDim,gpGradU,_Strain);
+    ComputeStressAndJacobian(InputParams,Consts,_Strain,_Stress,_Jac);
+
+    _devStress=_Stress-Consts._I*(_Stress.Trace()/3.0);
 
+    Mate.ScalarMaterials["vonMises"]=sqrt(1.5*_devStress.DoubleDot(_devStress));
+    Mate.Rank2Materials["strain"]=_Strain;
+    Mate.Rank2Materials["stress"]=_Stress;
+    Mate.Rank4Materials["jacobian"]=_Jac;
+}
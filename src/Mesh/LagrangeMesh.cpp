@@ -39,6 +39,7 @@ LagrangeMesh::LagrangeMesh(){
     _ElmtPhyIDList.clear();
     _ElmtDimList.clear();
     _ElmtMeshTypeList.clear();
+    _BulkMeshTypeList.clear();
     _BulkElmtVTKCellType=0;
     _BulkMeshTypeName="quad4";
     _TotalVolume=0.0;
@@ -128,4 +129,32 @@ void LagrangeMesh::SetBulkMeshMeshTypeName(string meshname){
         MessagePrinter::PrintErrorTxt("unsupported mesh type setting");
         MessagePrinter::AsFem_Exit();
     }
-}
\ No newline at end of file
+}
+//*********************************************************************
+void LagrangeMesh::CreateBulkMeshTypeList(){
+    // the built-in mesh generator doesn't fill the mesh type of each element
+    if(static_cast<int>(_ElmtMeshTypeList.size())!=_nElmts){
+        _ElmtMeshTypeList.assign(_nElmts,MeshType::NULLTYPE);
+        for(int e=_nElmts-_nBulkElmts;e<_nElmts;e++) _ElmtMeshTypeList[e]=_BulkMeshType;
+    }
+    _BulkMeshTypeList.clear();
+    int nmax=0;
+    MeshType meshtype;
+    for(int e=1;e<=_nBulkElmts;e++){
+        meshtype=GetBulkMeshIthBulkElmtMeshType(e);
+        if(meshtype==MeshType::NULLTYPE){
+            MessagePrinter::PrintErrorTxt("unsupported bulk element type in your mesh, please check your mesh file");
+            MessagePrinter::AsFem_Exit();
+        }
+        if(find(_BulkMeshTypeList.begin(),_BulkMeshTypeList.end(),meshtype)==_BulkMeshTypeList.end()){
+            _BulkMeshTypeList.push_back(meshtype);
+        }
+        if(GetBulkMeshIthBulkElmtNodesNum(e)>nmax) nmax=GetBulkMeshIthBulkElmtNodesNum(e);
+    }
+    // the max one is used to allocate the local arrays
+    _nNodesPerBulkElmt=nmax;
+    if(_BulkMeshTypeList.size()>0&&
+       find(_BulkMeshTypeList.begin(),_BulkMeshTypeList.end(),_BulkMeshType)==_BulkMeshTypeList.end()){
+        _BulkMeshType=_BulkMeshTypeList[0];
+    }
+}
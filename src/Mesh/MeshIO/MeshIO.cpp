@@ -27,24 +27,29 @@ MeshIO::MeshIO(){
 }
 
 bool MeshIO::ReadMeshFromFile(Mesh &mesh){
+    bool IsSuccess=false;
     switch (_MeshIOType)
     {
     case MeshIOType::GMSH2:
         // cout<<"using gmsh2"<<endl;
-        return Gmsh2IO::ReadMeshFromFile(mesh);
+        IsSuccess=Gmsh2IO::ReadMeshFromFile(mesh);
         break;
     case MeshIOType::GMSH4:
         // cout<<"using gmsh4"<<endl;
-        return Gmsh4IO::ReadMeshFromFile(mesh);
+        IsSuccess=Gmsh4IO::ReadMeshFromFile(mesh);
         break;
     case MeshIOType::NETGEN:
         MessagePrinter::PrintErrorTxt("Netgen mesh is not supported yet!");
         return false;
     case MeshIOType::ABAQUS:
-        return AbaqusIO::ReadMeshFromFile(mesh);
+        IsSuccess=AbaqusIO::ReadMeshFromFile(mesh);
+        break;
     default:
         return false;
     }
+    // the mesh may contain different bulk element types, i.e. quad4+tri3
+    if(IsSuccess) mesh.CreateBulkMeshTypeList();
+    return IsSuccess;
 }
 void MeshIO::SetMeshFileName(string filename){
     if(IsGmsh2MeshFile(filename)){
@@ -29,6 +29,9 @@ NonlinearSolver::NonlinearSolver(){
     _SolverTypeName="newton with line search";
     _LinearSolverName="petsc";
     _PCTypeName="lu";
+    _UseNewtonNPC=false;
+    _Depth=-1;
+    _Damping=-1.0;
 }
 
 void NonlinearSolver::SetOptionsFromNonlinearSolverBlock(NonlinearSolverBlock &nonlinearsolverblock){
@@ -42,6 +45,9 @@ void NonlinearSolver::SetOptionsFromNonlinearSolverBlock(NonlinearSolverBlock &n
     _SolverTypeName=nonlinearsolverblock._SolverTypeName;
     _LinearSolverName=nonlinearsolverblock._LinearSolverName;
     _PCTypeName=nonlinearsolverblock._PCTypeName;
+    _UseNewtonNPC=nonlinearsolverblock._UseNewtonNPC;
+    _Depth=nonlinearsolverblock._Depth;
+    _Damping=nonlinearsolverblock._Damping;
 }
 void NonlinearSolver::Init(){
     //**************************************************
@@ -105,8 +111,9 @@ void NonlinearSolver::Init(){
     else if(_SolverType==NonlinearSolverType::NEWTONCG){
         SNESSetType(_snes,SNESNCG);
     }
-    else if(_SolverType==NonlinearSolverType::NEWTONGMRES){
-        SNESSetType(_snes,SNESNGMRES);
+    else if(IsSNESMixingType(_SolverType)){
+        // anderson and ngmres, the newton step of the nonlinear preconditioner uses _ksp
+        SetSNESMixingOptions(_snes,_ksp,_SolverType,_UseNewtonNPC,_Depth,_Damping,_RAbsTol,_RRelTol,_STol);
     }
 }
 
@@ -142,7 +149,22 @@ void NonlinearSolver::PrintInfo()const{
     else if(_SolverType==NonlinearSolverType::NEWTONGMRES){
         str="  solver type= newton GMRES";
     }
+    else if(_SolverType==NonlinearSolverType::ANDERSON){
+        str="  solver type= anderson";
+    }
     MessagePrinter::PrintNormalTxt(str);
+    if(_SolverType==NonlinearSolverType::ANDERSON||_SolverType==NonlinearSolverType::NEWTONGMRES){
+        str=_UseNewtonNPC?"  nonlinear preconditioner= newton":"  nonlinear preconditioner= none";
+        if(_Depth>0) str+=", depth="+to_string(_Depth);
+        if(_Damping>0.0){
+            snprintf(buff,70,", damping=%8.3f",_Damping);
+            str+=string(buff);
+        }
+        MessagePrinter::PrintNormalTxt(str);
+        if(_Damping>0.0&&_SolverType==NonlinearSolverType::NEWTONGMRES){
+            MessagePrinter::PrintNormalTxt("  ngmres uses the line search selection for the damping");
+        }
+    }
 
     snprintf(buff,70,"  max iters=%3d, abs R tol=%13.5e, rel R tol=%13.5e",_MaxIters,_RAbsTol,_RRelTol);
     str=buff;
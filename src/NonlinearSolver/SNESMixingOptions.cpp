@@ -0,0 +1,71 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the settings of the anderson and ngmres solvers, see
+//+++          SNESMixingOptions.h
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <string>
+
+#include "NonlinearSolver/SNESMixingOptions.h"
+
+using namespace std;
+
+//****************************************************************
+//*** PETSc has no setter for the depth(m) of anderson and ngmres and
+//*** the damping(beta) of anderson, they are only read by SNESSetFromOptions.
+//*** So the value is given to the options database with the prefix of snes,
+//*** read by snes, then removed, it never reaches the other solvers. The
+//*** option given in the command line is kept and wins.
+//****************************************************************
+static void SetSNESOptionValue(SNES &snes,const string &name,const string &value){
+    const char *prefix;
+    PetscBool HasOption;
+    SNESGetOptionsPrefix(snes,&prefix);
+    PetscOptionsHasName(NULL,prefix,("-"+name).c_str(),&HasOption);
+    if(HasOption) return;
+
+    const string option="-"+string(prefix?prefix:"")+name;
+    PetscOptionsSetValue(NULL,option.c_str(),value.c_str());
+    SNESSetFromOptions(snes);
+    PetscOptionsClearValue(NULL,option.c_str());
+}
+//****************************************************************
+void SetSNESMixingOptions(SNES &snes,KSP &ksp,const NonlinearSolverType &solvertype,
+                          const bool &useNewtonNPC,const int &depth,const double &damping,
+                          const double &rabstol,const double &rreltol,const double &stol){
+    const bool IsAnderson=solvertype==NonlinearSolverType::ANDERSON;
+    if(!IsSNESMixingType(solvertype)) return;
+
+    SNESSetType(snes,IsAnderson?SNESANDERSON:SNESNGMRES);
+    if(damping>0.0&&!IsAnderson){
+        // ngmres has no mixing damping, its candidate is damped by the line search
+        // selection instead of the default difference one, see NonlinearSolver::PrintInfo
+        SNESNGMRESSetSelectType(snes,SNES_NGMRES_SELECT_LINESEARCH);
+        SNESLineSearch linesearch;
+        SNESGetLineSearch(snes,&linesearch);
+        SNESLineSearchSetDamping(linesearch,damping);
+    }
+    if(useNewtonNPC){
+        // one newton step per outer iteration, the outer solver has no linear solve
+        SNES npc;
+        SNESGetNPC(snes,&npc);
+        SNESSetType(npc,SNESNEWTONLS);
+        SNESSetTolerances(npc,rabstol,rreltol,stol,1,-1);
+        SNESSetKSP(npc,ksp);
+    }
+    if(depth>0){
+        SetSNESOptionValue(snes,IsAnderson?"snes_anderson_m":"snes_ngmres_m",to_string(depth));
+    }
+    if(damping>0.0&&IsAnderson){
+        SetSNESOptionValue(snes,"snes_anderson_beta",to_string(damping));
+    }
+}
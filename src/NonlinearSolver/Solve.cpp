@@ -49,8 +49,15 @@ PetscErrorCode Monitor(SNES snes,PetscInt iters,PetscReal rnorm,void* ctx){
 //***************************************************************
 PetscErrorCode ComputeResidual(SNES snes,Vec U,Vec RHS,void *ctx){
     AppCtx *user=(AppCtx*)ctx;
-    int i;
-    SNESGetMaxNonlinearStepFailures(snes,&i);// just to get rid of unused snes warning
+    PetscInt lag;
+    FECalcType calctype=FECalcType::ComputeResidual;
+    // the jacobian is assembled together with the residual, unless it is lagged(then most
+    // of the residuals are not followed by a jacobian, the separate passes are cheaper)
+    SNESGetLagJacobian(snes,&lag);
+    if(user->_feSystem.IsFusedAssemblyEnabled()&&lag==1){
+        calctype=FECalcType::ComputeResidualAndJacobian;
+        user->_feSystem.ResetMaxAMatrixValue();
+    }
     user->_bcSystem.ApplyInitialBC(user->_mesh,user->_dofHandler,user->_fectrlinfo.t,U);
 
     user->_fectrlinfo.ctan[0]=1.0;
@@ -63,7 +70,7 @@ PetscErrorCode ComputeResidual(SNES snes,Vec U,Vec RHS,void *ctx){
 
     VecCopy(U,user->_solutionSystem._Unew);
     
-    user->_feSystem.FormBulkFE(FECalcType::ComputeResidual,
+    user->_feSystem.FormBulkFE(calctype,
                         user->_fectrlinfo.t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
                         user->_mesh,user->_dofHandler,user->_fe,
                         user->_elmtSystem,user->_mateSystem,
@@ -76,6 +83,9 @@ PetscErrorCode ComputeResidual(SNES snes,Vec U,Vec RHS,void *ctx){
                     FECalcType::ComputeResidual,user->_fectrlinfo.t,user->_fectrlinfo.ctan,U,
                     user->_equationSystem._AMATRIX,RHS);
 
+    // the materials(and the fused jacobian) of this iterate can be reused by the jacobian
+    user->_feSystem.StampResidualIterate(U,user->_solutionSystem._U,user->_fectrlinfo.t,user->_fectrlinfo.dt,user->_solutionSystem);
+
     return 0;
 }
 
@@ -86,24 +96,39 @@ PetscErrorCode ComputeJacobian(SNES snes,Vec U,Mat A,Mat B,void *ctx){
     AppCtx *user=(AppCtx*)ctx;
     int i;
 
-    user->_feSystem.ResetMaxAMatrixValue();
-    user->_bcSystem.ApplyInitialBC(user->_mesh,user->_dofHandler,user->_fectrlinfo.t,U);
-
     user->_fectrlinfo.ctan[0]=1.0;
     user->_fectrlinfo.ctan[1]=0.0;
 
+    // check whether U is still the iterate of the last residual, before U is modified
+    user->_feSystem.CheckResidualIterate(U,user->_solutionSystem._U,user->_fectrlinfo.t,user->_fectrlinfo.dt,
+                                         user->_fectrlinfo.ctan,user->_solutionSystem);
+    user->_bcSystem.ApplyInitialBC(user->_mesh,user->_dofHandler,user->_fectrlinfo.t,U);
+
     //*** calculate the current velocity
     VecWAXPY(user->_solutionSystem._V,-1.0,user->_solutionSystem._U,U);//V=-Uold+Unew
     VecScale(user->_solutionSystem._V,user->_fectrlinfo.ctan[1]);//V=V*1.0/dt
 
     VecCopy(U,user->_solutionSystem._Unew);
 
-    user->_feSystem.FormBulkFE(FECalcType::ComputeJacobian,
-                        user->_fectrlinfo.t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
-                        user->_mesh,user->_dofHandler,user->_fe,
-                        user->_elmtSystem,user->_mateSystem,
-                        user->_solutionSystem,
-                        A,user->_equationSystem._RHS);
+    if(user->_feSystem.IsFusedJacobianReusable()&&A==user->_equationSystem._AMATRIX){
+        // the bulk part of A is already assembled by the last residual, only the bc is applied
+    }
+    else{
+        user->_feSystem.ResetMaxAMatrixValue();
+        user->_feSystem.FormBulkFE(FECalcType::ComputeJacobian,
+                            user->_fectrlinfo.t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                            user->_mesh,user->_dofHandler,user->_fe,
+                            user->_elmtSystem,user->_mateSystem,
+                            user->_solutionSystem,
+                            A,user->_equationSystem._RHS);
+    }
+    // the 'jacobian=fd' blocks are not in the analytic part above
+    if(user->_feSystem.HasFDJacobian()){
+        user->_feSystem.FormFDJacobian(user->_fectrlinfo.t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                            user->_mesh,user->_dofHandler,user->_fe,
+                            user->_elmtSystem,user->_mateSystem,
+                            user->_solutionSystem,A);
+    }
     
     if(user->_feSystem.GetMaxAMatrixValue()>1.0e12){
         user->_bcSystem.SetBCPenaltyFactor(1.0e20);
@@ -0,0 +1,292 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the incremental static analysis, the loads and the
+//+++          dirichlet values are ramped by the load factor lambda
+//+++          from 0 to 1:
+//+++            1) load control: each increment is solved by SNES,
+//+++               starting from the converged solution plus the
+//+++               tangent extrapolation dU/dlambda*dlambda
+//+++            2) arc-length: the cylindrical constraint of Crisfield
+//+++               |dU|=dl, lambda is one more unknown, it is solved
+//+++               by the bordered newton iterations, so the path can
+//+++               pass the limit points
+//+++          the increment is cut back if the step is failed, and
+//+++          grown if it converges quickly
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "NonlinearSolver/NonlinearSolver.h"
+
+//***************************************************************
+//*** the residual of the load factor lambda, U gets its dirichlet values
+//***************************************************************
+double NonlinearSolver::GetLoadStepResidualNorm(const double &lambda,Vec &U,Vec &R){
+    PetscReal rnorm;
+    _appctx._bcSystem.SetLoadFactor(lambda);
+    ComputeResidual(_snes,U,R,&_appctx);
+    VecNorm(R,NORM_2,&rnorm);
+    return rnorm;
+}
+//***************************************************************
+void NonlinearSolver::ComputeLoadDerivative(const double &lambda,Vec &U,const Vec &R,Vec &q){
+    // the loads are linear in lambda, but the dirichlet values also change the interior residual
+    // through the elements, so q is given by the forward difference of the residual
+    const double eps=1.0e-6*(abs(lambda)>1.0?abs(lambda):1.0);
+    Vec &Up=_LoadWork[3];
+    VecCopy(U,Up);
+    _appctx._bcSystem.SetLoadFactor(lambda+eps);
+    ComputeResidual(_snes,Up,q,&_appctx);
+    _appctx._bcSystem.SetLoadFactor(lambda);
+    VecAXPY(q,-1.0,R);
+    VecScale(q,1.0/eps);
+}
+//***************************************************************
+void NonlinearSolver::ComputeLoadTangent(const double &lambda,Vec &U,Vec &Ut){
+    // K*Ut=-q for the free dofs, the dirichlet dofs are fixed by the penalty, then they follow G
+    Vec &Up=_LoadWork[3],&q=_LoadWork[2],&R=_LoadWork[4];
+    Mat &A=_appctx._equationSystem._AMATRIX;
+    VecCopy(U,Up);
+    GetLoadStepResidualNorm(lambda,Up,R);
+    ComputeLoadDerivative(lambda,Up,R,q);
+    VecCopy(U,Up);
+    ComputeJacobian(_snes,Up,A,A,&_appctx);
+    KSPSetOperators(_ksp,A,A);
+    KSPSolve(_ksp,q,Ut);
+    VecScale(Ut,-1.0);
+    VecAXPY(Ut,1.0,_LoadG);
+}
+//***************************************************************
+bool NonlinearSolver::SolveLoadControlStep(const double &lambda,const double &dlambda,Vec &Un){
+    Vec &U=_appctx._solutionSystem._Unew;
+    Vec &Ut=_LoadWork[5];
+    // warm start: the converged solution plus the tangent extrapolation
+    ComputeLoadTangent(lambda,Un,Ut);
+    VecWAXPY(U,dlambda,Ut,Un);
+    _appctx._bcSystem.SetLoadFactor(lambda+dlambda);
+
+    _monctx.iters=0;
+    SNESSolve(_snes,NULL,U);
+    SNESGetConvergedReason(_snes,&_snesreason);
+    _LoadStepIters=_monctx.iters+1;
+    return _snesreason>0;
+}
+//***************************************************************
+bool NonlinearSolver::SolveArcLengthStep(const double &lambda,const double &dl,Vec &Un,Vec &dUprev,double &dlambda){
+    Vec &U=_appctx._solutionSystem._Unew;
+    Vec &dU=_LoadWork[0],&duR=_LoadWork[1],&q=_LoadWork[2],&Up=_LoadWork[3],&R=_LoadWork[4],&duq=_LoadWork[5];
+    Mat &A=_appctx._equationSystem._AMATRIX;
+    PetscReal rnorm,rnorm0=1.0,a1,a2,a3,c0,c1,dot,disc,ddl,ddl1,ddl2;
+    char buff[70];
+
+    // predictor along the tangent, the direction follows the previous increment, so the path
+    // goes on after the limit point instead of turning back
+    ComputeLoadTangent(lambda,Un,duq);
+    VecDot(duq,dUprev,&dot);
+    VecNorm(duq,NORM_2,&a1);
+    if(a1<1.0e-15) return false;
+    dlambda=(dot<0.0)?-dl/a1:dl/a1;
+    VecCopy(duq,dU);
+    VecScale(dU,dlambda);
+
+    for(int iter=0;iter<_MaxIters;iter++){
+        VecWAXPY(U,1.0,dU,Un);
+        rnorm=GetLoadStepResidualNorm(lambda+dlambda,U,R);
+        // the dirichlet dofs of U are reset by the bcs, dU must be the same as the one of U
+        VecWAXPY(dU,-1.0,Un,U);
+        if(iter==0) rnorm0=rnorm;
+        if(_monctx.IsDepDebug){
+            snprintf(buff,70,"  arc-length: iters=%3d,|R|=%11.4e,dlambda=%11.4e",iter,rnorm,dlambda);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
+        if(rnorm<_RAbsTol||(iter>0&&rnorm<_RRelTol*rnorm0)){
+            _LoadStepIters=iter+1;
+            _monctx.rnorm0=rnorm0;_monctx.rnorm=rnorm;
+            return true;
+        }
+        // the bordered newton step, both of them use the same factorization: K*duR=-R, K*duq=-q
+        ComputeLoadDerivative(lambda+dlambda,U,R,q);
+        VecCopy(U,Up);
+        ComputeJacobian(_snes,Up,A,A,&_appctx);
+        KSPSetOperators(_ksp,A,A);
+        KSPSolve(_ksp,R,duR);
+        VecScale(duR,-1.0);
+        KSPSolve(_ksp,q,duq);
+        VecScale(duq,-1.0);
+        VecAXPY(duq,1.0,_LoadG);
+
+        // the cylindrical constraint |dU+duR+ddl*duq|=dl, duR=dU+duR is used below
+        VecAXPY(duR,1.0,dU);
+        VecDot(duq,duq,&a1);
+        VecDot(duq,duR,&a2);a2*=2.0;
+        VecDot(duR,duR,&a3);a3-=dl*dl;
+        disc=a2*a2-4.0*a1*a3;
+        if(a1<1.0e-30||disc<0.0) return false;// no real root, the arc length should be cut back
+        ddl1=(-a2+sqrt(disc))/(2.0*a1);
+        ddl2=(-a2-sqrt(disc))/(2.0*a1);
+        // the root whose increment is closer to the current one
+        VecDot(duR,dU,&c0);
+        VecDot(duq,dU,&c1);
+        ddl=(c0+ddl1*c1>=c0+ddl2*c1)?ddl1:ddl2;
+        VecWAXPY(dU,ddl,duq,duR);
+        dlambda+=ddl;
+    }
+    _LoadStepIters=_MaxIters;
+    return false;
+}
+
+//***************************************************************
+//*** the incremental static analysis
+//***************************************************************
+bool NonlinearSolver::SolveLoadSteps(Mesh &mesh,DofHandler &dofHandler,
+                        ElmtSystem &elmtSystem,MateSystem &mateSystem,
+                        BCSystem &bcSystem,ICSystem &icSystem,
+                        SolutionSystem &solutionSystem,EquationSystem &equationSystem,
+                        FE &fe,FESystem &feSystem,
+                        OutputSystem &outputSystem,
+                        Postprocess &postprocessSystem,
+                        FEControlInfo &fectrlinfo){
+    _appctx=AppCtx{mesh,dofHandler,
+                   bcSystem,icSystem,
+                   elmtSystem,mateSystem,
+                   solutionSystem,equationSystem,
+                   fe,feSystem,
+                   fectrlinfo
+                   };
+
+    _monctx=MonitorCtx{0.0,1.0,
+            0.0,1.0,
+            0.0,1.0,
+            0,
+            fectrlinfo.IsDepDebug};
+
+    SNESSetFunction(_snes,_appctx._equationSystem._RHS,ComputeResidual,&_appctx);
+    SNESSetJacobian(_snes,_appctx._equationSystem._AMATRIX,_appctx._equationSystem._AMATRIX,ComputeJacobian,&_appctx);
+    SNESMonitorSet(_snes,Monitor,&_monctx,0);
+    SNESSetForceIteration(_snes,PETSC_TRUE);
+    SNESSetFromOptions(_snes);
+
+    Vec &U=_appctx._solutionSystem._Unew;
+    Vec Un,dUprev;
+    VecDuplicate(U,&Un);
+    VecDuplicate(U,&dUprev);
+    VecDuplicate(U,&_LoadG);
+    for(int i=0;i<6;i++) VecDuplicate(U,&_LoadWork[i]);
+
+    // G is the dirichlet values of lambda=1, the other dofs are zero
+    VecSet(_LoadG,0.0);
+    _appctx._bcSystem.SetLoadFactor(1.0);
+    _appctx._bcSystem.ApplyInitialBC(_appctx._mesh,_appctx._dofHandler,fectrlinfo.t,_LoadG);
+    // the start point is the unloaded state
+    _appctx._bcSystem.SetLoadFactor(0.0);
+    _appctx._bcSystem.ApplyInitialBC(_appctx._mesh,_appctx._dofHandler,fectrlinfo.t,U);
+    VecCopy(U,Un);
+    VecSet(dUprev,0.0);
+    _appctx._feSystem.FormBulkFE(FECalcType::InitHistoryVariable,fectrlinfo.t,fectrlinfo.dt,fectrlinfo.ctan,
+                                 _appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._elmtSystem,_appctx._mateSystem,
+                                 _appctx._solutionSystem,
+                                 _appctx._equationSystem._AMATRIX,_appctx._equationSystem._RHS);
+
+    // the arc-length may need more steps than the load control around the limit points
+    const int MaxSteps=100*_nLoadSteps;
+    const int OptIters=5;// the increment grows if the step converges within OptIters iterations
+    double lambda=0.0,dlambda=1.0/_nLoadSteps,dlam,dl=0.0;
+    int step=0,ncutbacks=0;
+    bool IsConverged,IsSuccess=true;
+    char buff[70];
+
+    outputSystem.WritePVDFileHeader();
+    while(lambda<1.0-1.0e-12){
+        if(step>=MaxSteps){
+            snprintf(buff,70,"  load stepping stops at lambda=%12.5e after %d steps",lambda,step);
+            MessagePrinter::PrintWarningTxt(string(buff));
+            IsSuccess=false;
+            break;
+        }
+        if(_UseArcLength&&dl>0.0){
+            IsConverged=SolveArcLengthStep(lambda,dl,Un,dUprev,dlam);
+            if(IsConverged&&lambda+dlam>1.0){
+                // the last step goes to lambda=1 by the load control
+                dlam=1.0-lambda;
+                IsConverged=SolveLoadControlStep(lambda,dlam,Un);
+            }
+        }
+        else{
+            // the first arc-length step is the load control one, it gives the arc length
+            dlam=(dlambda<1.0-lambda)?dlambda:1.0-lambda;
+            IsConverged=SolveLoadControlStep(lambda,dlam,Un);
+        }
+
+        if(IsConverged){
+            step+=1;ncutbacks=0;
+            lambda+=dlam;
+            VecWAXPY(dUprev,-1.0,Un,U);
+            VecCopy(U,Un);
+            if(_UseArcLength&&dl<=0.0) VecNorm(dUprev,NORM_2,&dl);
+
+            snprintf(buff,70,"Load step=%8d, lambda=%13.5e, dlambda=%13.5e",step,lambda,dlam);
+            MessagePrinter::PrintNormalTxt(string(buff));
+            if(!_monctx.IsDepDebug){
+                snprintf(buff,70,"  nonlinear solver: iters=%3d,|R0|=%12.5e,|R|=%12.5e",_LoadStepIters,_monctx.rnorm0,_monctx.rnorm);
+                MessagePrinter::PrintNormalTxt(string(buff));
+            }
+
+            // the converged step is the old state of the next one
+            _appctx._bcSystem.SetLoadFactor(lambda);
+            if(fectrlinfo.IsProjection){
+                _appctx._feSystem.FormBulkFE(FECalcType::Projection,fectrlinfo.t,fectrlinfo.dt,fectrlinfo.ctan,
+                                             _appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._elmtSystem,_appctx._mateSystem,
+                                             _appctx._solutionSystem,
+                                             _appctx._equationSystem._AMATRIX,_appctx._equationSystem._RHS);
+            }
+            if(step%outputSystem.GetIntervalNum()==0){
+                outputSystem.WriteResultToFile(step,_appctx._mesh,_appctx._dofHandler,_appctx._solutionSystem);
+                outputSystem.WriteResultToPVDFile(lambda,outputSystem.GetOutputFileName());
+                MessagePrinter::PrintNormalTxt("Write result to "+outputSystem.GetOutputFileName());
+                MessagePrinter::PrintDashLine();
+            }
+            if(step%postprocessSystem.GetOutputIntervalNum()==0){
+                postprocessSystem.RunPostprocess(lambda,_appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._solutionSystem);
+            }
+            _appctx._feSystem.FormBulkFE(FECalcType::UpdateHistoryVariable,fectrlinfo.t,fectrlinfo.dt,fectrlinfo.ctan,
+                                         _appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._elmtSystem,_appctx._mateSystem,
+                                         _appctx._solutionSystem,
+                                         _appctx._equationSystem._AMATRIX,_appctx._equationSystem._RHS);
+            _appctx._feSystem.PrintActiveSetSummary();
+
+            if(_LoadStepIters<=OptIters){
+                dlambda*=1.5;dl*=1.5;
+            }
+        }
+        else{
+            ncutbacks+=1;
+            if(ncutbacks>_MaxCutbacks){
+                snprintf(buff,70,"  load step is failed after %d cutbacks at lambda=%12.5e",_MaxCutbacks,lambda);
+                MessagePrinter::PrintWarningTxt(string(buff));
+                IsSuccess=false;
+                break;
+            }
+            dlambda*=0.5;dl*=0.5;
+            snprintf(buff,70,"  load step is failed, cut back to dlambda=%12.5e",dlambda);
+            if(_UseArcLength&&dl>0.0) snprintf(buff,70,"  arc-length step is failed, cut back to dl=%12.5e",dl);
+            MessagePrinter::PrintNormalTxt(string(buff));
+            VecCopy(Un,U);
+        }
+    }
+    outputSystem.WritePVDFileEnd();
+
+    _appctx._bcSystem.SetLoadFactor(1.0);
+    VecDestroy(&Un);
+    VecDestroy(&dUprev);
+    VecDestroy(&_LoadG);
+    for(int i=0;i<6;i++) VecDestroy(&_LoadWork[i]);
+
+    return IsSuccess;
+}
@@ -55,8 +55,8 @@ double Postprocess::ElementalIntegralPostProcess(vector<string> domainnamelist,s
                                               +to_string(nDim)+", they are not match");
                 MessagePrinter::AsFem_Exit();
             }
-            nNodesPerElmt=mesh.GetBulkMeshNodesNumPerElmtViaPhysicalName(domainname);
             ee=mesh.GetBulkMeshIthElmtIDViaPhyName(domainname,e);
+            nNodesPerElmt=mesh.GetBulkMeshIthElmtNodesNum(ee);
             // get the dof value for each nodal point
             for(i=1;i<=nNodesPerElmt;++i){
                 j=mesh.GetBulkMeshIthElmtJthNodeID(ee,i);
@@ -71,24 +71,27 @@ double Postprocess::ElementalIntegralPostProcess(vector<string> domainnamelist,s
             else{
                 // for 1D line
                 mesh.GetBulkMeshIthElmtNodes(ee,elNodes);
-                for(gpInd=1;gpInd<=fe._BulkQPoint.GetQpPointsNum();++gpInd){
-                    xi=fe._BulkQPoint(gpInd,1);
+                // the mixed mesh may have different element types in one domain
+                ShapeFun &shp=fe.GetBulkShp(fe.GetBulkMeshTypeIndex(mesh.GetBulkMeshIthElmtMeshType(ee)));
+                QPoint &qpoint=fe.GetBulkQPoint(1,fe.GetBulkMeshTypeIndex(mesh.GetBulkMeshIthElmtMeshType(ee)));
+                for(gpInd=1;gpInd<=qpoint.GetQpPointsNum();++gpInd){
+                    xi=qpoint(gpInd,1);
                     if(nDim==1){
-                        fe._BulkShp.Calc(xi,elNodes,true);
+                        shp.Calc(xi,elNodes,true);
                     }
                     else if(nDim==2){
-                        eta=fe._BulkQPoint(gpInd,2);
-                        fe._BulkShp.Calc(xi,eta,elNodes,true);
+                        eta=qpoint(gpInd,2);
+                        shp.Calc(xi,eta,elNodes,true);
                     }
                     else if(nDim==3){
-                        eta=fe._BulkQPoint(gpInd,2);
-                        zeta=fe._BulkQPoint(gpInd,3);
-                        fe._BulkShp.Calc(xi,eta,zeta,elNodes,true);
+                        eta=qpoint(gpInd,2);
+                        zeta=qpoint(gpInd,3);
+                        shp.Calc(xi,eta,zeta,elNodes,true);
                     }
-                    JxW=fe._BulkShp.GetDetJac()*fe._BulkQPoint(gpInd,0);
+                    JxW=shp.GetDetJac()*qpoint(gpInd,0);
                     // now we can do the gauss point integration
                     for(i=1;i<=nNodesPerElmt;++i){
-                        value+=fe._BulkShp.shape_value(i)*elU[i-1]*JxW;
+                        value+=shp.shape_value(i)*elU[i-1]*JxW;
                     }
                 }
             }
@@ -39,8 +39,8 @@ double Postprocess::VolumePostProcess(vector<string> domainnamelist,const Mesh &
                                               +to_string(nDim)+", they are not match");
                 MessagePrinter::AsFem_Exit();
             }
-            nNodesPerElmt=mesh.GetBulkMeshNodesNumPerElmtViaPhysicalName(domainname);
             ee=mesh.GetBulkMeshIthElmtIDViaPhyName(domainname,e);
+            nNodesPerElmt=mesh.GetBulkMeshIthElmtNodesNum(ee);
             if(nDim==0){
                 MessagePrinter::PrintErrorTxt("you can not get the 'volume' of a point, the dimension for volume postprocess must be 1, 2 or 3");
                 MessagePrinter::AsFem_Exit();
@@ -48,23 +48,26 @@ double Postprocess::VolumePostProcess(vector<string> domainnamelist,const Mesh &
             else{
                 // for 1D line
                 mesh.GetBulkMeshIthElmtNodes(ee,elNodes);
-                for(gpInd=1;gpInd<=fe._BulkQPoint.GetQpPointsNum();++gpInd){
-                    xi=fe._BulkQPoint(gpInd,1);
+                // the mixed mesh may have different element types in one domain
+                ShapeFun &shp=fe.GetBulkShp(fe.GetBulkMeshTypeIndex(mesh.GetBulkMeshIthElmtMeshType(ee)));
+                QPoint &qpoint=fe.GetBulkQPoint(1,fe.GetBulkMeshTypeIndex(mesh.GetBulkMeshIthElmtMeshType(ee)));
+                for(gpInd=1;gpInd<=qpoint.GetQpPointsNum();++gpInd){
+                    xi=qpoint(gpInd,1);
                     if(nDim==1){
-                        fe._BulkShp.Calc(xi,elNodes,true);
+                        shp.Calc(xi,elNodes,true);
                     }
                     else if(nDim==2){
-                        eta=fe._BulkQPoint(gpInd,2);
-                        fe._BulkShp.Calc(xi,eta,elNodes,true);
+                        eta=qpoint(gpInd,2);
+                        shp.Calc(xi,eta,elNodes,true);
                     }
                     else if(nDim==3){
-                        eta=fe._BulkQPoint(gpInd,2);
-                        zeta=fe._BulkQPoint(gpInd,3);
-                        fe._BulkShp.Calc(xi,eta,zeta,elNodes,true);
+                        eta=qpoint(gpInd,2);
+                        zeta=qpoint(gpInd,3);
+                        shp.Calc(xi,eta,zeta,elNodes,true);
                     }
-                    JxW=fe._BulkShp.GetDetJac()*fe._BulkQPoint(gpInd,0);
+                    JxW=shp.GetDetJac()*qpoint(gpInd,0);
                     for(i=1;i<=nNodesPerElmt;++i){
-                        volume+=fe._BulkShp.shape_value(i)*1.0*JxW;
+                        volume+=shp.shape_value(i)*1.0*JxW;
                     }
                 }
             }
@@ -94,6 +94,7 @@ PetscErrorCode MyTSMonitor(TS ts,PetscInt step,PetscReal time,Vec U,void *ctx){
     user->_feSystem.FormBulkFE(FECalcType::UpdateHistoryVariable,time,dt,user->_fectrlinfo.ctan,
                                user->_mesh,user->_dofHandler,user->_fe,user->_elmtSystem,user->_mateSystem,
                                user->_solutionSystem,user->_equationSystem._AMATRIX,user->_equationSystem._RHS);
+    user->_feSystem.PrintActiveSetSummary();
 
     if(user->IsAdaptive&&step>=1){
         if(user->iters<=user->OptiIters){
@@ -112,53 +113,94 @@ PetscErrorCode MyTSMonitor(TS ts,PetscInt step,PetscReal time,Vec U,void *ctx){
 //***************************************************************
 //*** for our Residual and Jacobian calculation
 //***************************************************************
-PetscErrorCode ComputeIResidual(TS ts,PetscReal t,Vec U,Vec V,Vec RHS,void *ctx){
-    TSAppCtx *user=(TSAppCtx*)ctx;
+// the residual of the first(Uddot=NULL) and the second order system, the mass part is added before the bc
+static PetscErrorCode FormTSResidual(TS ts,PetscReal t,Vec U,Vec V,Vec Uddot,Vec RHS,TSAppCtx *user){
+    SNES snes;
+    PetscInt lag;
+    FECalcType calctype=FECalcType::ComputeResidual;
 
     TSGetTimeStep(ts,&user->dt);
+    // the jacobian is assembled together with the residual, unless it is lagged. The shift(ctan[1]) is
+    // the one of the last jacobian, if it is changed, the fused one is not used by the jacobian
+    TSGetSNES(ts,&snes);
+    SNESGetLagJacobian(snes,&lag);
+    // the cached linear jacobian(IMEX) must not be overwritten by the fused one
+    if(user->_feSystem.IsFusedAssemblyEnabled()&&lag==1&&!user->IsLinearImplicit){
+        calctype=FECalcType::ComputeResidualAndJacobian;
+        user->_feSystem.ResetMaxAMatrixValue();
+    }
     // apply the initial dirichlet boundary condition
     user->_bcSystem.ApplyInitialBC(user->_mesh,user->_dofHandler,t,U);
 
     VecCopy(U,user->_solutionSystem._Unew);
     VecCopy(V,user->_solutionSystem._V);
 
-    user->_feSystem.FormBulkFE(FECalcType::ComputeResidual,
+    user->_feSystem.FormBulkFE(calctype,
                         t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
                         user->_mesh,user->_dofHandler,user->_fe,
                         user->_elmtSystem,user->_mateSystem,
                         user->_solutionSystem,
                         user->_equationSystem._AMATRIX,RHS);
+    if(Uddot!=NULL) user->_feSystem.AddMassResidual(Uddot,RHS);
     
     user->_bcSystem.SetBCPenaltyFactor(user->_feSystem.GetMaxAMatrixValue()*1.0e8);
 
     user->_bcSystem.ApplyBC(user->_mesh,user->_dofHandler,user->_fe,
                     FECalcType::ComputeResidual,t,user->_fectrlinfo.ctan,U,
                     user->_equationSystem._AMATRIX,RHS);
+
+    // the materials(and the fused jacobian) of this iterate can be reused by the jacobian
+    user->_feSystem.StampResidualIterate(U,V,t,user->_fectrlinfo.dt,user->_solutionSystem);
     
     return 0;
 }
+PetscErrorCode ComputeIResidual(TS ts,PetscReal t,Vec U,Vec V,Vec RHS,void *ctx){
+    return FormTSResidual(ts,t,U,V,NULL,RHS,(TSAppCtx*)ctx);
+}
+PetscErrorCode ComputeI2Residual(TS ts,PetscReal t,Vec U,Vec V,Vec A,Vec RHS,void *ctx){
+    return FormTSResidual(ts,t,U,V,A,RHS,(TSAppCtx*)ctx);
+}
 //******************************************************
-PetscErrorCode ComputeIJacobian(TS ts,PetscReal t,Vec U,Vec V,PetscReal s,Mat A,Mat B,void *ctx){
-    TSAppCtx *user=(TSAppCtx*)ctx;
-    int i;
-
+// the jacobian of the first(shiftA=0) and the second order system, the mass part is the cached one
+static PetscErrorCode FormTSJacobian(TS ts,PetscReal t,Vec U,Vec V,PetscReal shiftV,PetscReal shiftA,Mat A,TSAppCtx *user){
     TSGetTimeStep(ts,&user->_fectrlinfo.dt);
     TSGetTimeStep(ts,&user->dt);
-    user->_feSystem.ResetMaxAMatrixValue();// we reset the penalty factor
+    user->_fectrlinfo.ctan[0]=1.0;
+    user->_fectrlinfo.ctan[1]=shiftV;// dUdot/dU
+
+    // the linear implicit part(IMEX) only changes with the shift, if A is untouched, the
+    // factorization of the PC is kept as well, so each stage only needs one back substitution
+    if(user->IsLinearImplicit&&A==user->_equationSystem._AMATRIX&&shiftV==user->LinearShift){
+        return 0;
+    }
+
+    // check whether U and V are still the ones of the last residual, before U is modified
+    user->_feSystem.CheckResidualIterate(U,V,t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,user->_solutionSystem);
     user->_bcSystem.ApplyInitialBC(user->_mesh,user->_dofHandler,t,U);
 
     VecCopy(U,user->_solutionSystem._Unew);
     VecCopy(V,user->_solutionSystem._V);
 
-    user->_fectrlinfo.ctan[0]=1.0;
-    user->_fectrlinfo.ctan[1]=s;// dUdot/dU
-
-    user->_feSystem.FormBulkFE(FECalcType::ComputeJacobian,
-                        t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
-                        user->_mesh,user->_dofHandler,user->_fe,
-                        user->_elmtSystem,user->_mateSystem,
-                        user->_solutionSystem,
-                        A,user->_equationSystem._RHS);
+    if(user->_feSystem.IsFusedJacobianReusable()&&A==user->_equationSystem._AMATRIX){
+        // the bulk part of A is already assembled by the last residual, only the bc is applied
+    }
+    else{
+        user->_feSystem.ResetMaxAMatrixValue();// we reset the penalty factor
+        user->_feSystem.FormBulkFE(FECalcType::ComputeJacobian,
+                            t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                            user->_mesh,user->_dofHandler,user->_fe,
+                            user->_elmtSystem,user->_mateSystem,
+                            user->_solutionSystem,
+                            A,user->_equationSystem._RHS);
+    }
+    // the 'jacobian=fd' blocks are not in the analytic part above
+    if(user->_feSystem.HasFDJacobian()){
+        user->_feSystem.FormFDJacobian(t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                            user->_mesh,user->_dofHandler,user->_fe,
+                            user->_elmtSystem,user->_mateSystem,
+                            user->_solutionSystem,A);
+    }
+    if(shiftA!=0.0) user->_feSystem.AddMassJacobian(shiftA,A);
     
     if(user->_feSystem.GetMaxAMatrixValue()>1.0e12){
         user->_bcSystem.SetBCPenaltyFactor(1.0e20);
@@ -176,8 +218,38 @@ PetscErrorCode ComputeIJacobian(TS ts,PetscReal t,Vec U,Vec V,PetscReal s,Mat A,
     user->_bcSystem.ApplyBC(user->_mesh,user->_dofHandler,user->_fe,
                     FECalcType::ComputeJacobian,t,user->_fectrlinfo.ctan,U,
                     A,user->_equationSystem._RHS);
+    if(user->IsLinearImplicit) user->LinearShift=shiftV;
 
+    return 0;
+}
+PetscErrorCode ComputeIJacobian(TS ts,PetscReal t,Vec U,Vec V,PetscReal s,Mat A,Mat B,void *ctx){
+    int i;
     MatGetSize(B,&i,&i);
+    return FormTSJacobian(ts,t,U,V,s,0.0,A,(TSAppCtx*)ctx);
+}
+// the acceleration is not needed, the mass part only depends on shiftA
+PetscErrorCode ComputeI2Jacobian(TS ts,PetscReal t,Vec U,Vec V,Vec /*A*/,PetscReal shiftV,PetscReal shiftA,Mat J,Mat /*P*/,void *ctx){
+    return FormTSJacobian(ts,t,U,V,shiftV,shiftA,J,(TSAppCtx*)ctx);
+}
+//******************************************************
+PetscErrorCode ComputeExplicitRHS(TS ts,PetscReal t,Vec U,Vec RHS,void *ctx){
+    TSAppCtx *user=(TSAppCtx*)ctx;
+
+    // the rhs function may be called before any jacobian of the step, so dt(adaptive) and ctan are set here
+    TSGetTimeStep(ts,&user->dt);
+    user->_fectrlinfo.t=t;
+    user->_fectrlinfo.dt=user->dt;
+    user->_fectrlinfo.ctan[0]=1.0;
+    user->_fectrlinfo.ctan[1]=1.0/user->dt;
+    VecCopy(U,user->_solutionSystem._Unew);
+
+    user->_feSystem.FormExplicitResidual(t,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                        user->_mesh,user->_dofHandler,user->_fe,
+                        user->_elmtSystem,user->_mateSystem,
+                        user->_solutionSystem,
+                        user->_equationSystem._AMATRIX,RHS);
+    // the dirichlet dofs are only constrained by the implicit part
+    user->_bcSystem.ApplyDirichletBCToRHS(user->_mesh,user->_dofHandler,t,user->_solutionSystem._Unew,RHS);
 
     return 0;
 }
@@ -211,7 +283,9 @@ bool TimeStepping::Solve(Mesh &mesh,DofHandler &dofHandler,
                     _Adaptive,
                     _OptIters,
                     _GrowthFactor,_CutBackFactor,
-                    _DtMin,_DtMax
+                    _DtMin,_DtMax,
+                    //********************************
+                    false,-1.0
                    };
     
 
@@ -223,8 +297,50 @@ bool TimeStepping::Solve(Mesh &mesh,DofHandler &dofHandler,
                                  _appctx._solutionSystem,
                                  _appctx._equationSystem._AMATRIX,_appctx._equationSystem._RHS);
 
-    TSSetIFunction(_ts,_appctx._equationSystem._RHS,ComputeIResidual,&_appctx);
-    TSSetIJacobian(_ts,_appctx._equationSystem._AMATRIX,_appctx._equationSystem._AMATRIX,ComputeIJacobian,&_appctx);
+    if(IsMultirate()){
+        // the fast and the slow dofs have their own dt, so it is not driven by TSSolve
+        return SolveMultirate();
+    }
+
+    if(IsSecondOrder()){
+        // M*Uddot+R(U,Udot)=0 is solved directly, instead of the first order system with twice the unknowns
+        if(!_appctx._feSystem.HasMassMatrix()){
+            MessagePrinter::PrintErrorTxt("no mass matrix for the "+_TimeSteppingTypeName+" time stepping, 'density=' should be given in the [elmts] sub block");
+            MessagePrinter::AsFem_Exit();
+        }
+        _appctx._feSystem.FormBulkMass(_appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._equationSystem._AMATRIX);
+        TSSetI2Function(_ts,_appctx._equationSystem._RHS,ComputeI2Residual,&_appctx);
+        TSSetI2Jacobian(_ts,_appctx._equationSystem._AMATRIX,_appctx._equationSystem._AMATRIX,ComputeI2Jacobian,&_appctx);
+        // the initial velocity is zero
+        if(!_IsU2dotCreated){
+            VecDuplicate(_appctx._solutionSystem._Unew,&_U2dot);
+            _IsU2dotCreated=true;
+        }
+        VecSet(_U2dot,0.0);
+        TS2SetSolution(_ts,_appctx._solutionSystem._Unew,_U2dot);
+    }
+    else if(_TimeSteppingType==TimeSteppingType::ARKIMEX){
+        // the 'imex=explicit' blocks go to the rhs function, the others to the implicit function
+        _appctx._feSystem.SetIMEXOption(true);
+        if(_appctx._feSystem.HasExplicitPart()){
+            TSSetRHSFunction(_ts,NULL,ComputeExplicitRHS,&_appctx);
+        }
+        else{
+            MessagePrinter::PrintWarningTxt("no 'imex=explicit' block is found, all the blocks are implicit in arkimex");
+        }
+        if(_appctx._feSystem.IsImplicitPartLinear()){
+            // one linear solve for each stage, the jacobian is only assembled when dt is changed
+            _appctx.IsLinearImplicit=true;
+            SNESSetType(_snes,SNESKSPONLY);
+            MessagePrinter::PrintNormalTxt("the implicit part is linear, its jacobian is reused for the same dt");
+        }
+        TSSetIFunction(_ts,_appctx._equationSystem._RHS,ComputeIResidual,&_appctx);
+        TSSetIJacobian(_ts,_appctx._equationSystem._AMATRIX,_appctx._equationSystem._AMATRIX,ComputeIJacobian,&_appctx);
+    }
+    else{
+        TSSetIFunction(_ts,_appctx._equationSystem._RHS,ComputeIResidual,&_appctx);
+        TSSetIJacobian(_ts,_appctx._equationSystem._AMATRIX,_appctx._equationSystem._AMATRIX,ComputeIJacobian,&_appctx);
+    }
     
     TSMonitorSet(_ts,MyTSMonitor,&_appctx,NULL);
     SNESMonitorSet(_snes,MySNESMonitor,&_appctx,0);
@@ -0,0 +1,317 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: the multirate time stepping, the dofs of 'slowdofs='
+//+++          are stepped with DT=dt*subcycles, the others with dt.
+//+++          For each macro step [tn,tn+DT]:
+//+++            1) the slow dofs are solved once with DT, the fast
+//+++               ones are frozen at tn
+//+++            2) the fast dofs are subcycled with dt, the slow ones
+//+++               are frozen at the linear interpolation between
+//+++               tn and tn+DT, so the coupling terms of the fast
+//+++               substeps see the slow field of the same time
+//+++          both of them use the backward euler, each sub step only
+//+++          assembles the kernels of its own dofs and solves them by
+//+++          the sub matrix of the jacobian, the frozen dofs are kept
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "TimeStepping/TimeStepping.h"
+
+//***************************************************************
+//*** the backward euler residual and jacobian of one sub step, U and
+//*** RHS only contain the active dofs(_ActiveDofsIS), the frozen ones
+//*** are taken from Unew
+//***************************************************************
+PetscErrorCode TimeStepping::ComputeMultirateResidual(SNES /*snes*/,Vec U,Vec RHS,void *ctx){
+    TimeStepping *tstepping=(TimeStepping*)ctx;
+    TSAppCtx *user=&tstepping->_appctx;
+    Vec &Unew=user->_solutionSystem._Unew;
+
+    VecISCopy(Unew,tstepping->_ActiveDofsIS,SCATTER_FORWARD,U);
+    user->_bcSystem.ApplyInitialBC(user->_mesh,user->_dofHandler,tstepping->_MRTime,Unew);
+    VecISCopy(Unew,tstepping->_ActiveDofsIS,SCATTER_REVERSE,U);
+
+    // V=(U-Uold)/dt, for the frozen dofs it is the rate of their own(slow or fast) field
+    VecWAXPY(user->_solutionSystem._V,-1.0,user->_solutionSystem._Uold,Unew);
+    VecScale(user->_solutionSystem._V,1.0/tstepping->_MRDt);
+
+    user->_feSystem.FormBulkFE(FECalcType::ComputeResidual,
+                        tstepping->_MRTime,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                        user->_mesh,user->_dofHandler,user->_fe,
+                        user->_elmtSystem,user->_mateSystem,
+                        user->_solutionSystem,
+                        user->_equationSystem._AMATRIX,user->_equationSystem._RHS);
+
+    user->_bcSystem.SetBCPenaltyFactor(user->_feSystem.GetMaxAMatrixValue()*1.0e8);
+
+    user->_bcSystem.ApplyBC(user->_mesh,user->_dofHandler,user->_fe,
+                    FECalcType::ComputeResidual,tstepping->_MRTime,user->_fectrlinfo.ctan,Unew,
+                    user->_equationSystem._AMATRIX,user->_equationSystem._RHS);
+    VecISCopy(user->_equationSystem._RHS,tstepping->_ActiveDofsIS,SCATTER_REVERSE,RHS);
+
+    user->_feSystem.StampResidualIterate(Unew,user->_solutionSystem._V,tstepping->_MRTime,user->_fectrlinfo.dt,user->_solutionSystem);
+
+    return 0;
+}
+//******************************************************
+PetscErrorCode TimeStepping::ComputeMultirateJacobian(SNES /*snes*/,Vec U,Mat A,Mat /*B*/,void *ctx){
+    TimeStepping *tstepping=(TimeStepping*)ctx;
+    TSAppCtx *user=&tstepping->_appctx;
+    Vec &Unew=user->_solutionSystem._Unew;
+
+    user->_fectrlinfo.ctan[0]=1.0;
+    user->_fectrlinfo.ctan[1]=1.0/tstepping->_MRDt;
+
+    VecISCopy(Unew,tstepping->_ActiveDofsIS,SCATTER_FORWARD,U);
+    VecWAXPY(user->_solutionSystem._V,-1.0,user->_solutionSystem._Uold,Unew);
+    VecScale(user->_solutionSystem._V,1.0/tstepping->_MRDt);
+    user->_feSystem.CheckResidualIterate(Unew,user->_solutionSystem._V,tstepping->_MRTime,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,user->_solutionSystem);
+    user->_bcSystem.ApplyInitialBC(user->_mesh,user->_dofHandler,tstepping->_MRTime,Unew);
+
+    // the full jacobian only gets the kernels of the active dofs, its active block is given to the solver
+    user->_feSystem.ResetMaxAMatrixValue();
+    user->_feSystem.FormBulkFE(FECalcType::ComputeJacobian,
+                        tstepping->_MRTime,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                        user->_mesh,user->_dofHandler,user->_fe,
+                        user->_elmtSystem,user->_mateSystem,
+                        user->_solutionSystem,
+                        user->_equationSystem._AMATRIX,user->_equationSystem._RHS);
+    if(user->_feSystem.HasFDJacobian()){
+        user->_feSystem.FormFDJacobian(tstepping->_MRTime,user->_fectrlinfo.dt,user->_fectrlinfo.ctan,
+                            user->_mesh,user->_dofHandler,user->_fe,
+                            user->_elmtSystem,user->_mateSystem,
+                            user->_solutionSystem,user->_equationSystem._AMATRIX);
+    }
+
+    if(user->_feSystem.GetMaxAMatrixValue()>1.0e12){
+        user->_bcSystem.SetBCPenaltyFactor(1.0e20);
+    }
+    else if(user->_feSystem.GetMaxAMatrixValue()>1.0e6&&user->_feSystem.GetMaxAMatrixValue()<=1.0e12){
+        user->_bcSystem.SetBCPenaltyFactor(user->_feSystem.GetMaxAMatrixValue()*1.0e8);
+    }
+    else if(user->_feSystem.GetMaxAMatrixValue()>1.0e3&&user->_feSystem.GetMaxAMatrixValue()<=1.0e6){
+        user->_bcSystem.SetBCPenaltyFactor(user->_feSystem.GetMaxAMatrixValue()*1.0e12);
+    }
+    else{
+        user->_bcSystem.SetBCPenaltyFactor(user->_feSystem.GetMaxAMatrixValue()*1.0e16);
+    }
+
+    user->_bcSystem.ApplyBC(user->_mesh,user->_dofHandler,user->_fe,
+                    FECalcType::ComputeJacobian,tstepping->_MRTime,user->_fectrlinfo.ctan,Unew,
+                    user->_equationSystem._AMATRIX,user->_equationSystem._RHS);
+    MatCreateSubMatrix(user->_equationSystem._AMATRIX,tstepping->_ActiveDofsIS,tstepping->_ActiveDofsIS,MAT_REUSE_MATRIX,&A);
+
+    return 0;
+}
+//***************************************************************
+//*** solve one sub step of the dofs group(0 for the slow dofs, 1 for
+//*** the fast ones) from Uold, the other group keeps the values of Unew
+//***************************************************************
+bool TimeStepping::SolveMultirateSubStep(const double &t,const double &dt,const int &group){
+    SolutionSystem &solutionSystem=_appctx._solutionSystem;
+    _MRTime=t;_MRDt=dt;
+    _ActiveDofsIS=(group==0)?_SlowDofsIS:_FastDofsIS;
+    _appctx.dt=dt;
+    _appctx._fectrlinfo.t=t;
+    _appctx._fectrlinfo.dt=dt;
+    _appctx._fectrlinfo.ctan[0]=1.0;
+    _appctx._fectrlinfo.ctan[1]=1.0/dt;
+
+    _appctx._feSystem.SetFrozenDofs(_IsFrozenDof[group]);
+    VecISCopy(solutionSystem._Unew,_ActiveDofsIS,SCATTER_REVERSE,_MRU[group]);
+    SNESSolve(_MRSnes[group],NULL,_MRU[group]);
+    SNESGetConvergedReason(_MRSnes[group],&_snesreason);
+    VecISCopy(solutionSystem._Unew,_ActiveDofsIS,SCATTER_FORWARD,_MRU[group]);
+
+    VecWAXPY(solutionSystem._V,-1.0,solutionSystem._Uold,solutionSystem._Unew);
+    VecScale(solutionSystem._V,1.0/dt);
+    return _snesreason>0;
+}
+//***************************************************************
+void TimeStepping::MultirateMonitor(const int &step,const double &time,const double &dt){
+    char buff[68];
+    snprintf(buff,68,"Time step=%8d, time=%13.5e, dt=%13.5e",step,time,dt);
+    MessagePrinter::PrintNormalTxt(string(buff));
+    if(!_appctx.IsDepDebug){
+        snprintf(buff,68,"  SNES solver: iters=%3d,|R0|=%12.5e,|R|=%12.5e",_appctx.iters+1,_appctx.rnorm0,_appctx.rnorm);
+        MessagePrinter::PrintNormalTxt(string(buff));
+    }
+
+    if(_appctx._fectrlinfo.IsProjection){
+        _appctx._feSystem.FormBulkFE(FECalcType::Projection,time,dt,_appctx._fectrlinfo.ctan,
+                                   _appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._elmtSystem,_appctx._mateSystem,
+                                   _appctx._solutionSystem,_appctx._equationSystem._AMATRIX,_appctx._equationSystem._RHS);
+    }
+    if(step%_appctx._outputSystem.GetIntervalNum()==0){
+        _appctx._outputSystem.WriteResultToFile(step,_appctx._mesh,_appctx._dofHandler,_appctx._solutionSystem);
+        _appctx._outputSystem.WriteResultToPVDFile(time,_appctx._outputSystem.GetOutputFileName());
+        MessagePrinter::PrintNormalTxt("Write result to "+_appctx._outputSystem.GetOutputFileName());
+        MessagePrinter::PrintDashLine();
+    }
+    if(step%_appctx._postprocess.GetOutputIntervalNum()==0){
+        _appctx._postprocess.RunPostprocess(time,_appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._solutionSystem);
+    }
+}
+//***************************************************************
+bool TimeStepping::SolveMultirate(){
+    SolutionSystem &solutionSystem=_appctx._solutionSystem;
+    const DofHandler &dofHandler=_appctx._dofHandler;
+    char buff[70];
+
+    if(_TimeSteppingType!=TimeSteppingType::BACKWARDEULER||_Adaptive){
+        MessagePrinter::PrintWarningTxt("the multirate time stepping always uses the backward euler with the fixed dt, the 'type=' and 'adaptive=' options are ignored");
+    }
+
+    //***************************************************
+    //*** split the local dofs into the slow and the fast ones
+    //***************************************************
+    vector<bool> IsSlowDof(dofHandler.GetDofsNumPerNode(),false);
+    for(const auto &dofname:_SlowDofNameList){
+        if(!dofHandler.IsValidDofName(dofname)){
+            MessagePrinter::PrintErrorTxt("'"+dofname+"' in 'slowdofs=' is not a valid dof name, please check your [dofs] block");
+            MessagePrinter::AsFem_Exit();
+        }
+        IsSlowDof[dofHandler.GetDofIDviaDofName(dofname)-1]=true;
+    }
+    PetscInt iStart,iEnd,iDof;
+    vector<PetscInt> SlowDofs,FastDofs;
+    if(find(IsSlowDof.begin(),IsSlowDof.end(),false)==IsSlowDof.end()){
+        MessagePrinter::PrintErrorTxt("all the dofs are in 'slowdofs=', the multirate time stepping needs at least one fast dof");
+        MessagePrinter::AsFem_Exit();
+    }
+    VecGetOwnershipRange(solutionSystem._Unew,&iStart,&iEnd);
+    for(int i=1;i<=_appctx._mesh.GetBulkMeshNodesNum();i++){
+        for(int j=1;j<=dofHandler.GetDofsNumPerNode();j++){
+            iDof=dofHandler.GetIthNodeJthDofIndex(i,j)-1;
+            if(iDof<iStart||iDof>=iEnd) continue;
+            if(IsSlowDof[j-1]){
+                SlowDofs.push_back(iDof);
+            }
+            else{
+                FastDofs.push_back(iDof);
+            }
+        }
+    }
+    ISCreateGeneral(PETSC_COMM_WORLD,static_cast<PetscInt>(SlowDofs.size()),SlowDofs.data(),PETSC_COPY_VALUES,&_SlowDofsIS);
+    ISCreateGeneral(PETSC_COMM_WORLD,static_cast<PetscInt>(FastDofs.size()),FastDofs.data(),PETSC_COPY_VALUES,&_FastDofsIS);
+
+    // Un: the start of the macro step, Us: the slow solution at its end, dUs=Us-Un
+    Vec Un,dUs,SlowMask;
+    VecDuplicate(solutionSystem._Unew,&Un);
+    VecDuplicate(solutionSystem._Unew,&dUs);
+    VecDuplicate(solutionSystem._Unew,&SlowMask);
+    VecSet(SlowMask,0.0);
+    VecISSet(SlowMask,_SlowDofsIS,1.0);
+
+    // the slow sub step freezes the fast dofs, and the fast one freezes the slow dofs
+    _IsFrozenDof[0].resize(IsSlowDof.size());
+    _IsFrozenDof[1].resize(IsSlowDof.size());
+    for(int j=0;j<static_cast<int>(IsSlowDof.size());j++){
+        _IsFrozenDof[0][j]=!IsSlowDof[j];
+        _IsFrozenDof[1][j]=IsSlowDof[j];
+    }
+
+    // one solver for each group, its jacobian is the sub matrix of AMATRIX on the dofs of the group
+    KSP ksp;
+    PC pc;
+    for(int group=0;group<2;group++){
+        IS &dofsIS=(group==0)?_SlowDofsIS:_FastDofsIS;
+        MatCreateSubMatrix(_appctx._equationSystem._AMATRIX,dofsIS,dofsIS,MAT_INITIAL_MATRIX,&_MRA[group]);
+        MatCreateVecs(_MRA[group],&_MRU[group],&_MRF[group]);
+        SNESCreate(PETSC_COMM_WORLD,&_MRSnes[group]);
+        SetSNESOptions(_MRSnes[group],ksp,pc);
+        SNESSetFunction(_MRSnes[group],_MRF[group],ComputeMultirateResidual,this);
+        SNESSetJacobian(_MRSnes[group],_MRA[group],_MRA[group],ComputeMultirateJacobian,this);
+        SNESMonitorSet(_MRSnes[group],MySNESMonitor,&_appctx,0);
+        SNESSetForceIteration(_MRSnes[group],PETSC_TRUE);
+        SNESSetFromOptions(_MRSnes[group]);
+    }
+
+    //***************************************************
+    //*** the macro steps
+    //***************************************************
+    const double dt=_Dt;
+    const int m=_nSubcycles;
+    const double tol=1.0e-12*dt;
+    double t=0.0,DT,h;
+    int step=0,k;
+    bool IsConvergent=true;
+
+    _appctx._outputSystem.WritePVDFileHeader();
+    VecCopy(solutionSystem._Unew,solutionSystem._Uold);
+    VecSet(solutionSystem._V,0.0);
+    VecSet(solutionSystem._Vold,0.0);
+    MultirateMonitor(step,t,dt);
+
+    while(t<_FinalT-tol){
+        DT=dt*m;
+        if(t+DT>_FinalT) DT=_FinalT-t;// the last macro step is shortened, so are its sub steps
+        h=DT/m;
+        VecCopy(solutionSystem._Unew,Un);
+
+        // 1) the slow dofs with DT, the fast ones are kept at tn
+        VecCopy(Un,solutionSystem._Uold);
+        if(!SolveMultirateSubStep(t+DT,DT,0)){
+            snprintf(buff,70,"the slow dofs failed to converge at time=%13.5e",t+DT);
+            MessagePrinter::PrintErrorTxt(string(buff));
+            IsConvergent=false;
+            break;
+        }
+        if(_appctx.IsDepDebug){
+            snprintf(buff,70,"  slow dofs: time=%13.5e, DT=%13.5e, iters=%3d",t+DT,DT,_appctx.iters+1);
+            MessagePrinter::PrintNormalTxt(string(buff));
+        }
+        VecWAXPY(dUs,-1.0,Un,solutionSystem._Unew);
+        VecPointwiseMult(dUs,dUs,SlowMask);
+
+        // 2) the fast dofs are subcycled, the slow ones are interpolated: Un+(k/m)*dUs
+        VecCopy(Un,solutionSystem._Unew);
+        VecCopy(Un,solutionSystem._Uold);
+        for(k=1;k<=m;k++){
+            VecAXPY(solutionSystem._Unew,1.0/m,dUs);
+            if(!SolveMultirateSubStep(t+k*h,h,1)){
+                snprintf(buff,70,"the fast dofs failed to converge at time=%13.5e",t+k*h);
+                MessagePrinter::PrintErrorTxt(string(buff));
+                IsConvergent=false;
+                break;
+            }
+            _appctx._feSystem.FormBulkFE(FECalcType::UpdateHistoryVariable,t+k*h,h,_appctx._fectrlinfo.ctan,
+                                         _appctx._mesh,_appctx._dofHandler,_appctx._fe,_appctx._elmtSystem,_appctx._mateSystem,
+                                         solutionSystem,_appctx._equationSystem._AMATRIX,_appctx._equationSystem._RHS);
+            VecCopy(solutionSystem._Unew,solutionSystem._Uold);
+            VecCopy(solutionSystem._V,solutionSystem._Vold);
+        }
+        if(!IsConvergent) break;
+
+        t+=DT;
+        step+=1;
+        _appctx.time=t;
+        _appctx.step=step;
+        MultirateMonitor(step,t,h);
+        _appctx._feSystem.PrintActiveSetSummary();
+    }
+    _appctx._outputSystem.WritePVDFileEnd();
+    _appctx._feSystem.ClearFrozenDofs();
+
+    VecDestroy(&Un);
+    VecDestroy(&dUs);
+    VecDestroy(&SlowMask);
+    for(int group=0;group<2;group++){
+        SNESDestroy(&_MRSnes[group]);
+        MatDestroy(&_MRA[group]);
+        VecDestroy(&_MRU[group]);
+        VecDestroy(&_MRF[group]);
+    }
+    ISDestroy(&_SlowDofsIS);
+    ISDestroy(&_FastDofsIS);
+
+    return IsConvergent;
+}
@@ -28,6 +28,11 @@ TimeStepping::TimeStepping(){
     _OptIters=3;
     _DtMax=1.0e2;
     _DtMin=1.0e-12;
+    _RhoInf=-1.0;
+    _IsU2dotCreated=false;
+    _SlowDofNameList.clear();
+    _nSubcycles=1;
+    _MRTime=0.0;_MRDt=1.0;
     //**********************************
     //*** for nonlinear solver
     //**********************************
@@ -55,6 +60,9 @@ void TimeStepping::SetOpitonsFromTimeSteppingBlock(TimeSteppingBlock &timeSteppi
     _GrowthFactor=timeSteppingBlock._GrowthFactor;
     _CutBackFactor=timeSteppingBlock._CutBackFactor;
     _OptIters=timeSteppingBlock._OptIters;
+    _RhoInf=timeSteppingBlock._RhoInf;
+    _SlowDofNameList=timeSteppingBlock._SlowDofNameList;
+    _nSubcycles=timeSteppingBlock._nSubcycles;
 }
 void TimeStepping::SetOptionsFromNonlinearSolverBlock(NonlinearSolverBlock &nonlinearsolverblock){
     _SolverType=nonlinearsolverblock._SolverType;
@@ -66,6 +74,9 @@ void TimeStepping::SetOptionsFromNonlinearSolverBlock(NonlinearSolverBlock &nonl
     _SolverType=nonlinearsolverblock._SolverType;
     _PCTypeName=nonlinearsolverblock._PCTypeName;
     _LinearSolverName=nonlinearsolverblock._LinearSolverName;
+    _UseNewtonNPC=nonlinearsolverblock._UseNewtonNPC;
+    _Depth=nonlinearsolverblock._Depth;
+    _Damping=nonlinearsolverblock._Damping;
 }
 //*******************************************************
 void TimeStepping::PrintTimeSteppingInfo()const{
@@ -91,9 +102,23 @@ void TimeStepping::PrintTimeSteppingInfo()const{
     snprintf(buff,20,"%14.5e",_DtMin);
     str+=", min delta T="+string(buff);
     MessagePrinter::PrintNormalTxt(str);
+    if(_TimeSteppingType==TimeSteppingType::ALPHA2&&_RhoInf>=0.0){
+        snprintf(buff,20,"%14.5e",_RhoInf);
+        MessagePrinter::PrintNormalTxt("  spectral radius(rhoinf)="+string(buff));
+    }
+    if(IsMultirate()){
+        str="  multirate: slow dofs=";
+        for(const auto &it:_SlowDofNameList) str+=it+" ";
+        str+=", subcycles="+to_string(_nSubcycles);
+        MessagePrinter::PrintNormalTxt(str);
+    }
     MessagePrinter::PrintDashLine();
 }
 //****************************************
 void TimeStepping::ReleaseMem(){
     TSDestroy(&_ts);
+    if(_IsU2dotCreated){
+        VecDestroy(&_U2dot);
+        _IsU2dotCreated=false;
+    }
 }
\ No newline at end of file
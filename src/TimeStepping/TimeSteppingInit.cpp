@@ -38,6 +38,20 @@ void TimeStepping::Init(){
     else if(_TimeSteppingType==TimeSteppingType::ROSW){
         TSSetType(_ts,TSROSW);
     }
+    else if(_TimeSteppingType==TimeSteppingType::ALPHA2){
+        TSSetType(_ts,TSALPHA2);
+        if(_RhoInf>=0.0) TSAlpha2SetRadius(_ts,_RhoInf);
+    }
+    else if(_TimeSteppingType==TimeSteppingType::NEWMARK){
+        // the average acceleration newmark scheme is the alpha2 one with alpha_m=alpha_f=1
+        TSSetType(_ts,TSALPHA2);
+        TSAlpha2SetParams(_ts,1.0,1.0,0.5,0.25);
+    }
+    else if(_TimeSteppingType==TimeSteppingType::ARKIMEX){
+        // the explicit part is given by TSSetRHSFunction, see TimeStepping::Solve
+        TSSetType(_ts,TSARKIMEX);
+        TSARKIMEXSetFullyImplicit(_ts,PETSC_FALSE);
+    }
     else{
         MessagePrinter::PrintErrorTxt("unsupported time stepping method");
         MessagePrinter::AsFem_Exit();
@@ -54,67 +68,75 @@ void TimeStepping::Init(){
     //*** for the nonlinear solver settings
     //***************************************************
     TSGetSNES(_ts,&_snes);
+    SetSNESOptions(_snes,_ksp,_pc);
+    TSSetMaxSNESFailures(_ts,-1);
+}
+//**************************************************
+//*** the ksp, pc and snes settings, they are shared by the TS solver
+//*** and the sub step solvers of the multirate stepping
+//**************************************************
+void TimeStepping::SetSNESOptions(SNES &snes,KSP &ksp,PC &pc){
     //**************************************************
     //*** init KSP
     //**************************************************
-    SNESGetKSP(_snes,&_ksp);
-    KSPGMRESSetRestart(_ksp,1400);
-    KSPGetPC(_ksp,&_pc);
-    PCFactorSetMatSolverType(_pc,MATSOLVERPETSC);
+    SNESGetKSP(snes,&ksp);
+    KSPGMRESSetRestart(ksp,1400);
+    KSPGetPC(ksp,&pc);
+    PCFactorSetMatSolverType(pc,MATSOLVERPETSC);
 
     if(_LinearSolverName=="mumps"){
-        PCSetType(_pc,PCLU);
-        KSPSetType(_ksp,KSPPREONLY);
-        PCFactorSetMatSolverType(_pc,MATSOLVERMUMPS);
+        PCSetType(pc,PCLU);
+        KSPSetType(ksp,KSPPREONLY);
+        PCFactorSetMatSolverType(pc,MATSOLVERMUMPS);
     }
     else if(_LinearSolverName=="superlu"){
-        PCSetType(_pc,PCLU);
-        KSPSetType(_ksp,KSPPREONLY);
-        PCFactorSetMatSolverType(_pc,MATSOLVERSUPERLU_DIST);
+        PCSetType(pc,PCLU);
+        KSPSetType(ksp,KSPPREONLY);
+        PCFactorSetMatSolverType(pc,MATSOLVERSUPERLU_DIST);
     }
     else{
-        PCSetType(_pc,PCLU);
+        PCSetType(pc,PCLU);
     }
 
-    PCFactorSetReuseOrdering(_pc,PETSC_TRUE);
+    PCFactorSetReuseOrdering(pc,PETSC_TRUE);
 
     //**************************************************
     //*** allow user setting ksp from command line
     //**************************************************
-    KSPSetFromOptions(_ksp);
+    KSPSetFromOptions(ksp);
 
     //**************************************************
     //*** some basic settings for SNES
     //**************************************************
-    SNESSetTolerances(_snes,_RAbsTol,_RRelTol,_STol,_MaxIters,-1);
-    SNESSetDivergenceTolerance(_snes,-1);
-    TSSetMaxSNESFailures(_ts,-1);
+    SNESSetTolerances(snes,_RAbsTol,_RRelTol,_STol,_MaxIters,-1);
+    SNESSetDivergenceTolerance(snes,-1);
 
     //**************************************************
     //*** for different type of nonlinear methods
     //**************************************************
-    SNESSetType(_snes,SNESNEWTONLS);// our default method
+    SNESSetType(snes,SNESNEWTONLS);// our default method
     if(_SolverType==NonlinearSolverType::NEWTON||_SolverType==NonlinearSolverType::NEWTONLS){
-        SNESSetType(_snes,SNESNEWTONLS);
+        SNESSetType(snes,SNESNEWTONLS);
     }
     else if(_SolverType==NonlinearSolverType::NEWTONTR){
-        SNESSetType(_snes,SNESNEWTONTR);
+        SNESSetType(snes,SNESNEWTONTR);
     }
     else if(_SolverType==NonlinearSolverType::BFGS){
-        SNESSetType(_snes,SNESQN);
+        SNESSetType(snes,SNESQN);
     }
     else if(_SolverType==NonlinearSolverType::BROYDEN){
-        SNESSetType(_snes,SNESQN);
-        SNESQNSetType(_snes,SNES_QN_BROYDEN);
+        SNESSetType(snes,SNESQN);
+        SNESQNSetType(snes,SNES_QN_BROYDEN);
     }
     else if(_SolverType==NonlinearSolverType::BADBROYDEN){
-        SNESSetType(_snes,SNESQN);
-        SNESQNSetType(_snes,SNES_QN_BADBROYDEN);
+        SNESSetType(snes,SNESQN);
+        SNESQNSetType(snes,SNES_QN_BADBROYDEN);
     }
     else if(_SolverType==NonlinearSolverType::NEWTONCG){
-        SNESSetType(_snes,SNESNCG);
+        SNESSetType(snes,SNESNCG);
     }
-    else if(_SolverType==NonlinearSolverType::NEWTONGMRES){
-        SNESSetType(_snes,SNESNGMRES);
+    else if(IsSNESMixingType(_SolverType)){
+        // anderson and ngmres, the newton step of the nonlinear preconditioner uses ksp
+        SetSNESMixingOptions(snes,ksp,_SolverType,_UseNewtonNPC,_Depth,_Damping,_RAbsTol,_RRelTol,_STol);
     }
 }
\ No newline at end of file
@@ -172,6 +172,48 @@ RankFourTensor operator*(const RankTwoTensor &lhs,const RankFourTensor &a){
     }
     return temp;
 }
+//**************************************************
+//*** for in-place fused operations
+//**************************************************
+RankFourTensor& RankFourTensor::AddScaledCrossDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b){
+    double sa;
+    for(int i=1;i<=_N;++i){
+        for(int j=1;j<=_N;++j){
+            sa=s*a(i,j);
+            if(sa==0.0) continue;
+            for(int k=1;k<=_N;++k){
+                for(int l=1;l<=_N;++l){
+                    (*this)(i,j,k,l)+=sa*b(k,l);
+                }
+            }
+        }
+    }
+    return *this;
+}
+RankFourTensor& RankFourTensor::AddScaledIkJlDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b){
+    for(int i=1;i<=_N;++i){
+        for(int j=1;j<=_N;++j){
+            for(int k=1;k<=_N;++k){
+                for(int l=1;l<=_N;++l){
+                    (*this)(i,j,k,l)+=s*a(i,k)*b(j,l);
+                }
+            }
+        }
+    }
+    return *this;
+}
+RankFourTensor& RankFourTensor::AddScaledIlJkDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b){
+    for(int i=1;i<=_N;++i){
+        for(int j=1;j<=_N;++j){
+            for(int k=1;k<=_N;++k){
+                for(int l=1;l<=_N;++l){
+                    (*this)(i,j,k,l)+=s*a(i,l)*b(j,k);
+                }
+            }
+        }
+    }
+    return *this;
+}
 // for double dot operator
 RankTwoTensor RankFourTensor::DoubleDot(const RankTwoTensor &a) const{
         // A_ijkl:B_lk = Cij
@@ -380,134 +380,143 @@ void RankTwoTensor::CalcEigenValueAndEigenVectors(double (&eigval)[3],RankTwoTen
     }
 }
 //***********************************************
-RankFourTensor RankTwoTensor::CalcPostiveProjTensor(double (&eigval)[3],RankTwoTensor &eigvec) const{
-    // remember, the eigen vec and eigen value should be used in your material
-    // code to calculate the stress and the related constitutive law
-
-    // Algorithm is taken from:
-    // C. Miehe and M. Lambrecht, Commun. Numer. Meth. Engng 2001; 17:337~353
-    // https://onlinelibrary.wiley.com/doi/epdf/10.1002/cnm.404
+void RankTwoTensor::CalcSymmetricEigenValueAndEigenVectors(double (&eigval)[3],RankTwoTensor &eigvec)const{
+    // cyclic Jacobi rotation for the symmetric 3x3 tensor, no complex arithmetic is
+    // involved and the eigen vectors are always orthonormal, even for the repeated roots
+    // the eigen values are sorted in ascending order, the i-th eigen vector is stored in
+    // the i-th column of eigvec
+    double a[3][3],v[3][3];
+    double off,scale,theta,t,c,s,apq,arp,arq,vrp,vrq;
+    int p,q,r;
+    const int MaxSweeps=50;
 
-    CalcEigenValueAndEigenVectors(eigval,eigvec);
-
-    // C=F^T F=lambda_i M_i where M_i=n_i x n_i
-    //         lambda_i-->eigenvalue  n_i--> the eigenvector
-
-    double epos[3],diag[3];
+    scale=0.0;
     for(int i=0;i<_N;++i){
-        epos[i]=0.5*(abs(eigval[i])+eigval[i]);
-        diag[i]=0.0;
-        if(eigval[i]>0.0){
-            diag[i]=1.0;
+        for(int j=0;j<_N;++j){
+            a[i][j]=0.5*((*this)(i+1,j+1)+(*this)(j+1,i+1));
+            v[i][j]=1.0*(i==j);
+            scale+=a[i][j]*a[i][j];
         }
     }
-    RankFourTensor ProjPos(0.0);
-    RankTwoTensor Ma(0.0),Mb(0.0);
 
-    ProjPos.SetToZeros();
-
-    // calculate Ma defined in Eq.(9)-2
-    // Ma=n_a x n_a
-    for(int i=1;i<=_N;++i){
-        Ma.VectorCrossDot(eigvec.IthCol(i),eigvec.IthCol(i));
-        // Eq.(19), first term on the right side
-        ProjPos+=Ma.CrossDot(Ma)*diag[i-1];
+    for(int sweep=0;sweep<MaxSweeps;++sweep){
+        off=a[0][1]*a[0][1]+a[0][2]*a[0][2]+a[1][2]*a[1][2];
+        if(off<=1.0e-30*scale) break;
+        for(p=0;p<_N-1;++p){
+            for(q=p+1;q<_N;++q){
+                apq=a[p][q];
+                if(apq==0.0) continue;
+                theta=(a[q][q]-a[p][p])/(2.0*apq);
+                if(abs(theta)>1.0e150){
+                    t=0.5/theta;
+                }
+                else{
+                    t=1.0/(abs(theta)+sqrt(theta*theta+1.0));
+                    if(theta<0.0) t=-t;
+                }
+                c=1.0/sqrt(t*t+1.0);
+                s=t*c;
+                // A'=J^T*A*J
+                a[p][p]-=t*apq;
+                a[q][q]+=t*apq;
+                a[p][q]=0.0;a[q][p]=0.0;
+                r=3-p-q;
+                arp=a[r][p];arq=a[r][q];
+                a[r][p]=c*arp-s*arq;a[p][r]=a[r][p];
+                a[r][q]=s*arp+c*arq;a[q][r]=a[r][q];
+                // V'=V*J
+                for(int i=0;i<_N;++i){
+                    vrp=v[i][p];vrq=v[i][q];
+                    v[i][p]=c*vrp-s*vrq;
+                    v[i][q]=s*vrp+c*vrq;
+                }
+            }
+        }
     }
 
-    // Now we calculate the Gab and Gba
-    // We need a new rank-2 tensor Mb(same defination as Ma)
-    double theta_ab;// defined in Eq.(21)-1
-    RankFourTensor Gab(0.0),Gba(0.0);
-    const double tol=1.0e-13;
-    for(int a=0;a<_N;++a){
-        for(int b=0;b<a;++b){
-            Ma.VectorCrossDot(eigvec.IthCol(a+1),eigvec.IthCol(a+1));// Eq.(12)
-            Mb.VectorCrossDot(eigvec.IthCol(b+1),eigvec.IthCol(b+1));// change the order of Eq.(12)
-
-            Gab=Ma.IkJlDot(Mb)+Ma.IlJkDot(Mb);
-            Gba=Mb.IkJlDot(Ma)+Mb.IlJkDot(Ma);
-            // since only positive term is involved
-            // e_a=0.5*(abs(lambda_a)+lambda_a)
-            // P is defined as: 2dE/dC in Eq.(8)-2
-            //  but 2dM/dC=(Gab+Gba)/(lambda_a-lambda_b)
-            // E(C)=sum(e_a*M_a)
-            // P=2dE(C)/dC=2(dE(C)/dM)*(dM/dC)
-            if(abs(eigval[a]-eigval[b])<=tol){
-                //if limit lambda_a to lambda_b in Eq.(24)
-                theta_ab=0.5*(diag[a]+diag[b])/2.0;
-            }
-            else{
-                // ea(lambda_a)=(1/2)*(lambda_a-1)
-                // m=2 for green strain case in Eq.(16)
-                theta_ab=0.5*(epos[a]-epos[b])/(eigval[a]-eigval[b]);// Eq.(21)-1
-            }
-            ProjPos+=theta_ab*(Gab+Gba);
+    // sort the eigen pairs in ascending order
+    int ind[3]={0,1,2},tmp;
+    for(int i=1;i<_N;++i){
+        for(int j=i;j>0&&a[ind[j]][ind[j]]<a[ind[j-1]][ind[j-1]];--j){
+            tmp=ind[j];ind[j]=ind[j-1];ind[j-1]=tmp;
         }
     }
-    return ProjPos;
+    for(int i=0;i<_N;++i){
+        eigval[i]=a[ind[i]][ind[i]];
+        eigvec(1,i+1)=v[0][ind[i]];
+        eigvec(2,i+1)=v[1][ind[i]];
+        eigvec(3,i+1)=v[2][ind[i]];
+    }
 }
-
-RankFourTensor RankTwoTensor::GetPostiveProjTensor() const{
-    double eigval[3];RankTwoTensor eigvec;
+//***********************************************
+void RankTwoTensor::CalcPosAndNegProjTensor(double (&eigval)[3],RankTwoTensor &eigvec,
+                                            RankFourTensor &ProjPos,RankFourTensor &ProjNeg) const{
     // Algorithm is taken from:
     // C. Miehe and M. Lambrecht, Commun. Numer. Meth. Engng 2001; 17:337~353
     // https://onlinelibrary.wiley.com/doi/epdf/10.1002/cnm.404
+    // the terms of Eq.(19) are accumulated component by component, so no
+    // Ma x Ma or Gab temporaries are needed, and ProjNeg=I4Sym-ProjPos
+    CalcSymmetricEigenValueAndEigenVectors(eigval,eigvec);
 
-    CalcEigenValueAndEigenVectors(eigval,eigvec);
-
-    // C=F^T F=lambda_i M_i where M_i=n_i x n_i
-    //         lambda_i-->eigenvalue  n_i--> the eigenvector
-
-    double epos[3],diag[3];
-    for(int i=0;i<_N;++i){
-        epos[i]=0.5*(abs(eigval[i])+eigval[i]);
-        diag[i]=0.0;
-        if(eigval[i]>0.0){
-            diag[i]=1.0;
+    double n[3][3],epos[3],diag[3];
+    for(int a=0;a<_N;++a){
+        epos[a]=0.5*(abs(eigval[a])+eigval[a]);
+        diag[a]=0.0;
+        if(eigval[a]>0.0){
+            diag[a]=1.0;
         }
+        n[a][0]=eigvec(1,a+1);
+        n[a][1]=eigvec(2,a+1);
+        n[a][2]=eigvec(3,a+1);
     }
-    RankFourTensor ProjPos(0.0);
-    RankTwoTensor Ma(0.0),Mb(0.0);
-
-    ProjPos.SetToZeros();
 
-    // calculate Ma defined in Eq.(9)-2
-    // Ma=n_a x n_a
-    for(int i=1;i<=_N;++i){
-        Ma.VectorCrossDot(eigvec.IthCol(i),eigvec.IthCol(i));
-        // Eq.(19), first term on the right side
-        ProjPos+=Ma.CrossDot(Ma)*diag[i-1];
-    }
-
-    // Now we calculate the Gab and Gba
-    // We need a new rank-2 tensor Mb(same defination as Ma)
-    double theta_ab;// defined in Eq.(21)-1
-    RankFourTensor Gab(0.0),Gba(0.0);
+    // theta_ab of Eq.(21), only a>b is required, the pairs are (1,0),(2,0),(2,1)
+    const int pa[3]={1,2,2},pb[3]={0,0,1};
+    double theta[3];
     const double tol=1.0e-13;
-    for(int a=0;a<_N;++a){
-        for(int b=0;b<a;++b){
-            Ma.VectorCrossDot(eigvec.IthCol(a+1),eigvec.IthCol(a+1));// Eq.(12)
-            Mb.VectorCrossDot(eigvec.IthCol(b+1),eigvec.IthCol(b+1));// change the order of Eq.(12)
+    for(int m=0;m<3;++m){
+        if(abs(eigval[pa[m]]-eigval[pb[m]])<=tol){
+            //if limit lambda_a to lambda_b in Eq.(24)
+            theta[m]=0.5*(diag[pa[m]]+diag[pb[m]])/2.0;
+        }
+        else{
+            theta[m]=0.5*(epos[pa[m]]-epos[pb[m]])/(eigval[pa[m]]-eigval[pb[m]]);
+        }
+    }
 
-            Gab=Ma.IkJlDot(Mb)+Ma.IlJkDot(Mb);
-            Gba=Mb.IkJlDot(Ma)+Mb.IlJkDot(Ma);
-            // since only positive term is involved
-            // e_a=0.5*(abs(lambda_a)+lambda_a)
-            // P is defined as: 2dE/dC in Eq.(8)-2
-            //  but 2dM/dC=(Gab+Gba)/(lambda_a-lambda_b)
-            // E(C)=sum(e_a*M_a)
-            // P=2dE(C)/dC=2(dE(C)/dM)*(dM/dC)
-            if(abs(eigval[a]-eigval[b])<=tol){
-                //if limit lambda_a to lambda_b in Eq.(24)
-                theta_ab=0.5*(diag[a]+diag[b])/2.0;
-            }
-            else{
-                // ea(lambda_a)=(1/2)*(lambda_a-1)
-                // m=2 for green strain case in Eq.(16)
-                theta_ab=0.5*(epos[a]-epos[b])/(eigval[a]-eigval[b]);// Eq.(21)-1
+    double val,*na,*nb;
+    for(int i=0;i<_N;++i){
+        for(int j=0;j<_N;++j){
+            for(int k=0;k<_N;++k){
+                for(int l=0;l<_N;++l){
+                    // Eq.(19), first term: sum_a diag_a*Ma x Ma
+                    val=0.0;
+                    for(int a=0;a<_N;++a){
+                        val+=diag[a]*n[a][i]*n[a][j]*n[a][k]*n[a][l];
+                    }
+                    // theta_ab*(Gab+Gba), Gab=Ma_ik*Mb_jl+Ma_il*Mb_jk
+                    for(int m=0;m<3;++m){
+                        na=n[pa[m]];nb=n[pb[m]];
+                        val+=theta[m]*(na[i]*na[k]*nb[j]*nb[l]+na[i]*na[l]*nb[j]*nb[k]
+                                      +nb[i]*nb[k]*na[j]*na[l]+nb[i]*nb[l]*na[j]*na[k]);
+                    }
+                    ProjPos(i+1,j+1,k+1,l+1)=val;
+                    ProjNeg(i+1,j+1,k+1,l+1)=0.5*((i==k)&&(j==l))+0.5*((i==l)&&(j==k))-val;
+                }
             }
-            ProjPos+=theta_ab*(Gab+Gba);
         }
     }
+}
+//***********************************************
+RankFourTensor RankTwoTensor::CalcPostiveProjTensor(double (&eigval)[3],RankTwoTensor &eigvec) const{
+    // remember, the eigen vec and eigen value should be used in your material
+    // code to calculate the stress and the related constitutive law
+    RankFourTensor ProjPos(0.0),ProjNeg(0.0);
+    CalcPosAndNegProjTensor(eigval,eigvec,ProjPos,ProjNeg);
     return ProjPos;
-}
\ No newline at end of file
+}
+
+RankFourTensor RankTwoTensor::GetPostiveProjTensor() const{
+    double eigval[3];RankTwoTensor eigvec;
+    return CalcPostiveProjTensor(eigval,eigvec);
+}
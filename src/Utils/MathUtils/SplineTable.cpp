@@ -0,0 +1,164 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Implement the 1d/2d spline tables
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "Utils/SplineTable.h"
+
+SplineTable1D::SplineTable1D(){
+    _n=0;
+    _xmin=0.0;_xmax=0.0;_h=0.0;_invh=0.0;
+    _coefs.clear();
+}
+//*******************************************************
+void SplineTable1D::Build(const int &n,const double &xmin,const double &xmax,const vector<double> &vals,
+                          const bool &IsClamped,const double &dleft,const double &dright){
+    _n=n;_xmin=xmin;_xmax=xmax;
+    _h=(xmax-xmin)/n;_invh=1.0/_h;
+
+    // solve the second derivatives(M) on the nodes by the Thomas algorithm,
+    // interior: M_{i-1}+4M_i+M_{i+1}=6(y_{i+1}-2y_i+y_{i-1})/h^2
+    vector<double> diag(n+1,4.0),rhs(n+1,0.0),M(n+1,0.0);
+    vector<double> lower(n+1,1.0),upper(n+1,1.0);
+    for(int i=1;i<n;i++){
+        rhs[i]=6.0*(vals[i+1]-2.0*vals[i]+vals[i-1])*_invh*_invh;
+    }
+    if(IsClamped){
+        diag[0]=2.0;upper[0]=1.0;
+        rhs[0]=6.0*_invh*((vals[1]-vals[0])*_invh-dleft);
+        diag[n]=2.0;lower[n]=1.0;
+        rhs[n]=6.0*_invh*(dright-(vals[n]-vals[n-1])*_invh);
+    }
+    else{
+        // natural spline, M_0=M_n=0
+        diag[0]=1.0;upper[0]=0.0;rhs[0]=0.0;
+        diag[n]=1.0;lower[n]=0.0;rhs[n]=0.0;
+    }
+    for(int i=1;i<=n;i++){
+        const double w=lower[i]/diag[i-1];
+        diag[i]-=w*upper[i-1];
+        rhs[i]-=w*rhs[i-1];
+    }
+    M[n]=rhs[n]/diag[n];
+    for(int i=n-1;i>=0;i--){
+        M[i]=(rhs[i]-upper[i]*M[i+1])/diag[i];
+    }
+
+    _coefs.resize(4*n);
+    for(int i=0;i<n;i++){
+        _coefs[4*i  ]=vals[i];
+        _coefs[4*i+1]=(vals[i+1]-vals[i])*_invh-_h*(2.0*M[i]+M[i+1])/6.0;
+        _coefs[4*i+2]=0.5*M[i];
+        _coefs[4*i+3]=(M[i+1]-M[i])*_invh/6.0;
+    }
+}
+//*******************************************************
+double SplineTable1D::GetNodeDerivative(const int &i)const{
+    if(i<_n) return _coefs[4*i+1];
+    const double *c=&_coefs[4*(_n-1)];
+    return c[1]+_h*(2.0*c[2]+3.0*_h*c[3]);
+}
+
+//*******************************************************
+//*** for the 2d table
+//*******************************************************
+SplineTable2D::SplineTable2D(){
+    _nx=0;_ny=0;
+    _xmin=0.0;_xmax=0.0;_ymin=0.0;_ymax=0.0;
+    _hx=0.0;_hy=0.0;_invhx=0.0;_invhy=0.0;
+    _coefs.clear();
+}
+//*******************************************************
+void SplineTable2D::Build(const int &nx,const int &ny,
+                          const double &xmin,const double &xmax,
+                          const double &ymin,const double &ymax,
+                          const vector<double> &vals,
+                          const vector<double> &dvdx,
+                          const vector<double> &dvdy,
+                          const vector<double> &d2vdxdy){
+    _nx=nx;_ny=ny;
+    _xmin=xmin;_xmax=xmax;_ymin=ymin;_ymax=ymax;
+    _hx=(xmax-xmin)/nx;_invhx=1.0/_hx;
+    _hy=(ymax-ymin)/ny;_invhy=1.0/_hy;
+
+    const int nnx=nx+1,nny=ny+1;
+    vector<double> fx(nnx*nny,0.0),fy(nnx*nny,0.0),fxy(nnx*nny,0.0);
+    vector<double> line;
+    SplineTable1D spline;
+
+    // df/dx along each row
+    if(static_cast<int>(dvdx.size())==nnx*nny){
+        fx=dvdx;
+    }
+    else{
+        line.resize(nnx);
+        for(int j=0;j<nny;j++){
+            for(int i=0;i<nnx;i++) line[i]=vals[i+j*nnx];
+            spline.Build(nx,xmin,xmax,line);
+            for(int i=0;i<nnx;i++) fx[i+j*nnx]=spline.GetNodeDerivative(i);
+        }
+    }
+    // df/dy and d2f/dxdy along each column
+    line.resize(nny);
+    if(static_cast<int>(dvdy.size())==nnx*nny){
+        fy=dvdy;
+    }
+    else{
+        for(int i=0;i<nnx;i++){
+            for(int j=0;j<nny;j++) line[j]=vals[i+j*nnx];
+            spline.Build(ny,ymin,ymax,line);
+            for(int j=0;j<nny;j++) fy[i+j*nnx]=spline.GetNodeDerivative(j);
+        }
+    }
+    if(static_cast<int>(d2vdxdy.size())==nnx*nny){
+        fxy=d2vdxdy;
+    }
+    else{
+        for(int i=0;i<nnx;i++){
+            for(int j=0;j<nny;j++) line[j]=fx[i+j*nnx];
+            spline.Build(ny,ymin,ymax,line);
+            for(int j=0;j<nny;j++) fxy[i+j*nnx]=spline.GetNodeDerivative(j);
+        }
+    }
+
+    // the bicubic hermite patch of each cell in the local coordinate(u,v)~[0,1],
+    // a=L*F*L^T, the derivatives are scaled by the cell size
+    const double L[4][4]={{ 1.0, 0.0, 0.0, 0.0},
+                          { 0.0, 0.0, 1.0, 0.0},
+                          {-3.0, 3.0,-2.0,-1.0},
+                          { 2.0,-2.0, 1.0, 1.0}};
+    double F[4][4],LF[4][4];
+    int k00,k10,k01,k11;
+    _coefs.resize(16*nx*ny);
+    for(int j=0;j<ny;j++){
+        for(int i=0;i<nx;i++){
+            k00=i+j*nnx;k10=k00+1;k01=k00+nnx;k11=k01+1;
+            F[0][0]=vals[k00];     F[0][1]=vals[k01];     F[0][2]=fy[k00]*_hy;      F[0][3]=fy[k01]*_hy;
+            F[1][0]=vals[k10];     F[1][1]=vals[k11];     F[1][2]=fy[k10]*_hy;      F[1][3]=fy[k11]*_hy;
+            F[2][0]=fx[k00]*_hx;   F[2][1]=fx[k01]*_hx;   F[2][2]=fxy[k00]*_hx*_hy; F[2][3]=fxy[k01]*_hx*_hy;
+            F[3][0]=fx[k10]*_hx;   F[3][1]=fx[k11]*_hx;   F[3][2]=fxy[k10]*_hx*_hy; F[3][3]=fxy[k11]*_hx*_hy;
+            for(int p=0;p<4;p++){
+                for(int q=0;q<4;q++){
+                    LF[p][q]=0.0;
+                    for(int r=0;r<4;r++) LF[p][q]+=L[p][r]*F[r][q];
+                }
+            }
+            double *a=&_coefs[16*(i+j*nx)];
+            for(int p=0;p<4;p++){
+                for(int q=0;q<4;q++){
+                    a[4*p+q]=0.0;
+                    for(int r=0;r<4;r++) a[4*p+q]+=LF[p][r]*L[q][r];
+                }
+            }
+        }
+    }
+}
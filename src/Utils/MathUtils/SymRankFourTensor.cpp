@@ -0,0 +1,143 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* A Simple Finite Element Method program (AsFem)
+//* All rights reserved, Yang Bai @ CopyRight 2021
+//* https://github.com/yangbai90/AsFem.git
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2021.04.18
+//+++ Purpose: Implement the rank-4 tensor with minor symmetry, i.e.
+//+++          C_ijkl=C_jikl=C_ijlk, it is stored as a 6x6 matrix
+//+++          in Mandel notation
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "Utils/SymRankFourTensor.h"
+
+SymRankFourTensor::SymRankFourTensor()
+:_N(6),_N2(6*6){
+    for(int i=0;i<_N2;++i) _vals[i]=0.0;
+}
+SymRankFourTensor::SymRankFourTensor(const double &val)
+:_N(6),_N2(6*6){
+    for(int i=0;i<_N2;++i) _vals[i]=val;
+}
+SymRankFourTensor::SymRankFourTensor(const SymRankFourTensor &a)
+:_N(6),_N2(6*6){
+    for(int i=0;i<_N2;++i) _vals[i]=a._vals[i];
+}
+SymRankFourTensor::SymRankFourTensor(const RankFourTensor &a)
+:_N(6),_N2(6*6){
+    SetFromRankFourTensor(a);
+}
+SymRankFourTensor& SymRankFourTensor::operator=(const RankFourTensor &a){
+    SetFromRankFourTensor(a);
+    return *this;
+}
+//****************************************
+//*** for the conversion between full and Mandel storage
+//****************************************
+void SymRankFourTensor::SetFromRankFourTensor(const RankFourTensor &a){
+    // the minor symmetric part of a is taken, i.e.
+    // D_IJ=w_I*w_J*(C_ijkl+C_jikl+C_ijlk+C_jilk)/4
+    const int ii[6]={1,2,3,2,1,1},jj[6]={1,2,3,3,3,2};
+    int i,j,k,l;
+    for(int I=1;I<=_N;++I){
+        i=ii[I-1];j=jj[I-1];
+        for(int J=1;J<=_N;++J){
+            k=ii[J-1];l=jj[J-1];
+            (*this)(I,J)=0.25*(a(i,j,k,l)+a(j,i,k,l)+a(i,j,l,k)+a(j,i,l,k))
+                        *MandelFactor(I)*MandelFactor(J);
+        }
+    }
+}
+RankFourTensor SymRankFourTensor::ToRankFourTensor() const{
+    RankFourTensor temp(0.0);
+    for(int i=1;i<=3;++i){
+        for(int j=1;j<=3;++j){
+            for(int k=1;k<=3;++k){
+                for(int l=1;l<=3;++l){
+                    temp(i,j,k,l)=(*this)(i,j,k,l);
+                }
+            }
+        }
+    }
+    return temp;
+}
+//****************************************
+//*** for fill-in method
+//****************************************
+void SymRankFourTensor::SetFromLameandG(const double &Lame,const double &G){
+    // C_ijkl = Lame*de_ij*de_kl + G*(de_ik*de_jl + de_il*de_jk)
+    // in Mandel notation: Lame*(1 x 1) + 2G*I6
+    SetToZeros();
+    for(int I=1;I<=3;++I){
+        for(int J=1;J<=3;++J){
+            (*this)(I,J)=Lame;
+        }
+    }
+    for(int I=1;I<=_N;++I) (*this)(I,I)+=2.0*G;
+}
+void SymRankFourTensor::SetFromEandNu(const double &E,const double &Nu){
+    double Lame=E*Nu/((1.0+Nu)*(1.0-2.0*Nu));
+    double G=E/(2.0*(1.0+Nu));
+    SetFromLameandG(Lame,G);
+}
+//**** for left hand scale value time rank-4 tensor
+SymRankFourTensor operator*(const double &lhs,const SymRankFourTensor &a){
+    SymRankFourTensor temp(0.0);
+    for(int i=0;i<a._N2;++i) temp._vals[i]=lhs*a._vals[i];
+    return temp;
+}
+SymRankFourTensor& SymRankFourTensor::AddScaledCrossDot(const double &s,const RankTwoTensor &a,const RankTwoTensor &b){
+    // D_IJ+=s*a_I*b_J, where a_I and b_J are the Mandel vectors of a and b
+    const double w=sqrt(2.0);
+    double ma[6],mb[6];
+    ma[0]=a(1,1);ma[1]=a(2,2);ma[2]=a(3,3);
+    ma[3]=0.5*w*(a(2,3)+a(3,2));
+    ma[4]=0.5*w*(a(1,3)+a(3,1));
+    ma[5]=0.5*w*(a(1,2)+a(2,1));
+    mb[0]=b(1,1);mb[1]=b(2,2);mb[2]=b(3,3);
+    mb[3]=0.5*w*(b(2,3)+b(3,2));
+    mb[4]=0.5*w*(b(1,3)+b(3,1));
+    mb[5]=0.5*w*(b(1,2)+b(2,1));
+    for(int I=0;I<_N;++I){
+        if(ma[I]==0.0) continue;
+        for(int J=0;J<_N;++J){
+            _vals[I*6+J]+=s*ma[I]*mb[J];
+        }
+    }
+    return *this;
+}
+//****************************************
+//*** for double dot operator
+//****************************************
+RankTwoTensor SymRankFourTensor::DoubleDot(const RankTwoTensor &a) const{
+    // sigma_I=D_IJ*eps_J, with eps_J=w_J*sym(a)_kl
+    const double w=sqrt(2.0);
+    double e[6],s[6];
+    e[0]=a(1,1);e[1]=a(2,2);e[2]=a(3,3);
+    e[3]=0.5*w*(a(2,3)+a(3,2));
+    e[4]=0.5*w*(a(1,3)+a(3,1));
+    e[5]=0.5*w*(a(1,2)+a(2,1));
+    for(int I=0;I<_N;++I){
+        s[I]=0.0;
+        for(int J=0;J<_N;++J){
+            s[I]+=_vals[I*6+J]*e[J];
+        }
+    }
+    return RankTwoTensor(s[0],s[1],s[2],s[3]/w,s[4]/w,s[5]/w);
+}
+SymRankFourTensor SymRankFourTensor::DoubleDot(const SymRankFourTensor &a) const{
+    SymRankFourTensor temp(0.0);
+    for(int I=0;I<_N;++I){
+        for(int J=0;J<_N;++J){
+            for(int K=0;K<_N;++K){
+                temp._vals[I*6+J]+=_vals[I*6+K]*a._vals[K*6+J];
+            }
+        }
+    }
+    return temp;
+}
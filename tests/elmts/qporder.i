@@ -0,0 +1,65 @@
+// this is a test input file for the per-block qpoint rule, the mechanics
+// block uses a higher order than the one of [qpoint]
+
+[mesh]
+  type=asfem
+  dim=2
+  nx=20
+  ny=20
+  meshtype=quad8
+[end]
+
+[dofs]
+name=ux uy
+[end]
+
+[qpoint]
+  type=gauss
+  order=2
+[end]
+
+[elmts]
+  [mechanics]
+    type=mechanics
+    dofs=ux uy
+    mate=elastic
+    qptype=gauss
+    qporder=3
+  [end]
+[end]
+
+[mates]
+  [elastic]
+    type=linearelastic
+    params=100.0 0.3
+  [end]
+[end]
+
+[bcs]
+  [fixux]
+    type=dirichlet
+    dof=ux
+    value=0.0
+    boundary=bottom
+  [end]
+  [fixuy]
+    type=dirichlet
+    dof=uy
+    value=0.0
+    boundary=bottom
+  [end]
+  [loaduy]
+    type=dirichlet
+    dof=uy
+    value=0.1
+    boundary=top
+  [end]
+[end]
+
+[projection]
+rank2mate=stress
+[end]
+
+[job]
+  type=static
+[end]
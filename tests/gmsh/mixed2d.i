@@ -0,0 +1,55 @@
+[mesh]
+  type=gmsh
+  file=mixed2d.msh
+[end]
+
+[dofs]
+name=phi
+[end]
+
+[qpoint]
+type=gauss
+order=2
+[end]
+
+[elmts]
+  [poisson]
+    type=poisson
+    dofs=phi
+    mate=mymate
+  [end]
+[end]
+
+[mates]
+  [mymate]
+    type=constpoisson
+    params=1.0 0.0
+  [end]
+[end]
+
+[bcs]
+  [fixleft]
+    type=dirichlet
+    dof=phi
+    value=0.0
+    boundary=left
+  [end]
+  [fixright]
+    type=dirichlet
+    dof=phi
+    value=1.0
+    boundary=right
+  [end]
+[end]
+
+[postprocess]
+  [area]
+    type=volume
+    domain=block
+  [end]
+[end]
+
+[job]
+type=static
+debug=dep
+[end]
@@ -0,0 +1,23 @@
+// material point test of j2 plasticity, usage: asfem-matdriver -i j2.i
+[mates]
+  [myplastic]
+    type=j2plasticity
+    params=210.0  0.3  0.5            1.2
+    //     E      nu   yield stress   hardening modulus
+  [end]
+[end]
+
+[matdriver]
+  mate=myplastic
+  dim=3
+  type=strain
+  target=0.01 -0.003 -0.003 0.0 0.0 0.002
+  //     11    22     33     23  13  12
+  steps=50
+  unload=true
+  repeats=1000000
+  batch=8
+  fdcheck=true
+  fdeps=1.0e-8
+  output=j2.csv
+[end]
@@ -0,0 +1,16 @@
+// material point test of neohookean material under the prescribed deformation gradient
+[mates]
+  [myneo]
+    type=neohookean
+    params=100.0 50.0
+  [end]
+[end]
+
+[matdriver]
+  type=deformgrad
+  target=1.2 0.1 0.0 0.0 0.9 0.0 0.0 0.0 1.0
+  //     F11 F12 F13 F21 F22 F23 F31 F32 F33
+  steps=20
+  repeats=1000000
+  output=neohookean.csv
+[end]
@@ -0,0 +1,65 @@
+*** This is an input file for the cross-element batched jacobian
+*** the result should be the same as elmtbatch=false
+
+[mesh]
+  type=asfem
+  dim=3
+  zmax=10.0
+  nx=5
+  ny=5
+  nz=50
+  meshtype=hex8
+[end]
+
+[dofs]
+name=ux uy uz
+[end]
+
+[elmts]
+  [mechanics]
+    type=mechanics
+    dofs=ux uy uz
+    mate=elastic
+    domain=alldomain
+  [end]
+[end]
+
+[mates]
+  [elastic]
+    type=linearelastic
+    params=210.0 0.3
+  [end]
+[end]
+
+[bcs]
+  [FixUx]
+    type=dirichlet
+    dof=ux
+    boundary=left
+    value=0.0
+  [end]
+  [FixUy]
+    type=dirichlet
+    dof=uy
+    boundary=bottom
+    value=0.0
+  [end]
+  [FixUz]
+    type=dirichlet
+    dof=uz
+    boundary=back
+    value=0.0
+  [end]
+  [loadUz]
+    type=dirichlet
+    dof=uz
+    value=0.1
+    boundary=front
+  [end]
+[end]
+
+[job]
+  type=static
+  debug=dep
+  elmtbatch=true
+[end]
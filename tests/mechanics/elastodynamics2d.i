@@ -0,0 +1,75 @@
+*** This is an input file for the elastodynamics(generalized-alpha) of the neohookean model
+
+[mesh]
+  type=asfem
+  dim=2
+  xmax=10
+  ymax=1
+  nx=100
+  ny=10
+  meshtype=quad4
+[end]
+
+[dofs]
+name=ux uy
+[end]
+
+[projection]
+scalarmate=vonMises
+rank2mate=stress strain
+[end]
+
+[elmts]
+  [mechanics]
+    type=mechanics
+    dofs=ux uy
+    mate=neohookean
+    domain=alldomain
+    density=1.0
+  [end]
+[end]
+
+[mates]
+  [neohookean]
+    type=neohookean
+    params=100.0 0.3
+  [end]
+[end]
+
+
+
+[bcs]
+  [FixUx]
+    type=dirichlet
+    dof=ux
+    boundary=left
+    value=0.0
+  [end]
+  [FixUy]
+    type=dirichlet
+    dof=uy
+    boundary=left
+    value=0.0
+  [end]
+  [loadUy]
+    type=neumann
+    dof=uy
+    value=-0.1
+    boundary=right
+  [end]
+[end]
+
+[timestepping]
+  type=alpha2
+  dt=1.0e-2
+  endtime=1.0
+  adaptive=false
+  optiters=3
+  dtmax=1.0e-1
+  rhoinf=0.5
+[end]
+
+[job]
+  type=transient
+  debug=dep
+[end]
@@ -0,0 +1,74 @@
+*** This is an input file for the compressive neohookean model
+*** the static load stepping replaces the transient analysis
+
+[mesh]
+  type=asfem
+  dim=2
+  xmax=5
+  ymax=5
+  nx=50
+  ny=50
+  meshtype=quad4
+[end]
+
+[dofs]
+name=ux uy
+[end]
+
+[projection]
+scalarmate=vonMises
+rank2mate=stress strain
+[end]
+
+[elmts]
+  [mechanics]
+    type=mechanics
+    dofs=ux uy
+    mate=neohookean
+    domain=alldomain
+  [end]
+[end]
+
+[mates]
+  [neohookean]
+    type=neohookean
+    params=100.0 0.3
+  [end]
+[end]
+
+
+
+[bcs]
+  [FixUx]
+    type=dirichlet
+    dof=ux
+    boundary=bottom
+    value=0.0
+  [end]
+  [FixUy]
+    type=dirichlet
+    dof=uy
+    boundary=bottom top
+    value=0.0
+  [end]
+  [loadUx]
+    type=dirichlet
+    dof=ux
+    value=1.0
+    boundary=top
+  [end]
+[end]
+
+[nonlinearsolver]
+  type=nr
+  maxiters=25
+  r_rel_tol=1.0e-10
+  r_abs_tol=1.0e-8
+[end]
+
+[job]
+  type=static
+  debug=true
+  loadsteps=10
+  maxcutbacks=5
+[end]
@@ -0,0 +1,69 @@
+// this is a test input file for mesh generation test
+
+[mesh]
+  type=asfem
+  dim=2
+  nx=50
+  ny=50
+  meshtype=quad9
+[end]
+
+[dofs]
+name=c T
+[end]
+
+[qpoint]
+  // for quad9 mesh, the order must>=4 !!!
+  type=gauss
+  order=4
+[end]
+
+[elmts]
+  [elmt1]
+    type=diffusion
+    dofs=c
+    mate=mate1
+  [end]
+  [elmt2]
+    type=diffusion
+    dofs=T
+    mate=mate2
+  [end]
+[end]
+
+[mates]
+  [mate1]
+    type=constdiffusion
+    params=1.0
+  [end]
+  [mate2]
+    type=constdiffusion
+    params=0.01
+  [end]
+[end]
+
+[timestepping]
+  type=be
+  dt=1.0e-5
+  time=8.0e-5
+  slowdofs=T
+  subcycles=4
+[end]
+
+[ics]
+  [randc]
+    type=random
+    dof=c
+    params=1.0 2.0
+  [end]
+  [randT]
+    type=random
+    dof=T
+    params=1.0 2.0
+  [end]
+[end]
+
+[job]
+  type=transient
+  debug=dep
+[end]
@@ -0,0 +1,48 @@
+// nonlinear diffusion with the user1 element, its jacobian
+// is derived from the residual by the automatic differentiation
+
+[mesh]
+  type=asfem
+  dim=2
+  nx=50
+  ny=50
+  meshtype=quad4
+[end]
+
+[dofs]
+name=c
+[end]
+
+[elmts]
+  [elmt1]
+    type=user1
+    dofs=c
+    mate=mate1
+  [end]
+[end]
+
+[mates]
+  [mate1]
+    type=constdiffusion
+    params=1.0
+  [end]
+[end]
+
+[timestepping]
+  type=be
+  dt=1.0e-5
+  time=2.0e-4
+[end]
+
+[ics]
+  [randc]
+    type=random
+    dof=c
+    params=0.0 1.0
+  [end]
+[end]
+
+[job]
+  type=transient
+  debug=dep
+[end]
@@ -0,0 +1,72 @@
+*** This is an input file for the user1 material, its jacobian
+*** is derived from the stress by the automatic differentiation
+
+[mesh]
+  type=asfem
+  dim=2
+  xmax=2
+  ymax=2
+  nx=40
+  ny=40
+  meshtype=quad4
+[end]
+
+[dofs]
+name=ux uy
+[end]
+
+[projection]
+scalarmate=vonMises
+rank2mate=stress strain
+[end]
+
+[elmts]
+  [mechanics]
+    type=mechanics
+    dofs=ux uy
+    mate=myumat
+    domain=alldomain
+  [end]
+[end]
+
+[mates]
+  [myumat]
+    type=user1
+    params=100.0 0.3 500.0
+  [end]
+[end]
+
+[bcs]
+  [FixUx]
+    type=dirichlet
+    dof=ux
+    boundary=bottom
+    value=0.0
+  [end]
+  [FixUy]
+    type=dirichlet
+    dof=uy
+    boundary=bottom
+    value=0.0
+  [end]
+  [loadUx]
+    type=dirichlet
+    dof=ux
+    value=1.0*t
+    boundary=top
+  [end]
+[end]
+
+[timestepping]
+  type=be
+  dt=1.0e-3
+  endtime=5.0e-2
+  adaptive=true
+  optiters=3
+  dtmax=1.0e-2
+[end]
+
+[job]
+  type=transient
+  debug=dep
+[end]